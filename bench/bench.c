@@ -0,0 +1,72 @@
+/**
+ * @file bench.c
+ * @brief Helpers shared by the kernel and port benchmarks
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "bench.h"
+
+static uint64_t ullTimespecNs(const struct timespec *ts)
+{
+	return (uint64_t)ts->tv_sec * 1000000000ULL + (uint64_t)ts->tv_nsec;
+}
+
+uint64_t ullBenchWallNs(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ullTimespecNs(&ts);
+}
+
+uint64_t ullBenchCpuNs(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &ts);
+
+	return ullTimespecNs(&ts);
+}
+
+void vBenchReport(const char *name, double value, const char *unit)
+{
+	static int header_printed = 0;
+	const char *format = getenv("BENCH_FORMAT");
+
+	/* One JSON object per line for tools that track the results */
+	if (format && !strcmp(format, "json")) {
+		printf("{\"bench\": \"%s\", \"name\": \"%s\", "
+		       "\"value\": %.3f, \"unit\": \"%s\"}\n",
+		       BENCH_VARIANT, name, value, unit);
+		fflush(stdout);
+		return;
+	}
+
+	if (!header_printed) {
+		printf("%s\n", BENCH_VARIANT);
+		header_printed = 1;
+	}
+
+	printf("%-32s %14.1f %s\n", name, value, unit);
+	fflush(stdout);
+}
+
+void vBenchFinish(void)
+{
+	fflush(stdout);
+	exit(EXIT_SUCCESS);
+}
+
+/* Hooks required by include/FreeRTOSConfig.h */
+void vMainQueueSendPassed(void)
+{
+}
+
+void vApplicationIdleHook(void)
+{
+}
@@ -0,0 +1,47 @@
+/**
+ * @file bench.h
+ * @brief Helpers shared by the kernel and port benchmarks
+ *
+ * Every benchmark is its own executable that creates a controlling task,
+ * starts the scheduler, reports its results and then exits the process.
+ */
+
+#ifndef __BENCH_H__
+#define __BENCH_H__
+
+#include <stdint.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#define benchCONTROL_PRIORITY (configMAX_PRIORITIES - 1)
+#define benchSTACK_SIZE ((unsigned short)2560)
+
+/**
+ * @brief Host monotonic clock in nanoseconds
+ */
+uint64_t ullBenchWallNs(void);
+
+/**
+ * @brief CPU time consumed by the whole emulator process in nanoseconds
+ */
+uint64_t ullBenchCpuNs(void);
+
+/**
+ * @brief Prints one benchmark result line
+ *
+ * Setting the environment variable BENCH_FORMAT=json prints every result as
+ * a JSON object on its own line instead.
+ *
+ * @param name Benchmark name, e.g. "yield_pingpong"
+ * @param value Measured value
+ * @param unit Unit of value, e.g. "ns/switch"
+ */
+void vBenchReport(const char *name, double value, const char *unit);
+
+/**
+ * @brief Prints the results footer and terminates the emulator process
+ */
+void vBenchFinish(void);
+
+#endif
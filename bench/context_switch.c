@@ -0,0 +1,105 @@
+/**
+ * @file context_switch.c
+ * @brief Task switch latency and host CPU use of the Posix port
+ *
+ * Built once per switch mechanism (FreeRTOS_Bench_Switch_Signal,
+ * FreeRTOS_Bench_Switch_Condvar and FreeRTOS_Bench_Switch_Fiber) so that they
+ * can be compared directly.
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "task.h"
+
+#include "bench.h"
+
+#define SWITCH_ITERATIONS 20000
+#define WORKER_PRIORITY (tskIDLE_PRIORITY + 1)
+
+static TaskHandle_t ControlTask = NULL;
+static SemaphoreHandle_t PingSemaphore = NULL;
+static SemaphoreHandle_t PongSemaphore = NULL;
+
+static void vYieldWorker(void *pvParameters)
+{
+	for (unsigned int i = 0; i < SWITCH_ITERATIONS; i++)
+		taskYIELD();
+
+	xTaskNotifyGive(ControlTask);
+	vTaskSuspend(NULL);
+}
+
+static void vPingWorker(void *pvParameters)
+{
+	for (unsigned int i = 0; i < SWITCH_ITERATIONS; i++) {
+		xSemaphoreGive(PingSemaphore);
+		xSemaphoreTake(PongSemaphore, portMAX_DELAY);
+	}
+
+	xTaskNotifyGive(ControlTask);
+	vTaskSuspend(NULL);
+}
+
+static void vPongWorker(void *pvParameters)
+{
+	for (unsigned int i = 0; i < SWITCH_ITERATIONS; i++) {
+		xSemaphoreTake(PingSemaphore, portMAX_DELAY);
+		xSemaphoreGive(PongSemaphore);
+	}
+
+	xTaskNotifyGive(ControlTask);
+	vTaskSuspend(NULL);
+}
+
+/*
+ * Runs two workers to completion and reports the cost per switch as well as
+ * how much host CPU the process burnt while doing so.
+ */
+static void vMeasurePair(const char *name, TaskFunction_t first,
+			 TaskFunction_t second, unsigned long switches)
+{
+	uint64_t wall = ullBenchWallNs();
+	uint64_t cpu = ullBenchCpuNs();
+	char metric[64];
+
+	xTaskCreate(first, "Worker1", benchSTACK_SIZE, NULL, WORKER_PRIORITY,
+		    NULL);
+	xTaskCreate(second, "Worker2", benchSTACK_SIZE, NULL, WORKER_PRIORITY,
+		    NULL);
+
+	ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+	ulTaskNotifyTake(pdFALSE, portMAX_DELAY);
+
+	wall = ullBenchWallNs() - wall;
+	cpu = ullBenchCpuNs() - cpu;
+
+	snprintf(metric, sizeof(metric), "%s_latency", name);
+	vBenchReport(metric, (double)wall / switches, "ns/switch");
+	snprintf(metric, sizeof(metric), "%s_host_cpu", name);
+	vBenchReport(metric, 100.0 * cpu / wall, "%cpu");
+}
+
+static void vControlTask(void *pvParameters)
+{
+	vMeasurePair("yield_pingpong", vYieldWorker, vYieldWorker,
+		     2UL * SWITCH_ITERATIONS);
+	vMeasurePair("semaphore_pingpong", vPingWorker, vPongWorker,
+		     2UL * SWITCH_ITERATIONS);
+
+	vBenchFinish();
+}
+
+int main(int argc, char *argv[])
+{
+	PingSemaphore = xSemaphoreCreateBinary();
+	PongSemaphore = xSemaphoreCreateBinary();
+
+	xTaskCreate(vControlTask, "Control", benchSTACK_SIZE, NULL,
+		    benchCONTROL_PRIORITY, &ControlTask);
+
+	vTaskStartScheduler();
+
+	return 0;
+}
@@ -0,0 +1,176 @@
+/**
+ * @file critical_stress.c
+ * @brief Critical sections entered from many tasks while ticks and interrupts fire
+ *
+ * Tasks of the same priority, time sliced by a 10 kHz tick, update a pair of
+ * shared counters inside critical sections, some of them nested and some
+ * masked with the FromISR calls. A host thread raises an interrupt line whose
+ * handler checks the pair. Any preemption inside a critical section shows up
+ * as a torn pair. The benchmark also times the enter/exit pair on its own and
+ * the queue calls that are built on it.
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "bench.h"
+
+#define CRITICAL_TASKS 8
+#define CRITICAL_SECONDS 2
+#define CRITICAL_PAIRS 1000000
+#define CRITICAL_QUEUE_OPS 200000
+#define CRITICAL_IRQ 0
+#define CRITICAL_IRQ_PERIOD_NS 100000
+#define WORKER_PRIORITY (tskIDLE_PRIORITY + 1)
+
+static struct {
+	volatile unsigned long first;
+	volatile unsigned long second;
+} Shared;
+
+static volatile unsigned long Sections[CRITICAL_TASKS];
+static volatile unsigned long TornTasks, TornIsr, IsrChecks;
+static volatile int Stop;
+
+static void vUpdateShared(void)
+{
+	if (Shared.first != Shared.second)
+		TornTasks++;
+	Shared.first++;
+	/* Leave the pair inconsistent for a while */
+	for (volatile int i = 0; i < 16; i++)
+		;
+	Shared.second++;
+}
+
+static void vWorker(void *pvParameters)
+{
+	unsigned int index = (unsigned int)(uintptr_t)pvParameters;
+	UBaseType_t mask;
+
+	for (unsigned long i = 0;; i++) {
+		switch (i % 4) {
+		case 0:
+		case 1:
+			taskENTER_CRITICAL();
+			vUpdateShared();
+			taskEXIT_CRITICAL();
+			break;
+		case 2:
+			taskENTER_CRITICAL();
+			taskENTER_CRITICAL();
+			vUpdateShared();
+			taskEXIT_CRITICAL();
+			vUpdateShared();
+			taskEXIT_CRITICAL();
+			break;
+		case 3:
+			mask = taskENTER_CRITICAL_FROM_ISR();
+			vUpdateShared();
+			taskEXIT_CRITICAL_FROM_ISR(mask);
+			break;
+		}
+		Sections[index]++;
+	}
+}
+
+static void vIrqCheckShared(void *pvParameter)
+{
+	UBaseType_t mask = taskENTER_CRITICAL_FROM_ISR();
+
+	if (Shared.first != Shared.second)
+		TornIsr++;
+	IsrChecks++;
+	taskEXIT_CRITICAL_FROM_ISR(mask);
+}
+
+static void *pvDevice(void *arg)
+{
+	struct timespec period = { 0, CRITICAL_IRQ_PERIOD_NS };
+	sigset_t all;
+
+	sigfillset(&all);
+	pthread_sigmask(SIG_BLOCK, &all, NULL);
+
+	while (!Stop) {
+		vPortRaiseIrq(CRITICAL_IRQ);
+		nanosleep(&period, NULL);
+	}
+
+	return NULL;
+}
+
+static void vControlTask(void *pvParameters)
+{
+	xPortIrqStats stats;
+	QueueHandle_t queue = xQueueCreate(1, sizeof(uint32_t));
+	uint32_t message = 0;
+	unsigned long total = 0;
+	TickType_t ticks;
+	pthread_t device;
+	uint64_t ns;
+
+	/* The enter/exit pair on its own, nothing else runs */
+	ns = ullBenchWallNs();
+	for (unsigned int i = 0; i < CRITICAL_PAIRS; i++) {
+		taskENTER_CRITICAL();
+		taskEXIT_CRITICAL();
+	}
+	ns = ullBenchWallNs() - ns;
+	vBenchReport("enter_exit", (double)ns / CRITICAL_PAIRS, "ns");
+
+	ns = ullBenchWallNs();
+	for (unsigned int i = 0; i < CRITICAL_QUEUE_OPS; i++) {
+		xQueueSend(queue, &message, 0);
+		xQueueReceive(queue, &message, 0);
+	}
+	ns = ullBenchWallNs() - ns;
+	vBenchReport("queue_send_receive", (double)ns / CRITICAL_QUEUE_OPS,
+		     "ns");
+
+	/* Now contended, with ticks and interrupts */
+	xPortInstallIrqHandler(CRITICAL_IRQ, configMAX_SYSCALL_INTERRUPT_PRIORITY,
+			       vIrqCheckShared, NULL);
+	pthread_create(&device, NULL, pvDevice, NULL);
+	for (unsigned int i = 0; i < CRITICAL_TASKS; i++)
+		xTaskCreate(vWorker, "Worker", benchSTACK_SIZE,
+			    (void *)(uintptr_t)i, WORKER_PRIORITY, NULL);
+
+	ticks = xTaskGetTickCount();
+	vTaskDelay(pdMS_TO_TICKS(CRITICAL_SECONDS * 1000));
+	ticks = xTaskGetTickCount() - ticks;
+	Stop = 1;
+
+	for (unsigned int i = 0; i < CRITICAL_TASKS; i++)
+		total += Sections[i];
+	vPortGetIrqStats(CRITICAL_IRQ, &stats);
+
+	vBenchReport("contended_sections", (double)total / CRITICAL_SECONDS,
+		     "sections/s");
+	vBenchReport("ticks", (double)ticks / CRITICAL_SECONDS, "ticks/s");
+	vBenchReport("irq_checks", (double)IsrChecks / CRITICAL_SECONDS,
+		     "checks/s");
+	vBenchReport("irq_deferred", stats.ulDeferred, "times");
+	vBenchReport("torn_in_tasks", TornTasks, "pairs");
+	vBenchReport("torn_in_irq", TornIsr, "pairs");
+
+	pthread_join(device, NULL);
+	vBenchFinish();
+}
+
+int main(int argc, char *argv[])
+{
+	xTaskCreate(vControlTask, "Control", benchSTACK_SIZE, NULL,
+		    benchCONTROL_PRIORITY, NULL);
+
+	vTaskStartScheduler();
+
+	return 0;
+}
@@ -0,0 +1,246 @@
+/**
+ * @file draw_alloc.c
+ * @brief Allocations and time per frame of draw jobs with malloc() and with
+ * memory pools
+ *
+ * A task builds frames of draw jobs the way the tumDraw functions do, a clear,
+ * 40 shapes and 8 strings, and sends them through a queue of 100 jobs to a
+ * task that drains it in batches of 16, as vDrawUpdateScreen() does, and frees
+ * every job it has drawn. The job data and the string copies are allocated
+ * once with calloc() and malloc() and once from pools made with xPoolCreate(),
+ * which fall back to malloc() when they are empty. Every job and string is
+ * checked before it is freed, and the pools must be full again at the end.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "pool.h"
+#include "queue.h"
+#include "semphr.h"
+#include "task.h"
+
+#include "bench.h"
+
+#define ALLOC_FRAMES 20000
+#define ALLOC_SHAPES 40
+#define ALLOC_TEXTS 8
+#define ALLOC_JOBS (1 + ALLOC_SHAPES + ALLOC_TEXTS)
+#define ALLOC_QUEUE_LENGTH 100
+#define ALLOC_BATCH 16
+#define ALLOC_BLOCKS (ALLOC_QUEUE_LENGTH + ALLOC_BATCH)
+#define ALLOC_TEXT_BLOCK 64
+#define ALLOC_DRAW_PRIORITY (benchCONTROL_PRIORITY - 1)
+
+enum job_type { JOB_CLEAR, JOB_RECT, JOB_TEXT, JOB_FRAME_END };
+
+/* Laid out like union data_u in TUM_Draw.c */
+union job_data {
+	struct {
+		unsigned int colour;
+	} clear;
+	struct {
+		unsigned short x;
+		unsigned short y;
+		unsigned short w;
+		unsigned short h;
+		unsigned int colour;
+	} rect;
+	struct {
+		char *str;
+		unsigned short x;
+		unsigned short y;
+		unsigned int colour;
+	} text;
+};
+
+struct job {
+	enum job_type type;
+	union job_data *data;
+};
+
+static QueueHandle_t Jobs;
+static SemaphoreHandle_t FrameDrawn;
+static PoolHandle_t JobPool;
+static PoolHandle_t TextPool;
+static int UsePools;
+static unsigned long Mallocs;
+static unsigned long Errors;
+
+static void *pvAlloc(PoolHandle_t pool, size_t size)
+{
+	void *block = UsePools ? pvPoolAlloc(pool) : NULL;
+
+	if (block)
+		return block;
+	Mallocs++;
+	return malloc(size);
+}
+
+static void vFree(PoolHandle_t pool, void *block)
+{
+	if (UsePools && xPoolContains(pool, block))
+		vPoolFree(pool, block);
+	else
+		free(block);
+}
+
+static void vSend(enum job_type type, union job_data *data)
+{
+	struct job job = { .type = type, .data = data };
+
+	xQueueSend(Jobs, &job, portMAX_DELAY);
+}
+
+static union job_data *pxCreateJob(void)
+{
+	union job_data *data = pvAlloc(JobPool, sizeof(*data));
+
+	if (data)
+		memset(data, 0, sizeof(*data));
+	else
+		Errors++;
+	return data;
+}
+
+static void vBuildFrame(unsigned int frame)
+{
+	union job_data *data;
+	char text[32];
+	size_t size;
+
+	data = pxCreateJob();
+	data->clear.colour = frame;
+	vSend(JOB_CLEAR, data);
+
+	for (unsigned int i = 0; i < ALLOC_SHAPES; i++) {
+		data = pxCreateJob();
+		data->rect.x = i;
+		data->rect.w = 10;
+		data->rect.colour = frame + i;
+		vSend(JOB_RECT, data);
+	}
+
+	for (unsigned int i = 0; i < ALLOC_TEXTS; i++) {
+		snprintf(text, sizeof(text), "Score: %u", frame + i);
+		size = strlen(text) + 1;
+
+		data = pxCreateJob();
+		data->text.str = size <= ALLOC_TEXT_BLOCK ?
+					 pvAlloc(TextPool, size) :
+					 malloc(size);
+		strcpy(data->text.str, text);
+		data->text.colour = frame + i;
+		vSend(JOB_TEXT, data);
+	}
+
+	vSend(JOB_FRAME_END, NULL);
+}
+
+static void vDrawJob(struct job *job, unsigned int *shape)
+{
+	char text[32];
+
+	switch (job->type) {
+	case JOB_CLEAR:
+		*shape = 0;
+		break;
+	case JOB_RECT:
+		if (job->data->rect.x != *shape || job->data->rect.w != 10)
+			Errors++;
+		(*shape)++;
+		break;
+	case JOB_TEXT:
+		snprintf(text, sizeof(text), "Score: %u",
+			 job->data->text.colour);
+		if (strcmp(text, job->data->text.str))
+			Errors++;
+		vFree(TextPool, job->data->text.str);
+		break;
+	case JOB_FRAME_END:
+		if (*shape != ALLOC_SHAPES)
+			Errors++;
+		xSemaphoreGive(FrameDrawn);
+		return;
+	}
+	vFree(JobPool, job->data);
+}
+
+static void vDrawTask(void *pvParameters)
+{
+	struct job jobs[ALLOC_BATCH];
+	unsigned int shape = 0;
+	size_t count;
+
+	for (;;) {
+		/* Block for the first job, then take whatever is queued */
+		xQueuePeek(Jobs, &jobs[0], portMAX_DELAY);
+		while ((count = xQueueReceiveMultiple(Jobs, jobs, ALLOC_BATCH,
+						      0)))
+			for (size_t i = 0; i < count; i++)
+				vDrawJob(&jobs[i], &shape);
+	}
+}
+
+static void vMeasure(const char *name)
+{
+	uint64_t start, elapsed;
+	char metric[64];
+
+	Mallocs = 0;
+	start = ullBenchWallNs();
+	for (unsigned int frame = 0; frame < ALLOC_FRAMES; frame++) {
+		vBuildFrame(frame);
+		xSemaphoreTake(FrameDrawn, portMAX_DELAY);
+	}
+	elapsed = ullBenchWallNs() - start;
+
+	snprintf(metric, sizeof(metric), "%s_frame", name);
+	vBenchReport(metric, (double)elapsed / ALLOC_FRAMES, "ns/frame");
+	snprintf(metric, sizeof(metric), "%s_job", name);
+	vBenchReport(metric, (double)elapsed / (ALLOC_FRAMES * ALLOC_JOBS),
+		     "ns/job");
+	snprintf(metric, sizeof(metric), "%s_mallocs", name);
+	vBenchReport(metric, (double)Mallocs / ALLOC_FRAMES, "per frame");
+}
+
+static void vControlTask(void *pvParameters)
+{
+	Jobs = xQueueCreate(ALLOC_QUEUE_LENGTH, sizeof(struct job));
+	FrameDrawn = xSemaphoreCreateBinary();
+	JobPool = xPoolCreate(sizeof(union job_data), ALLOC_BLOCKS);
+	TextPool = xPoolCreate(ALLOC_TEXT_BLOCK, ALLOC_BLOCKS);
+	if (!Jobs || !FrameDrawn || !JobPool || !TextPool) {
+		printf("Could not create the queue, semaphore or pools\n");
+		vBenchFinish();
+	}
+
+	xTaskCreate(vDrawTask, "Draw", benchSTACK_SIZE, NULL,
+		    ALLOC_DRAW_PRIORITY, NULL);
+
+	UsePools = 0;
+	vMeasure("malloc");
+	UsePools = 1;
+	vMeasure("pool");
+
+	vBenchReport("pool_min_free_jobs",
+		     uxPoolGetMinimumEverFreeBlocks(JobPool), "blocks");
+	if (uxPoolGetFreeBlocks(JobPool) != ALLOC_BLOCKS ||
+	    uxPoolGetFreeBlocks(TextPool) != ALLOC_BLOCKS)
+		Errors++;
+
+	vBenchReport("errors", Errors, "lost or corrupted jobs");
+	vBenchFinish();
+}
+
+int main(int argc, char *argv[])
+{
+	xTaskCreate(vControlTask, "Control", benchSTACK_SIZE, NULL,
+		    benchCONTROL_PRIORITY, NULL);
+
+	vTaskStartScheduler();
+
+	return 0;
+}
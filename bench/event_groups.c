@@ -0,0 +1,211 @@
+/**
+ * @file event_groups.c
+ * @brief Latency of waiting for all or any of several events
+ *
+ * A task waits for three events signalled by a lower priority task or, for
+ * the last of them, by a simulated interrupt. It waits once the way it had to
+ * before event groups, with a binary semaphore per event, taking them one
+ * after the other to wait for all of them and polling them with a block time
+ * of 0 and a tick's delay in between to wait for any of them, and once with
+ * xEventGroupWaitBits(). The interrupt sets its bit with
+ * xEventGroupSetBitsFromISR(), which defers the set to the timer daemon.
+ * Latency runs from the call that signals the last event needed until the
+ * waiting task runs, a round from the first event signalled until the
+ * signalling task runs again. Every wake up is checked against the events
+ * signalled.
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+#include "event_groups.h"
+
+#include "bench.h"
+
+#define EG_EVENTS 3
+#define EG_ALL_BITS ((1 << EG_EVENTS) - 1)
+#define EG_ROUNDS 20000
+#define EG_POLL_ROUNDS 2000
+#define EG_IRQ 0
+#define SIGNAL_PRIORITY (tskIDLE_PRIORITY + 1)
+#define WAIT_PRIORITY (tskIDLE_PRIORITY + 2)
+
+struct variant {
+	const char *name;
+	TaskFunction_t waiter;
+	BaseType_t grouped;
+	BaseType_t all;
+	BaseType_t irq;
+	unsigned long rounds;
+};
+
+static TaskHandle_t Control;
+static SemaphoreHandle_t Events[EG_EVENTS];
+static EventGroupHandle_t Group;
+static BaseType_t Grouped;
+static EventBits_t Expected;
+static uint64_t Start, Latency, LatencyMax;
+static unsigned long Errors;
+
+static void vWoken(EventBits_t bits)
+{
+	uint64_t ns = ullBenchWallNs() - Start;
+
+	Latency += ns;
+	if (ns > LatencyMax)
+		LatencyMax = ns;
+	if (bits != Expected)
+		Errors++;
+	xTaskNotifyGive(Control);
+}
+
+static void vAllSemaphores(void *pvParameters)
+{
+	for (;;) {
+		for (unsigned int i = 0; i < EG_EVENTS; i++)
+			xSemaphoreTake(Events[i], portMAX_DELAY);
+		vWoken(EG_ALL_BITS);
+	}
+}
+
+static void vAnyPolling(void *pvParameters)
+{
+	EventBits_t bits;
+
+	for (;;) {
+		bits = 0;
+		for (unsigned int i = 0; i < EG_EVENTS; i++)
+			if (xSemaphoreTake(Events[i], 0) == pdTRUE)
+				bits |= 1 << i;
+		if (bits)
+			vWoken(bits);
+		else
+			vTaskDelay(1);
+	}
+}
+
+static void vAllGroup(void *pvParameters)
+{
+	for (;;)
+		vWoken(xEventGroupWaitBits(Group, EG_ALL_BITS, pdTRUE, pdTRUE,
+					   portMAX_DELAY));
+}
+
+static void vAnyGroup(void *pvParameters)
+{
+	for (;;)
+		vWoken(xEventGroupWaitBits(Group, EG_ALL_BITS, pdTRUE, pdFALSE,
+					   portMAX_DELAY));
+}
+
+static void vSignal(unsigned int event)
+{
+	if (Grouped)
+		xEventGroupSetBits(Group, 1 << event);
+	else
+		xSemaphoreGive(Events[event]);
+}
+
+static void vIrqHandler(void *pvParameter)
+{
+	BaseType_t woken = pdFALSE;
+
+	if (Grouped)
+		xEventGroupSetBitsFromISR(Group, 1 << (EG_EVENTS - 1), &woken);
+	else
+		xSemaphoreGiveFromISR(Events[EG_EVENTS - 1], &woken);
+	portEND_SWITCHING_ISR(woken);
+}
+
+static const struct variant Variants[] = {
+	{ "all_semaphores", vAllSemaphores, pdFALSE, pdTRUE, pdFALSE,
+	  EG_ROUNDS },
+	{ "all_event_group", vAllGroup, pdTRUE, pdTRUE, pdFALSE, EG_ROUNDS },
+	{ "any_polling", vAnyPolling, pdFALSE, pdFALSE, pdFALSE,
+	  EG_POLL_ROUNDS },
+	{ "any_event_group", vAnyGroup, pdTRUE, pdFALSE, pdFALSE, EG_ROUNDS },
+	{ "isr_all_semaphores", vAllSemaphores, pdFALSE, pdTRUE, pdTRUE,
+	  EG_ROUNDS },
+	{ "isr_all_event_group", vAllGroup, pdTRUE, pdTRUE, pdTRUE,
+	  EG_ROUNDS },
+};
+
+static void vRun(const struct variant *v)
+{
+	TaskHandle_t waiter;
+	unsigned int event;
+	uint64_t round = 0, ns;
+	char metric[64];
+
+	Grouped = v->grouped;
+	Latency = LatencyMax = 0;
+	xTaskCreate(v->waiter, "Waiter", benchSTACK_SIZE, NULL, WAIT_PRIORITY,
+		    &waiter);
+
+	for (unsigned long n = 0; n < v->rounds; n++) {
+		ns = ullBenchWallNs();
+		if (v->all) {
+			/* The waiter runs as each of these is signalled */
+			for (event = 0; event < EG_EVENTS - 1; event++)
+				vSignal(event);
+			Expected = EG_ALL_BITS;
+		} else {
+			event = n % EG_EVENTS;
+			Expected = 1 << event;
+		}
+
+		Start = ullBenchWallNs();
+		if (v->irq)
+			/* Raised from a task, the handler runs before this returns */
+			vPortRaiseIrq(EG_IRQ);
+		else
+			vSignal(event);
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		round += ullBenchWallNs() - ns;
+	}
+
+	vTaskDelete(waiter);
+
+	snprintf(metric, sizeof(metric), "%s_latency", v->name);
+	vBenchReport(metric, Latency / 1000.0 / v->rounds, "us");
+	snprintf(metric, sizeof(metric), "%s_latency_max", v->name);
+	vBenchReport(metric, LatencyMax / 1000.0, "us");
+	snprintf(metric, sizeof(metric), "%s_round", v->name);
+	vBenchReport(metric, round / 1000.0 / v->rounds, "us");
+}
+
+static void vControlTask(void *pvParameters)
+{
+	Control = xTaskGetCurrentTaskHandle();
+
+	for (unsigned int i = 0; i < EG_EVENTS; i++)
+		Events[i] = xSemaphoreCreateBinary();
+	Group = xEventGroupCreate();
+	xPortInstallIrqHandler(EG_IRQ, configMAX_SYSCALL_INTERRUPT_PRIORITY,
+			       vIrqHandler, NULL);
+
+	/*
+	 * Below the waiting task, so every event that completes a wait
+	 * switches to it, and below the timer daemon that runs the sets
+	 * deferred from the interrupt.
+	 */
+	vTaskPrioritySet(NULL, SIGNAL_PRIORITY);
+
+	for (unsigned int i = 0; i < sizeof(Variants) / sizeof(Variants[0]); i++)
+		vRun(&Variants[i]);
+
+	vBenchReport("errors", Errors, "wake ups");
+	vBenchFinish();
+}
+
+int main(int argc, char *argv[])
+{
+	xTaskCreate(vControlTask, "Control", benchSTACK_SIZE, NULL,
+		    benchCONTROL_PRIORITY, NULL);
+
+	vTaskStartScheduler();
+
+	return 0;
+}
@@ -0,0 +1,231 @@
+/**
+ * @file heap.c
+ * @brief Cost of pvPortMalloc() and vPortFree() and how fragmented the heap
+ * becomes
+ *
+ * Blocks of one size are allocated and freed in bursts, kernel objects are
+ * created and deleted, and a window of 1000 blocks of 16 to 1024 bytes is
+ * churned as in the Thread-Metric suite. Built as FreeRTOS_Bench_Heap_Malloc,
+ * with heap_3.c over the C library's malloc(), and FreeRTOS_Bench_Heap_Arena,
+ * with heap_5.c over an arena of configTOTAL_HEAP_SIZE bytes, which also
+ * reports the free space, its largest block and the blocks of each size class
+ * after the churn. Every block is filled and checked before it is freed.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "timers.h"
+
+#include "bench.h"
+
+#define HEAP_BURST 1000
+#define HEAP_BURSTS 100
+#define HEAP_OBJECTS 20000
+#define HEAP_CHURN_SLOTS 1000
+#define HEAP_CHURN_ROUNDS 200000
+#define HEAP_CHURN_SIZE(r) (16 + ((r) >> 16) % 1009)
+
+static const size_t BlockSizes[] = { 16, 96, 512, 4096 };
+
+static void *Blocks[HEAP_CHURN_SLOTS > HEAP_BURST ? HEAP_CHURN_SLOTS :
+							HEAP_BURST];
+static size_t Sizes[sizeof(Blocks) / sizeof(Blocks[0])];
+static unsigned long Errors;
+
+static void *pvAlloc(unsigned int slot, size_t size)
+{
+	void *block = pvPortMalloc(size);
+
+	if (block == NULL ||
+	    ((uintptr_t)block & portBYTE_ALIGNMENT_MASK) != 0) {
+		Errors++;
+		return block;
+	}
+	memset(block, (int)slot, size);
+	Sizes[slot] = size;
+	return block;
+}
+
+static void vFree(unsigned int slot, void *block)
+{
+	const unsigned char *bytes = block;
+
+	if (block == NULL)
+		return;
+	for (size_t i = 0; i < Sizes[slot]; i++)
+		if (bytes[i] != (unsigned char)slot) {
+			Errors++;
+			break;
+		}
+	vPortFree(block);
+}
+
+static void vMeasureBursts(size_t size)
+{
+	uint64_t start, alloc = 0, release = 0;
+	char metric[64];
+
+	for (unsigned int burst = 0; burst < HEAP_BURSTS; burst++) {
+		start = ullBenchWallNs();
+		for (unsigned int i = 0; i < HEAP_BURST; i++)
+			Blocks[i] = pvPortMalloc(size);
+		alloc += ullBenchWallNs() - start;
+
+		start = ullBenchWallNs();
+		for (unsigned int i = 0; i < HEAP_BURST; i++)
+			vPortFree(Blocks[i]);
+		release += ullBenchWallNs() - start;
+
+		/* The fill and check stay out of the timed loops */
+		for (unsigned int i = 0; i < HEAP_BURST; i++)
+			Blocks[i] = pvAlloc(i, size);
+		for (unsigned int i = 0; i < HEAP_BURST; i++)
+			vFree(i, Blocks[i]);
+	}
+
+	snprintf(metric, sizeof(metric), "malloc_%zu", size);
+	vBenchReport(metric, (double)alloc / (HEAP_BURSTS * HEAP_BURST),
+		     "ns/call");
+	snprintf(metric, sizeof(metric), "free_%zu", size);
+	vBenchReport(metric, (double)release / (HEAP_BURSTS * HEAP_BURST),
+		     "ns/call");
+}
+
+static void vTimerCallback(TimerHandle_t timer)
+{
+}
+
+static void vMeasureObjects(void)
+{
+	uint64_t start;
+	QueueHandle_t queue;
+	TimerHandle_t timer;
+
+	start = ullBenchWallNs();
+	for (unsigned int i = 0; i < HEAP_OBJECTS; i++) {
+		queue = xQueueCreate(8, sizeof(uint32_t));
+		if (queue == NULL)
+			Errors++;
+		else
+			vQueueDelete(queue);
+	}
+	vBenchReport("queue_create_delete",
+		     (double)(ullBenchWallNs() - start) / HEAP_OBJECTS, "ns");
+
+	/* The timer daemon frees a timer once it handles the delete command */
+	start = ullBenchWallNs();
+	for (unsigned int i = 0; i < HEAP_OBJECTS; i++) {
+		timer = xTimerCreate("Bench", 1, pdFALSE, NULL,
+				     vTimerCallback);
+		if (timer == NULL)
+			Errors++;
+		else
+			xTimerDelete(timer, portMAX_DELAY);
+	}
+	vBenchReport("timer_create_delete",
+		     (double)(ullBenchWallNs() - start) / HEAP_OBJECTS, "ns");
+}
+
+#if (configUSE_ARENA_HEAP == 1)
+static void vReportStats(void)
+{
+	HeapStats_t stats;
+	size_t bytes;
+	char metric[64];
+
+	vPortGetHeapStats(&stats);
+
+	vBenchReport("heap_free", stats.xAvailableHeapSpaceInBytes, "bytes");
+	vBenchReport("heap_free_min", stats.xMinimumEverFreeBytesRemaining,
+		     "bytes");
+	vBenchReport("heap_largest_free_block",
+		     stats.xSizeOfLargestFreeBlockInBytes, "bytes");
+	vBenchReport("heap_free_blocks", stats.xNumberOfFreeBlocks, "blocks");
+
+	for (unsigned int i = 0; i < portHEAP_SIZE_CLASSES; i++) {
+		bytes = portHEAP_SMALLEST_SIZE_CLASS << i;
+		if (i < portHEAP_SIZE_CLASSES - 1)
+			snprintf(metric, sizeof(metric), "blocks_up_to_%zu",
+				 bytes);
+		else
+			snprintf(metric, sizeof(metric), "blocks_over_%zu",
+				 bytes >> 1);
+		vBenchReport(metric, stats.xAllocatedBlocksInClass[i],
+			     "allocated");
+		vBenchReport(metric, stats.xFreeBlocksInClass[i], "free");
+	}
+}
+#endif
+
+static void vMeasureChurn(void)
+{
+	uint32_t random = 12345;
+	unsigned int slot;
+	uint64_t start;
+
+	memset(Blocks, 0, sizeof(Blocks));
+
+	start = ullBenchWallNs();
+	for (unsigned long n = 0; n < HEAP_CHURN_ROUNDS; n++) {
+		random = random * 1103515245 + 12345;
+		slot = (random >> 8) % HEAP_CHURN_SLOTS;
+
+		vFree(slot, Blocks[slot]);
+		Blocks[slot] = pvAlloc(slot, HEAP_CHURN_SIZE(random));
+	}
+	vBenchReport("churn", (double)(ullBenchWallNs() - start) /
+			      HEAP_CHURN_ROUNDS, "ns/round");
+
+#if (configUSE_ARENA_HEAP == 1)
+	vReportStats();
+#endif
+
+	for (slot = 0; slot < HEAP_CHURN_SLOTS; slot++)
+		vFree(slot, Blocks[slot]);
+}
+
+static void vControlTask(void *pvParameters)
+{
+#if (configUSE_ARENA_HEAP == 1)
+	HeapStats_t before, after;
+
+	vPortGetHeapStats(&before);
+#endif
+
+	for (unsigned int i = 0; i < sizeof(BlockSizes) / sizeof(BlockSizes[0]);
+	     i++)
+		vMeasureBursts(BlockSizes[i]);
+	vMeasureObjects();
+	vMeasureChurn();
+
+#if (configUSE_ARENA_HEAP == 1)
+	/* Let the timer daemon free the last timers */
+	vTaskDelay(pdMS_TO_TICKS(10));
+
+	/* With everything freed again the free blocks must have merged back */
+	vPortGetHeapStats(&after);
+	if (after.xAvailableHeapSpaceInBytes !=
+		    before.xAvailableHeapSpaceInBytes ||
+	    after.xNumberOfFreeBlocks != before.xNumberOfFreeBlocks ||
+	    after.xSizeOfLargestFreeBlockInBytes !=
+		    before.xSizeOfLargestFreeBlockInBytes)
+		Errors++;
+#endif
+
+	vBenchReport("errors", Errors, "lost or corrupted blocks");
+	vBenchFinish();
+}
+
+int main(int argc, char *argv[])
+{
+	xTaskCreate(vControlTask, "Control", benchSTACK_SIZE, NULL,
+		    benchCONTROL_PRIORITY, NULL);
+
+	vTaskStartScheduler();
+
+	return 0;
+}
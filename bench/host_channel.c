@@ -0,0 +1,173 @@
+/**
+ * @file host_channel.c
+ * @brief Hand-off of messages from a host thread to a task
+ *
+ * A host thread the kernel does not know about sends 16 byte messages to a
+ * task, once through a queue, which a host thread can only reach safely from
+ * an interrupt handler, so every message raises a line whose handler sends it
+ * with xQueueSendFromISR(), and once through a channel, which the host thread
+ * writes itself and which only raises its line when the task is waiting.
+ * Reported are the host thread's time per message, the messages per second
+ * that reach the task, the interrupts taken per 1000 messages and any message
+ * received out of order.
+ */
+
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "channel.h"
+#include "bench.h"
+
+#define HANDOFF_MESSAGES 200000
+#define HANDOFF_LENGTH 64
+#define HANDOFF_RECEIVE 32
+#define QUEUE_IRQ 0
+
+struct message {
+	uint32_t sequence;
+	uint32_t payload[3];
+};
+
+static QueueHandle_t Queue;
+static channel_t *Channel;
+static struct message Staged;
+static volatile BaseType_t StagedSent;
+static sem_t StagedDone;
+static uint64_t ProducerNs;
+static uint32_t Expected;
+static unsigned long Errors;
+
+static void vCheck(const struct message *messages, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+		if (messages[i].sequence != Expected++)
+			Errors++;
+}
+
+static void vIrqQueueSend(void *pvParameter)
+{
+	BaseType_t woken = pdFALSE;
+
+	StagedSent = xQueueSendFromISR(Queue, &Staged, &woken);
+	sem_post(&StagedDone);
+	portEND_SWITCHING_ISR(woken);
+}
+
+static void vBlockSignals(void)
+{
+	sigset_t all;
+
+	sigfillset(&all);
+	pthread_sigmask(SIG_BLOCK, &all, NULL);
+}
+
+static void *pvQueueProducer(void *arg)
+{
+	uint64_t ns;
+
+	vBlockSignals();
+	ns = ullBenchWallNs();
+	for (uint32_t n = 0; n < HANDOFF_MESSAGES; n++) {
+		Staged.sequence = n;
+		do {
+			vPortRaiseIrq(QUEUE_IRQ);
+			sem_wait(&StagedDone);
+		} while (StagedSent != pdTRUE);
+	}
+	ProducerNs = ullBenchWallNs() - ns;
+
+	return NULL;
+}
+
+static void *pvChannelProducer(void *arg)
+{
+	struct message message = { 0 };
+	uint64_t ns;
+
+	vBlockSignals();
+	ns = ullBenchWallNs();
+	for (uint32_t n = 0; n < HANDOFF_MESSAGES; n++) {
+		message.sequence = n;
+		while (!channelSend(Channel, &message, 1))
+			sched_yield();
+	}
+	ProducerNs = ullBenchWallNs() - ns;
+
+	return NULL;
+}
+
+static void vReport(const char *name, uint64_t ns, unsigned int irq)
+{
+	xPortIrqStats stats;
+	char metric[64];
+
+	vPortGetIrqStats(irq, &stats);
+
+	snprintf(metric, sizeof(metric), "%s_producer", name);
+	vBenchReport(metric, (double)ProducerNs / HANDOFF_MESSAGES,
+		     "ns/message");
+	snprintf(metric, sizeof(metric), "%s_throughput", name);
+	vBenchReport(metric, HANDOFF_MESSAGES / (ns / 1e9), "messages/s");
+	snprintf(metric, sizeof(metric), "%s_interrupts", name);
+	vBenchReport(metric, stats.ulDispatched * 1000.0 / HANDOFF_MESSAGES,
+		     "per 1000 messages");
+}
+
+static void vControlTask(void *pvParameters)
+{
+	struct message messages[HANDOFF_RECEIVE];
+	pthread_t producer;
+	uint64_t ns;
+
+	sem_init(&StagedDone, 0, 0);
+	Queue = xQueueCreate(HANDOFF_LENGTH, sizeof(struct message));
+	xPortInstallIrqHandler(QUEUE_IRQ, configMAX_SYSCALL_INTERRUPT_PRIORITY,
+			       vIrqQueueSend, NULL);
+
+	Expected = 0;
+	ns = ullBenchWallNs();
+	pthread_create(&producer, NULL, pvQueueProducer, NULL);
+	for (uint32_t n = 0; n < HANDOFF_MESSAGES; n++) {
+		xQueueReceive(Queue, messages, portMAX_DELAY);
+		vCheck(messages, 1);
+	}
+	ns = ullBenchWallNs() - ns;
+	pthread_join(producer, NULL);
+	vReport("queue_irq", ns, QUEUE_IRQ);
+
+	/* Creating the first channel installs the handler of CHANNEL_IRQ */
+	Channel = channelCreate(HANDOFF_LENGTH, sizeof(struct message));
+
+	Expected = 0;
+	ns = ullBenchWallNs();
+	pthread_create(&producer, NULL, pvChannelProducer, NULL);
+	for (uint32_t n = 0; n < HANDOFF_MESSAGES;) {
+		size_t count = channelReceive(Channel, messages,
+					      HANDOFF_RECEIVE, portMAX_DELAY);
+		vCheck(messages, count);
+		n += count;
+	}
+	ns = ullBenchWallNs() - ns;
+	pthread_join(producer, NULL);
+	vReport("channel", ns, CHANNEL_IRQ);
+
+	vBenchReport("errors", Errors, "messages");
+	vBenchFinish();
+}
+
+int main(int argc, char *argv[])
+{
+	xTaskCreate(vControlTask, "Control", benchSTACK_SIZE, NULL,
+		    benchCONTROL_PRIORITY, NULL);
+
+	vTaskStartScheduler();
+
+	return 0;
+}
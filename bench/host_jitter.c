@@ -0,0 +1,97 @@
+/**
+ * @file host_jitter.c
+ * @brief Tick jitter and task wake up latency with and without SCHED_FIFO
+ *
+ * A task wakes up on every tick while a lower priority task keeps the host
+ * busy. FreeRTOS_Bench_Jitter_RealTime asks for the real-time host scheduling
+ * mode, FreeRTOS_Bench_Jitter_Normal does not. Without the privileges for
+ * SCHED_FIFO the real-time variant falls back to normal scheduling and
+ * reports host_realtime as 0.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "bench.h"
+
+#define JITTER_SAMPLES 2000
+#define TICK_PERIOD_NS (1000000000ULL / configTICK_RATE_HZ)
+
+static uint64_t Deviations[JITTER_SAMPLES];
+
+static void vBusyWorker(void *pvParameters)
+{
+	for (;;)
+		;
+}
+
+static int iCompareDeviations(const void *a, const void *b)
+{
+	uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+static void vControlTask(void *pvParameters)
+{
+	xPortTickStats stats;
+	TickType_t wake;
+	uint64_t previous, now, interval, total = 0;
+
+	/* Line up with a tick before the first sample */
+	vTaskDelay(1);
+	wake = xTaskGetTickCount();
+	previous = ullBenchWallNs();
+
+	for (unsigned int i = 0; i < JITTER_SAMPLES; i++) {
+		vTaskDelayUntil(&wake, 1);
+		now = ullBenchWallNs();
+		interval = now - previous;
+		previous = now;
+
+		Deviations[i] = interval > TICK_PERIOD_NS ?
+					interval - TICK_PERIOD_NS :
+					TICK_PERIOD_NS - interval;
+		total += Deviations[i];
+	}
+
+	vPortGetTickStats(&stats);
+	qsort(Deviations, JITTER_SAMPLES, sizeof(Deviations[0]),
+	      iCompareDeviations);
+
+	vBenchReport("host_realtime",
+		     ePortGetHostScheduling() == eHostRealTime, "bool");
+	vBenchReport("wake_jitter_mean", total / 1000.0 / JITTER_SAMPLES, "us");
+	vBenchReport("wake_jitter_p99",
+		     Deviations[JITTER_SAMPLES * 99 / 100] / 1000.0, "us");
+	vBenchReport("wake_jitter_max",
+		     Deviations[JITTER_SAMPLES - 1] / 1000.0, "us");
+	vBenchReport("tick_latency_mean",
+		     stats.ulWakeUps ?
+			     stats.ullWakeLatencyNs / 1000.0 / stats.ulWakeUps :
+			     0,
+		     "us");
+	vBenchReport("tick_latency_max", stats.ulMaxWakeLatencyNs / 1000.0,
+		     "us");
+
+	vBenchFinish();
+}
+
+int main(int argc, char *argv[])
+{
+#ifdef benchHOST_REALTIME
+	vPortSetHostScheduling(eHostRealTime, NULL);
+#endif
+
+	xTaskCreate(vBusyWorker, "Busy", benchSTACK_SIZE, NULL,
+		    tskIDLE_PRIORITY + 1, NULL);
+	xTaskCreate(vControlTask, "Control", benchSTACK_SIZE, NULL,
+		    benchCONTROL_PRIORITY, NULL);
+
+	vTaskStartScheduler();
+
+	return 0;
+}
@@ -0,0 +1,266 @@
+/**
+ * @file irq_latency.c
+ * @brief Latency and duration of simulated interrupts and FromISR wake ups
+ *
+ * A host thread stands in for the peripherals and raises lines of the port's
+ * interrupt controller. The benchmark measures how long a line waits for its
+ * handler, how long a task waits for a semaphore given by a handler, how a
+ * line preempts the handler of a lower priority one and how a critical section
+ * holds off the lines at or below configMAX_SYSCALL_INTERRUPT_PRIORITY but not
+ * those above it. FreeRTOS_Bench_Irq_RealTime runs the tasks in real-time mode
+ * and the peripheral thread above them.
+ */
+
+#include <errno.h>
+#include <pthread.h>
+#include <sched.h>
+#include <semaphore.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+
+#include "bench.h"
+
+#define IRQ_SAMPLES 2000
+#define IRQ_NESTED_SAMPLES 200
+#define IRQ_SPACING_NS 50000
+#define IRQ_PREEMPT_AFTER_NS 20000
+#define IRQ_LONG_HANDLER_NS 100000
+#define IRQ_CRITICAL_NS 200000
+
+#define IRQ_KERNEL_PRIORITY configMAX_SYSCALL_INTERRUPT_PRIORITY
+#define IRQ_FAST_PRIORITY portMAX_IRQ_PRIORITY
+
+enum irq_line {
+	IRQ_FAST,
+	IRQ_GIVE,
+	IRQ_LONG,
+	IRQ_PREEMPT,
+	IRQ_MASKED_GIVE,
+	IRQ_MASKED_FAST,
+};
+
+enum phase { PHASE_FAST, PHASE_GIVE, PHASE_NESTED, PHASE_MASKED, PHASE_EXIT };
+
+static SemaphoreHandle_t Given;
+static sem_t DeviceStart, DeviceDone, Woken;
+static volatile enum phase Phase;
+static volatile uint64_t RaisedNs;
+static uint64_t WakeNs[IRQ_SAMPLES];
+
+static void vSleepNs(uint64_t ns)
+{
+	struct timespec delay = { .tv_sec = ns / 1000000000ULL,
+				  .tv_nsec = ns % 1000000000ULL };
+
+	while (nanosleep(&delay, &delay) && errno == EINTR)
+		;
+}
+
+static void vSpinNs(uint64_t ns)
+{
+	uint64_t start = ullBenchWallNs();
+
+	while (ullBenchWallNs() - start < ns)
+		;
+}
+
+static void vHostWait(sem_t *sem)
+{
+	/* Interrupts taken by a waiting task thread end sem_wait() early */
+	while (sem_wait(sem) && errno == EINTR)
+		;
+}
+
+static void vIrqNothing(void *pvParameter)
+{
+}
+
+static void vIrqGive(void *pvParameter)
+{
+	BaseType_t woken = pdFALSE;
+
+	xSemaphoreGiveFromISR(Given, &woken);
+	portEND_SWITCHING_ISR(woken);
+}
+
+static void vIrqLong(void *pvParameter)
+{
+	vSpinNs(IRQ_LONG_HANDLER_NS);
+}
+
+static void *pvDevice(void *arg)
+{
+	struct sched_param param = {
+		.sched_priority = sched_get_priority_max(SCHED_FIFO)
+	};
+	sigset_t all;
+
+	/* The port's signals are for the task threads */
+	sigfillset(&all);
+	pthread_sigmask(SIG_BLOCK, &all, NULL);
+
+	/* Like a peripheral, above every task */
+	if (ePortGetHostScheduling() == eHostRealTime)
+		pthread_setschedparam(pthread_self(), SCHED_FIFO, &param);
+
+	for (;;) {
+		vHostWait(&DeviceStart);
+
+		switch (Phase) {
+		case PHASE_FAST:
+			for (unsigned int i = 0; i < IRQ_SAMPLES; i++) {
+				vPortRaiseIrq(IRQ_FAST);
+				vSleepNs(IRQ_SPACING_NS);
+			}
+			break;
+		case PHASE_GIVE:
+			for (unsigned int i = 0; i < IRQ_SAMPLES; i++) {
+				RaisedNs = ullBenchWallNs();
+				vPortRaiseIrq(IRQ_GIVE);
+				vHostWait(&Woken);
+				vSleepNs(IRQ_SPACING_NS);
+			}
+			break;
+		case PHASE_NESTED:
+			for (unsigned int i = 0; i < IRQ_NESTED_SAMPLES; i++) {
+				vPortRaiseIrq(IRQ_LONG);
+				vSleepNs(IRQ_PREEMPT_AFTER_NS);
+				vPortRaiseIrq(IRQ_PREEMPT);
+				vSleepNs(IRQ_LONG_HANDLER_NS + IRQ_SPACING_NS);
+			}
+			break;
+		case PHASE_MASKED:
+			vPortRaiseIrq(IRQ_MASKED_GIVE);
+			vPortRaiseIrq(IRQ_MASKED_FAST);
+			break;
+		case PHASE_EXIT:
+			return NULL;
+		}
+
+		sem_post(&DeviceDone);
+	}
+}
+
+static void vRunPhase(enum phase phase)
+{
+	Phase = phase;
+	sem_post(&DeviceStart);
+	vHostWait(&DeviceDone);
+}
+
+static void vReportLine(const char *name, enum irq_line line)
+{
+	xPortIrqStats stats;
+	char metric[64];
+	unsigned long n;
+
+	vPortGetIrqStats(line, &stats);
+	n = stats.ulDispatched ? stats.ulDispatched : 1;
+
+	snprintf(metric, sizeof(metric), "%s_latency_mean", name);
+	vBenchReport(metric, stats.ullLatencyNs / 1000.0 / n, "us");
+	snprintf(metric, sizeof(metric), "%s_latency_max", name);
+	vBenchReport(metric, stats.ulMaxLatencyNs / 1000.0, "us");
+	snprintf(metric, sizeof(metric), "%s_duration_mean", name);
+	vBenchReport(metric, stats.ullDurationNs / 1000.0 / n, "us");
+}
+
+static int iCompareNs(const void *a, const void *b)
+{
+	uint64_t x = *(const uint64_t *)a, y = *(const uint64_t *)b;
+
+	return (x > y) - (x < y);
+}
+
+static void vControlTask(void *pvParameters)
+{
+	xPortIrqStats stats;
+	pthread_t device;
+	uint64_t total = 0;
+
+	Given = xSemaphoreCreateBinary();
+	sem_init(&DeviceStart, 0, 0);
+	sem_init(&DeviceDone, 0, 0);
+	sem_init(&Woken, 0, 0);
+
+	xPortInstallIrqHandler(IRQ_FAST, IRQ_FAST_PRIORITY, vIrqNothing, NULL);
+	xPortInstallIrqHandler(IRQ_GIVE, IRQ_KERNEL_PRIORITY, vIrqGive, NULL);
+	xPortInstallIrqHandler(IRQ_LONG, 1, vIrqLong, NULL);
+	xPortInstallIrqHandler(IRQ_PREEMPT, IRQ_KERNEL_PRIORITY, vIrqNothing,
+			       NULL);
+	xPortInstallIrqHandler(IRQ_MASKED_GIVE, IRQ_KERNEL_PRIORITY, vIrqGive,
+			       NULL);
+	xPortInstallIrqHandler(IRQ_MASKED_FAST, IRQ_FAST_PRIORITY, vIrqNothing,
+			       NULL);
+
+	pthread_create(&device, NULL, pvDevice, NULL);
+
+	/* A handler that does nothing, above the kernel */
+	vRunPhase(PHASE_FAST);
+	vReportLine("fast", IRQ_FAST);
+
+	/* A handler giving a semaphore this task waits for */
+	Phase = PHASE_GIVE;
+	sem_post(&DeviceStart);
+	for (unsigned int i = 0; i < IRQ_SAMPLES; i++) {
+		xSemaphoreTake(Given, portMAX_DELAY);
+		WakeNs[i] = ullBenchWallNs() - RaisedNs;
+		total += WakeNs[i];
+		sem_post(&Woken);
+	}
+	vHostWait(&DeviceDone);
+	qsort(WakeNs, IRQ_SAMPLES, sizeof(WakeNs[0]), iCompareNs);
+	vReportLine("give", IRQ_GIVE);
+	vBenchReport("give_wake_mean", total / 1000.0 / IRQ_SAMPLES, "us");
+	vBenchReport("give_wake_p99", WakeNs[IRQ_SAMPLES * 99 / 100] / 1000.0,
+		     "us");
+	vBenchReport("give_wake_max", WakeNs[IRQ_SAMPLES - 1] / 1000.0, "us");
+
+	/* A line raised while a lower priority handler runs */
+	vRunPhase(PHASE_NESTED);
+	vPortGetIrqStats(IRQ_PREEMPT, &stats);
+	vReportLine("preempt", IRQ_PREEMPT);
+	vBenchReport("preempt_nested",
+		     100.0 * stats.ulNested /
+			     (stats.ulDispatched ? stats.ulDispatched : 1),
+		     "%");
+
+	/* Lines raised inside a critical section */
+	for (unsigned int i = 0; i < IRQ_NESTED_SAMPLES; i++) {
+		taskENTER_CRITICAL();
+		vRunPhase(PHASE_MASKED);
+		vSpinNs(IRQ_CRITICAL_NS);
+		taskEXIT_CRITICAL();
+		xSemaphoreTake(Given, 0);
+	}
+	vReportLine("masked_fast", IRQ_MASKED_FAST);
+	vReportLine("masked_give", IRQ_MASKED_GIVE);
+	vPortGetIrqStats(IRQ_MASKED_GIVE, &stats);
+	vBenchReport("masked_give_deferred", stats.ulDeferred, "times");
+
+	Phase = PHASE_EXIT;
+	sem_post(&DeviceStart);
+	pthread_join(device, NULL);
+
+	vBenchFinish();
+}
+
+int main(int argc, char *argv[])
+{
+#ifdef benchHOST_REALTIME
+	vPortSetHostScheduling(eHostRealTime, NULL);
+#endif
+
+	xTaskCreate(vControlTask, "Control", benchSTACK_SIZE, NULL,
+		    benchCONTROL_PRIORITY, NULL);
+
+	vTaskStartScheduler();
+
+	return 0;
+}
@@ -0,0 +1,188 @@
+/**
+ * @file queue_batch.c
+ * @brief Cost per item of the batched queue calls against one call per item
+ *
+ * Bursts of bytes, like those the UDP signal handler posts, are sent and
+ * received by a task and posted by a simulated interrupt, once with a call per
+ * byte and once with xQueueSendMultiple(), xQueueSendMultipleFromISR() and
+ * xQueueReceiveMultiple(). Draw job sized items are drained the way
+ * vDrawUpdateScreen() does. Every item received is checked against the order
+ * in which it was sent.
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "bench.h"
+
+#define BATCH_BURST 200
+#define BATCH_BURSTS 20000
+#define BATCH_IRQ_BURSTS 5000
+#define BATCH_JOB_QUEUE 100
+#define BATCH_JOB_ROUNDS 20000
+#define BATCH_JOB_DRAIN 16
+#define IRQ_SINGLE 0
+#define IRQ_MULTIPLE 1
+
+struct job {
+	int type;
+	void *data;
+};
+
+static QueueHandle_t Bytes;
+static uint8_t Burst[BATCH_BURST];
+static unsigned long Errors;
+
+static void vCheckBytes(const uint8_t *bytes, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+		if (bytes[i] != Burst[i])
+			Errors++;
+}
+
+static void vIrqSingle(void *pvParameter)
+{
+	BaseType_t woken = pdFALSE;
+
+	for (unsigned int i = 0; i < BATCH_BURST; i++)
+		xQueueSendFromISR(Bytes, &Burst[i], &woken);
+	portEND_SWITCHING_ISR(woken);
+}
+
+static void vIrqMultiple(void *pvParameter)
+{
+	BaseType_t woken = pdFALSE;
+
+	xQueueSendMultipleFromISR(Bytes, Burst, BATCH_BURST, &woken);
+	portEND_SWITCHING_ISR(woken);
+}
+
+static void vReport(const char *name, uint64_t ns, unsigned long items)
+{
+	vBenchReport(name, (double)ns / items, "ns/item");
+}
+
+static void vBytesTaskToTask(void)
+{
+	uint8_t rx[BATCH_BURST];
+	uint64_t ns;
+
+	ns = ullBenchWallNs();
+	for (unsigned int n = 0; n < BATCH_BURSTS; n++) {
+		for (unsigned int i = 0; i < BATCH_BURST; i++)
+			xQueueSend(Bytes, &Burst[i], 0);
+		for (unsigned int i = 0; i < BATCH_BURST; i++)
+			xQueueReceive(Bytes, &rx[i], 0);
+		vCheckBytes(rx, BATCH_BURST);
+	}
+	vReport("bytes_single", ullBenchWallNs() - ns,
+		2UL * BATCH_BURSTS * BATCH_BURST);
+
+	ns = ullBenchWallNs();
+	for (unsigned int n = 0; n < BATCH_BURSTS; n++) {
+		xQueueSendMultiple(Bytes, Burst, BATCH_BURST, 0);
+		if (xQueueReceiveMultiple(Bytes, rx, BATCH_BURST, 0) !=
+		    BATCH_BURST)
+			Errors++;
+		vCheckBytes(rx, BATCH_BURST);
+	}
+	vReport("bytes_multiple", ullBenchWallNs() - ns,
+		2UL * BATCH_BURSTS * BATCH_BURST);
+}
+
+static void vBytesFromIsr(const char *name, unsigned int irq)
+{
+	xPortIrqStats stats;
+	uint8_t rx[BATCH_BURST];
+	char metric[64];
+
+	for (unsigned int n = 0; n < BATCH_IRQ_BURSTS; n++) {
+		/* Raised from a task, the handler runs before this returns */
+		vPortRaiseIrq(irq);
+		if (xQueueReceiveMultiple(Bytes, rx, BATCH_BURST, portMAX_DELAY) !=
+		    BATCH_BURST)
+			Errors++;
+		vCheckBytes(rx, BATCH_BURST);
+	}
+
+	vPortGetIrqStats(irq, &stats);
+	snprintf(metric, sizeof(metric), "%s_handler", name);
+	vBenchReport(metric,
+		     stats.ullDurationNs / 1000.0 /
+			     (stats.ulDispatched ? stats.ulDispatched : 1),
+		     "us/burst");
+}
+
+static void vDrawJobs(void)
+{
+	QueueHandle_t jobs = xQueueCreate(BATCH_JOB_QUEUE, sizeof(struct job));
+	struct job job = { 0 }, drained[BATCH_JOB_DRAIN];
+	uint64_t ns, total = 0;
+	size_t count;
+
+	for (unsigned int n = 0; n < BATCH_JOB_ROUNDS; n++) {
+		for (job.type = 0; job.type < BATCH_JOB_QUEUE; job.type++)
+			xQueueSend(jobs, &job, 0);
+		ns = ullBenchWallNs();
+		while (xQueueReceive(jobs, &job, 0) == pdTRUE)
+			;
+		total += ullBenchWallNs() - ns;
+	}
+	vReport("jobs_drain_single", total,
+		(unsigned long)BATCH_JOB_ROUNDS * BATCH_JOB_QUEUE);
+
+	total = 0;
+	for (unsigned int n = 0; n < BATCH_JOB_ROUNDS; n++) {
+		for (job.type = 0; job.type < BATCH_JOB_QUEUE; job.type++)
+			xQueueSend(jobs, &job, 0);
+		ns = ullBenchWallNs();
+		job.type = 0;
+		while ((count = xQueueReceiveMultiple(jobs, drained,
+						      BATCH_JOB_DRAIN, 0)))
+			for (size_t i = 0; i < count; i++)
+				if (drained[i].type != job.type++)
+					Errors++;
+		total += ullBenchWallNs() - ns;
+	}
+	vReport("jobs_drain_multiple", total,
+		(unsigned long)BATCH_JOB_ROUNDS * BATCH_JOB_QUEUE);
+
+	vQueueDelete(jobs);
+}
+
+static void vControlTask(void *pvParameters)
+{
+	for (unsigned int i = 0; i < BATCH_BURST; i++)
+		Burst[i] = (uint8_t)(i * 7);
+
+	/* Not a multiple of the burst, so bursts wrap around its end */
+	Bytes = xQueueCreate(BATCH_BURST + 56, sizeof(uint8_t));
+
+	vBytesTaskToTask();
+
+	xPortInstallIrqHandler(IRQ_SINGLE, configMAX_SYSCALL_INTERRUPT_PRIORITY,
+			       vIrqSingle, NULL);
+	xPortInstallIrqHandler(IRQ_MULTIPLE,
+			       configMAX_SYSCALL_INTERRUPT_PRIORITY,
+			       vIrqMultiple, NULL);
+	vBytesFromIsr("isr_single", IRQ_SINGLE);
+	vBytesFromIsr("isr_multiple", IRQ_MULTIPLE);
+
+	vDrawJobs();
+
+	vBenchReport("errors", Errors, "items");
+	vBenchFinish();
+}
+
+int main(int argc, char *argv[])
+{
+	xTaskCreate(vControlTask, "Control", benchSTACK_SIZE, NULL,
+		    benchCONTROL_PRIORITY, NULL);
+
+	vTaskStartScheduler();
+
+	return 0;
+}
@@ -0,0 +1,305 @@
+/**
+ * @file queue_zero_copy.c
+ * @brief Cost of passing large items by copy and in place
+ *
+ * Packets of 64, 512 (the size of the scancode table) and 4096 bytes are
+ * written by a producer and summed by a consumer, once through a buffer of
+ * their own and xQueueSend()/xQueueReceive(), which copy them into and out of
+ * the queue, and once in the queue's storage with pvQueueReserve()/
+ * vQueueCommit() and pvQueueAcquire()/vQueueRelease(). The same is done with
+ * a simulated interrupt as the producer. Every packet is checked. Finally a
+ * send to the front and an overwrite made while an item is acquired must wait
+ * for its release and leave the other items in order, and other senders and
+ * receivers must wait for a reserved slot to be committed and an acquired item
+ * to be released.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+
+#include "bench.h"
+
+#define ZC_QUEUE_LENGTH 8
+#define ZC_MAX_SIZE 4096
+#define ZC_BYTES_PER_SIZE (64UL * 1024 * 1024)
+#define ZC_IRQ_PACKETS 5000
+#define IRQ_COPY 0
+#define IRQ_IN_PLACE 1
+#define FRONT_SENDER_PRIORITY (benchCONTROL_PRIORITY - 1)
+
+static const size_t Sizes[] = { 64, 512, 4096 };
+
+static QueueHandle_t Packets;
+static size_t PacketSize;
+static uint8_t Staging[ZC_MAX_SIZE], Received[ZC_MAX_SIZE];
+static uint8_t Sequence;
+static unsigned long Errors;
+
+static void vFill(uint8_t *packet)
+{
+	memset(packet, Sequence, PacketSize);
+}
+
+/* Reads a byte of every cache line, so the packet is fetched but the sum
+ * costs little next to the copies */
+static void vCheck(const uint8_t *packet)
+{
+	unsigned long sum = 0;
+
+	for (size_t i = 0; i < PacketSize; i += 64)
+		sum += packet[i];
+	if (sum != (unsigned long)Sequence * (PacketSize / 64))
+		Errors++;
+	Sequence++;
+}
+
+static void vIrqCopy(void *pvParameter)
+{
+	BaseType_t woken = pdFALSE;
+
+	vFill(Staging);
+	xQueueSendFromISR(Packets, Staging, &woken);
+	portEND_SWITCHING_ISR(woken);
+}
+
+static void vIrqInPlace(void *pvParameter)
+{
+	BaseType_t woken = pdFALSE;
+	uint8_t *slot = pvQueueReserveFromISR(Packets);
+
+	if (slot) {
+		vFill(slot);
+		vQueueCommitFromISR(Packets, &woken);
+	}
+	portEND_SWITCHING_ISR(woken);
+}
+
+static void vReport(const char *name, uint64_t ns, unsigned long packets)
+{
+	char metric[64];
+
+	snprintf(metric, sizeof(metric), "%s_%zu", name, PacketSize);
+	vBenchReport(metric, (double)ns / packets, "ns/packet");
+}
+
+static void vTaskToTask(void)
+{
+	unsigned long packets = ZC_BYTES_PER_SIZE / PacketSize;
+	uint64_t ns;
+	uint8_t *item;
+
+	ns = ullBenchWallNs();
+	for (unsigned long n = 0; n < packets; n++) {
+		vFill(Staging);
+		xQueueSend(Packets, Staging, 0);
+		xQueueReceive(Packets, Received, 0);
+		vCheck(Received);
+	}
+	vReport("copy", ullBenchWallNs() - ns, packets);
+
+	ns = ullBenchWallNs();
+	for (unsigned long n = 0; n < packets; n++) {
+		item = pvQueueReserve(Packets, 0);
+		vFill(item);
+		vQueueCommit(Packets);
+		item = pvQueueAcquire(Packets, 0);
+		vCheck(item);
+		vQueueRelease(Packets);
+	}
+	vReport("in_place", ullBenchWallNs() - ns, packets);
+}
+
+static void vFromIsr(const char *name, unsigned int irq)
+{
+	xPortIrqStats stats;
+	char metric[64];
+	uint8_t *item;
+
+	for (unsigned int n = 0; n < ZC_IRQ_PACKETS; n++) {
+		/* Raised from a task, the handler runs before this returns */
+		vPortRaiseIrq(irq);
+		item = pvQueueAcquire(Packets, portMAX_DELAY);
+		vCheck(item);
+		vQueueRelease(Packets);
+	}
+
+	vPortGetIrqStats(irq, &stats);
+	snprintf(metric, sizeof(metric), "%s_%zu_handler", name, PacketSize);
+	vBenchReport(metric,
+		     (double)stats.ullDurationNs /
+			     (stats.ulDispatched ? stats.ulDispatched : 1),
+		     "ns/packet");
+}
+
+static void vFrontSender(void *pvParameters)
+{
+	uint32_t item = 3;
+
+	xQueueSendToFront(pvParameters, &item, portMAX_DELAY);
+	vTaskDelete(NULL);
+}
+
+static void vBackSender(void *pvParameters)
+{
+	uint32_t item = 2;
+
+	xQueueSend(pvParameters, &item, portMAX_DELAY);
+	vTaskDelete(NULL);
+}
+
+static void vReceiver(void *pvParameters)
+{
+	uint32_t item;
+
+	if (xQueueReceive(pvParameters, &item, portMAX_DELAY) != pdPASS ||
+	    item != 2)
+		Errors++;
+	vTaskDelete(NULL);
+}
+
+static void vCheckNext(QueueHandle_t queue, uint32_t expected)
+{
+	uint32_t item = 0;
+
+	if (xQueueReceive(queue, &item, 0) != pdPASS || item != expected)
+		Errors++;
+}
+
+/*
+ * Items 1 and 2 are queued and 1 is acquired. A send of 3 to the front from
+ * another task blocks until 1 is released and then goes ahead of 2, and an
+ * overwrite of an acquired item fails and leaves it alone.
+ */
+static void vFrontWhileAcquired(void)
+{
+	QueueHandle_t queue = xQueueCreate(ZC_QUEUE_LENGTH, sizeof(uint32_t));
+	uint32_t item, *acquired;
+
+	item = 1;
+	xQueueSend(queue, &item, 0);
+	item = 2;
+	xQueueSend(queue, &item, 0);
+
+	acquired = pvQueueAcquire(queue, 0);
+	item = 4;
+	if (xQueueSendToFront(queue, &item, 0) != errQUEUE_FULL)
+		Errors++;
+	xTaskCreate(vFrontSender, "Front", configMINIMAL_STACK_SIZE, queue,
+		    FRONT_SENDER_PRIORITY, NULL);
+	/* The sender blocks on the acquired item */
+	vTaskDelay(1);
+	if (!acquired || *acquired != 1 || uxQueueMessagesWaiting(queue) != 2)
+		Errors++;
+	vQueueRelease(queue);
+	vTaskDelay(1);
+
+	vCheckNext(queue, 3);
+	vCheckNext(queue, 2);
+	if (uxQueueMessagesWaiting(queue) != 0)
+		Errors++;
+	vQueueDelete(queue);
+
+	queue = xQueueCreate(1, sizeof(uint32_t));
+	item = 1;
+	xQueueOverwrite(queue, &item);
+	acquired = pvQueueAcquire(queue, 0);
+	item = 2;
+	if (xQueueOverwrite(queue, &item) != errQUEUE_FULL ||
+	    !acquired || *acquired != 1)
+		Errors++;
+	vQueueRelease(queue);
+	if (xQueueOverwrite(queue, &item) != pdPASS)
+		Errors++;
+	vCheckNext(queue, 2);
+	vQueueDelete(queue);
+}
+
+/*
+ * While a slot is reserved no other send or reservation gets in, and a
+ * blocked sender goes after the committed item. While an item is acquired no
+ * other receive, peek or acquisition gets it, and a blocked receiver takes the
+ * item after it once it is released.
+ */
+static void vOthersWhileZeroCopy(void)
+{
+	QueueHandle_t queue = xQueueCreate(ZC_QUEUE_LENGTH, sizeof(uint32_t));
+	uint32_t item = 9, items[2] = { 9, 9 }, *slot, *acquired;
+
+	slot = pvQueueReserve(queue, 0);
+	if (!slot || xQueueSend(queue, &item, 0) != errQUEUE_FULL ||
+	    xQueueSendToFront(queue, &item, 0) != errQUEUE_FULL ||
+	    xQueueSendMultiple(queue, items, 2, 0) != 0 ||
+	    pvQueueReserve(queue, 0) != NULL)
+		Errors++;
+	xTaskCreate(vBackSender, "Back", configMINIMAL_STACK_SIZE, queue,
+		    FRONT_SENDER_PRIORITY, NULL);
+	/* The sender blocks on the reserved slot */
+	vTaskDelay(1);
+	if (uxQueueMessagesWaiting(queue) != 0)
+		Errors++;
+	*slot = 1;
+	vQueueCommit(queue);
+	vTaskDelay(1);
+	if (uxQueueMessagesWaiting(queue) != 2)
+		Errors++;
+
+	acquired = pvQueueAcquire(queue, 0);
+	if (!acquired || *acquired != 1 ||
+	    xQueueReceive(queue, &item, 0) != errQUEUE_EMPTY ||
+	    xQueuePeek(queue, &item, 0) != errQUEUE_EMPTY ||
+	    xQueueReceiveMultiple(queue, items, 2, 0) != 0 ||
+	    pvQueueAcquire(queue, 0) != NULL)
+		Errors++;
+	xTaskCreate(vReceiver, "Receiver", configMINIMAL_STACK_SIZE, queue,
+		    FRONT_SENDER_PRIORITY, NULL);
+	/* The receiver blocks on the acquired item */
+	vTaskDelay(1);
+	if (uxQueueMessagesWaiting(queue) != 2)
+		Errors++;
+	vQueueRelease(queue);
+	vTaskDelay(1);
+	if (uxQueueMessagesWaiting(queue) != 0)
+		Errors++;
+	vQueueDelete(queue);
+}
+
+static void vControlTask(void *pvParameters)
+{
+	for (unsigned int i = 0; i < sizeof(Sizes) / sizeof(Sizes[0]); i++) {
+		PacketSize = Sizes[i];
+		Packets = xQueueCreate(ZC_QUEUE_LENGTH, PacketSize);
+
+		vTaskToTask();
+
+		xPortInstallIrqHandler(IRQ_COPY,
+				       configMAX_SYSCALL_INTERRUPT_PRIORITY,
+				       vIrqCopy, NULL);
+		xPortInstallIrqHandler(IRQ_IN_PLACE,
+				       configMAX_SYSCALL_INTERRUPT_PRIORITY,
+				       vIrqInPlace, NULL);
+		vFromIsr("isr_copy", IRQ_COPY);
+		vFromIsr("isr_in_place", IRQ_IN_PLACE);
+
+		vQueueDelete(Packets);
+	}
+
+	vFrontWhileAcquired();
+	vOthersWhileZeroCopy();
+
+	vBenchReport("errors", Errors, "packets");
+	vBenchFinish();
+}
+
+int main(int argc, char *argv[])
+{
+	xTaskCreate(vControlTask, "Control", benchSTACK_SIZE, NULL,
+		    benchCONTROL_PRIORITY, NULL);
+
+	vTaskStartScheduler();
+
+	return 0;
+}
@@ -0,0 +1,118 @@
+/**
+ * @file run_time_stats.c
+ * @brief Accuracy of the per task run-time statistics
+ *
+ * A heavy and a light task keep the processor busy for part of every period
+ * while the control task samples uxTaskGetSystemState() before and after.
+ * Every task's share of the elapsed time is reported, followed by how much of
+ * the process's CPU time the statistics accounted for, which should be close
+ * to 100%.
+ */
+
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "bench.h"
+
+#define STATS_PERIOD_MS 2000
+#define STATS_MAX_TASKS 8
+
+/* Light preempts heavy, which on its own would keep the processor 80% busy */
+#define HEAVY_PRIORITY (tskIDLE_PRIORITY + 1)
+#define HEAVY_BUSY_MS 8
+#define HEAVY_SLEEP_MS 2
+#define LIGHT_PRIORITY (tskIDLE_PRIORITY + 2)
+#define LIGHT_BUSY_MS 1
+#define LIGHT_SLEEP_MS 9
+
+static void vBurn(unsigned int ms)
+{
+	uint64_t until = ullBenchWallNs() + ms * 1000000ULL;
+
+	while (ullBenchWallNs() < until)
+		;
+}
+
+static void vHeavyTask(void *pvParameters)
+{
+	for (;;) {
+		vBurn(HEAVY_BUSY_MS);
+		vTaskDelay(pdMS_TO_TICKS(HEAVY_SLEEP_MS));
+	}
+}
+
+static void vLightTask(void *pvParameters)
+{
+	for (;;) {
+		vBurn(LIGHT_BUSY_MS);
+		vTaskDelay(pdMS_TO_TICKS(LIGHT_SLEEP_MS));
+	}
+}
+
+static configRUN_TIME_COUNTER_TYPE ullFindRunTime(TaskStatus_t *tasks,
+						   UBaseType_t count,
+						   const char *name)
+{
+	for (UBaseType_t i = 0; i < count; i++)
+		if (!strcmp(tasks[i].pcTaskName, name))
+			return tasks[i].ulRunTimeCounter;
+
+	return 0;
+}
+
+static void vControlTask(void *pvParameters)
+{
+	static const char *names[] = { "Heavy", "Light", "IDLE", "Control" };
+	static const char *metrics[] = { "heavy", "light", "idle", "control" };
+	static TaskStatus_t before[STATS_MAX_TASKS], after[STATS_MAX_TASKS];
+	configRUN_TIME_COUNTER_TYPE total_before, total_after, accounted = 0;
+	UBaseType_t count_before, count_after;
+	uint64_t cpu;
+	char metric[64];
+
+	xTaskCreate(vHeavyTask, "Heavy", benchSTACK_SIZE, NULL, HEAVY_PRIORITY,
+		    NULL);
+	xTaskCreate(vLightTask, "Light", benchSTACK_SIZE, NULL, LIGHT_PRIORITY,
+		    NULL);
+
+	/* Let both tasks settle into their pattern */
+	vTaskDelay(pdMS_TO_TICKS(100));
+
+	count_before = uxTaskGetSystemState(before, STATS_MAX_TASKS,
+					    &total_before);
+	cpu = ullBenchCpuNs();
+	vTaskDelay(pdMS_TO_TICKS(STATS_PERIOD_MS));
+	cpu = ullBenchCpuNs() - cpu;
+	count_after = uxTaskGetSystemState(after, STATS_MAX_TASKS,
+					   &total_after);
+
+	for (unsigned int i = 0; i < sizeof(names) / sizeof(names[0]); i++) {
+		configRUN_TIME_COUNTER_TYPE used =
+			ullFindRunTime(after, count_after, names[i]) -
+			ullFindRunTime(before, count_before, names[i]);
+
+		accounted += used;
+		snprintf(metric, sizeof(metric), "%s_task_cpu", metrics[i]);
+		vBenchReport(metric, 100.0 * used / (total_after - total_before),
+			     "%");
+	}
+
+	vBenchReport("process_cpu", 100.0 * cpu / (total_after - total_before),
+		     "%");
+	vBenchReport("accounted_cpu", 100.0 * accounted / cpu, "%");
+
+	vBenchFinish();
+}
+
+int main(int argc, char *argv[])
+{
+	xTaskCreate(vControlTask, "Control", benchSTACK_SIZE, NULL,
+		    benchCONTROL_PRIORITY, NULL);
+
+	vTaskStartScheduler();
+
+	return 0;
+}
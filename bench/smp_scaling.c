@@ -0,0 +1,136 @@
+/**
+ * @file smp_scaling.c
+ * @brief Throughput of the SMP port against the number of emulated cores
+ *
+ * Built as FreeRTOS_Bench_SMP_1 (the single core Posix port),
+ * FreeRTOS_Bench_SMP_2 and FreeRTOS_Bench_SMP_4. The same fixed set of
+ * workers runs on each, so the results scale with the number of cores only as
+ * far as the host has CPUs to give them.
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "task.h"
+
+#include "bench.h"
+
+#define SCALING_WORKERS 8
+#define SCALING_PERIOD_MS 1000
+#define SCALING_CHUNK 10000
+#define SCALING_QUEUE_LENGTH 8
+#define WORKER_PRIORITY (tskIDLE_PRIORITY + 1)
+
+struct worker {
+	TaskHandle_t task;
+	QueueHandle_t queue;
+	volatile uint32_t ops;
+	volatile uint32_t state;
+} __attribute__((aligned(64)));
+
+static struct worker Workers[SCALING_WORKERS];
+
+static void vComputeWorker(void *pvParameters)
+{
+	struct worker *w = pvParameters;
+	uint32_t x = w->state;
+
+	for (;;) {
+		for (unsigned int i = 0; i < SCALING_CHUNK; i++)
+			x = x * 1664525 + 1013904223;
+
+		w->state = x;
+		w->ops++;
+	}
+}
+
+static void vProducerWorker(void *pvParameters)
+{
+	struct worker *w = pvParameters;
+	uint32_t message = 0;
+
+	for (;;)
+		xQueueSend(w->queue, &message, portMAX_DELAY);
+}
+
+static void vConsumerWorker(void *pvParameters)
+{
+	struct worker *w = pvParameters;
+	uint32_t message;
+
+	for (;;)
+		if (xQueueReceive(w->queue, &message, portMAX_DELAY) == pdPASS)
+			w->ops++;
+}
+
+/*
+ * Lets the workers created by the caller run for SCALING_PERIOD_MS, deletes
+ * them and reports the operations they completed per second together with
+ * how many host CPUs the process kept busy on average.
+ */
+static void vMeasure(const char *name, const char *unit)
+{
+	uint32_t start[SCALING_WORKERS], ops = 0;
+	uint64_t wall, cpu;
+	char metric[64];
+
+	for (unsigned int i = 0; i < SCALING_WORKERS; i++)
+		start[i] = Workers[i].ops;
+	wall = ullBenchWallNs();
+	cpu = ullBenchCpuNs();
+
+	vTaskDelay(pdMS_TO_TICKS(SCALING_PERIOD_MS));
+
+	for (unsigned int i = 0; i < SCALING_WORKERS; i++)
+		ops += Workers[i].ops - start[i];
+	wall = ullBenchWallNs() - wall;
+	cpu = ullBenchCpuNs() - cpu;
+
+	for (unsigned int i = 0; i < SCALING_WORKERS; i++) {
+		if (Workers[i].task)
+			vTaskDelete(Workers[i].task);
+		Workers[i].task = NULL;
+	}
+
+	vBenchReport(name, ops * 1e9 / wall, unit);
+	snprintf(metric, sizeof(metric), "%s_host_cpus", name);
+	vBenchReport(metric, (double)cpu / wall, "cpus");
+}
+
+static void vControlTask(void *pvParameters)
+{
+	for (unsigned int i = 0; i < SCALING_WORKERS; i++) {
+		Workers[i].state = i;
+		xTaskCreate(vComputeWorker, "Compute", benchSTACK_SIZE,
+			    &Workers[i], WORKER_PRIORITY, &Workers[i].task);
+	}
+	vMeasure("compute", "chunks/s");
+
+	/* Producer and consumer pairs, each on its own queue */
+	for (unsigned int i = 0; i < SCALING_WORKERS; i += 2) {
+		Workers[i].queue = xQueueCreate(SCALING_QUEUE_LENGTH,
+						sizeof(uint32_t));
+		Workers[i + 1].queue = Workers[i].queue;
+		xTaskCreate(vProducerWorker, "Producer", benchSTACK_SIZE,
+			    &Workers[i], WORKER_PRIORITY, &Workers[i].task);
+		xTaskCreate(vConsumerWorker, "Consumer", benchSTACK_SIZE,
+			    &Workers[i + 1], WORKER_PRIORITY,
+			    &Workers[i + 1].task);
+	}
+	vMeasure("queue", "msgs/s");
+
+	vBenchReport("cores", configNUM_CORES, "cores");
+
+	vBenchFinish();
+}
+
+int main(int argc, char *argv[])
+{
+	xTaskCreate(vControlTask, "Control", benchSTACK_SIZE, NULL,
+		    benchCONTROL_PRIORITY, NULL);
+
+	vTaskStartScheduler();
+
+	return 0;
+}
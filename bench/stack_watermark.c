@@ -0,0 +1,92 @@
+/**
+ * @file stack_watermark.c
+ * @brief Accuracy and cost of the stack high water marks of host thread stacks
+ *
+ * Workers use a known number of bytes of stack and suspend, the benchmark then
+ * reports how much of its stack the port measured each of them to have used.
+ * FreeRTOS_Bench_Stack_RealTime does the same with the stacks prefaulted and
+ * locked in real-time mode, where the untouched pages are resident.
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "bench.h"
+
+#define STACK_DEPTH 1024
+#define STACK_QUERIES 1000
+#define WORKER_PRIORITY (tskIDLE_PRIORITY + 1)
+
+/* Bytes of stack each worker uses, the last one more than STACK_DEPTH words
+ * scaled to the host */
+static const unsigned int Usage[] = { 1024, 4096, 12288, 32768 };
+
+#define STACK_WORKERS (sizeof(Usage) / sizeof(Usage[0]))
+
+static TaskHandle_t Tasks[STACK_WORKERS];
+
+static unsigned char __attribute__((noinline)) ucUseStack(unsigned int bytes)
+{
+	volatile unsigned char buffer[bytes];
+
+	for (unsigned int i = 0; i < bytes; i++)
+		buffer[i] = 0x5a;
+
+	return buffer[bytes - 1];
+}
+
+static void vWorker(void *pvParameters)
+{
+	(void)ucUseStack(*(const unsigned int *)pvParameters);
+	vTaskSuspend(NULL);
+}
+
+static void vControlTask(void *pvParameters)
+{
+	char metric[64];
+	UBaseType_t mark = 0;
+	uint64_t ns;
+
+	for (unsigned int i = 0; i < STACK_WORKERS; i++)
+		xTaskCreate(vWorker, "Worker", STACK_DEPTH, (void *)&Usage[i],
+			    WORKER_PRIORITY, &Tasks[i]);
+
+	/* Every worker runs once and suspends itself */
+	vTaskDelay(pdMS_TO_TICKS(100));
+
+	for (unsigned int i = 0; i < STACK_WORKERS; i++) {
+		snprintf(metric, sizeof(metric), "used_%u", Usage[i]);
+		vBenchReport(metric, xPortGetStackBytesUsed(Tasks[i]), "bytes");
+		snprintf(metric, sizeof(metric), "high_water_mark_%u", Usage[i]);
+		vBenchReport(metric, uxTaskGetStackHighWaterMark(Tasks[i]),
+			     "words");
+	}
+
+	ns = ullBenchWallNs();
+	for (unsigned int i = 0; i < STACK_QUERIES; i++)
+		mark += uxTaskGetStackHighWaterMark(Tasks[i % STACK_WORKERS]);
+	ns = ullBenchWallNs() - ns;
+	vBenchReport("query", (double)ns / STACK_QUERIES / 1000.0, "us");
+
+	for (unsigned int i = 0; i < STACK_WORKERS; i++)
+		vTaskDelete(Tasks[i]);
+
+	(void)mark;
+	vBenchFinish();
+}
+
+int main(int argc, char *argv[])
+{
+#ifdef benchHOST_REALTIME
+	vPortSetHostScheduling(eHostRealTime, NULL);
+#endif
+
+	xTaskCreate(vControlTask, "Control", benchSTACK_SIZE, NULL,
+		    benchCONTROL_PRIORITY, NULL);
+
+	vTaskStartScheduler();
+
+	return 0;
+}
@@ -0,0 +1,249 @@
+/**
+ * @file stream_buffer.c
+ * @brief Throughput of byte streams through queues, stream and message buffers
+ *
+ * Bursts of 200 bytes, the most the UDP signal handler reads at once, are
+ * passed through a queue of bytes one call per byte, through the same queue
+ * with xQueueSendMultiple()/xQueueReceiveMultiple(), through a stream buffer
+ * and, a burst per message, through a message buffer. Each is timed with the
+ * reader and writer in the same task, with a simulated interrupt as the writer
+ * and with a higher priority reader that blocks until data arrives, as the
+ * serial print task does. Every byte received is checked against the order in
+ * which it was sent.
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "stream_buffer.h"
+#include "message_buffer.h"
+
+#include "bench.h"
+
+#define STREAM_BURST 200
+/* Not a multiple of the burst, so bursts wrap around the end of the ring */
+#define STREAM_CAPACITY 256
+#define STREAM_BURSTS 20000
+#define STREAM_IRQ_BURSTS 5000
+#define STREAM_BLOCKING_BYTES (200UL * 1000)
+#define STREAM_IRQ 0
+#define WRITER_PRIORITY (tskIDLE_PRIORITY + 1)
+
+struct path {
+	const char *name;
+	void (*send)(const uint8_t *bytes, size_t count);
+	void (*send_from_isr)(const uint8_t *bytes, size_t count,
+			      BaseType_t *woken);
+	size_t (*receive)(uint8_t *bytes, size_t count, TickType_t ticks);
+};
+
+static QueueHandle_t Bytes;
+static StreamBufferHandle_t Stream;
+static MessageBufferHandle_t Messages;
+static const struct path *Path;
+static uint8_t Burst[STREAM_BURST];
+static unsigned long Position, Errors;
+
+static void vQueueSingleSend(const uint8_t *bytes, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+		xQueueSend(Bytes, &bytes[i], portMAX_DELAY);
+}
+
+static void vQueueSingleSendFromIsr(const uint8_t *bytes, size_t count,
+				    BaseType_t *woken)
+{
+	for (size_t i = 0; i < count; i++)
+		xQueueSendFromISR(Bytes, &bytes[i], woken);
+}
+
+static size_t xQueueSingleReceive(uint8_t *bytes, size_t count,
+				  TickType_t ticks)
+{
+	return xQueueReceive(Bytes, bytes, ticks) == pdTRUE;
+}
+
+static void vQueueMultipleSend(const uint8_t *bytes, size_t count)
+{
+	xQueueSendMultiple(Bytes, bytes, count, portMAX_DELAY);
+}
+
+static void vQueueMultipleSendFromIsr(const uint8_t *bytes, size_t count,
+				      BaseType_t *woken)
+{
+	xQueueSendMultipleFromISR(Bytes, bytes, count, woken);
+}
+
+static size_t xQueueMultipleReceive(uint8_t *bytes, size_t count,
+				    TickType_t ticks)
+{
+	return xQueueReceiveMultiple(Bytes, bytes, count, ticks);
+}
+
+static void vStreamSend(const uint8_t *bytes, size_t count)
+{
+	xStreamBufferSend(Stream, bytes, count, portMAX_DELAY);
+}
+
+static void vStreamSendFromIsr(const uint8_t *bytes, size_t count,
+			       BaseType_t *woken)
+{
+	xStreamBufferSendFromISR(Stream, bytes, count, woken);
+}
+
+static size_t xStreamReceive(uint8_t *bytes, size_t count, TickType_t ticks)
+{
+	return xStreamBufferReceive(Stream, bytes, count, ticks);
+}
+
+static void vMessageSend(const uint8_t *bytes, size_t count)
+{
+	xMessageBufferSend(Messages, bytes, count, portMAX_DELAY);
+}
+
+static void vMessageSendFromIsr(const uint8_t *bytes, size_t count,
+				BaseType_t *woken)
+{
+	xMessageBufferSendFromISR(Messages, bytes, count, woken);
+}
+
+static size_t xMessageReceive(uint8_t *bytes, size_t count, TickType_t ticks)
+{
+	return xMessageBufferReceive(Messages, bytes, count, ticks);
+}
+
+static const struct path Paths[] = {
+	{ "queue_single", vQueueSingleSend, vQueueSingleSendFromIsr,
+	  xQueueSingleReceive },
+	{ "queue_multiple", vQueueMultipleSend, vQueueMultipleSendFromIsr,
+	  xQueueMultipleReceive },
+	{ "stream", vStreamSend, vStreamSendFromIsr, xStreamReceive },
+	{ "message", vMessageSend, vMessageSendFromIsr, xMessageReceive },
+};
+
+/* Checks the bytes continue the stream where the last ones left off */
+static size_t xCheck(const uint8_t *bytes, size_t count)
+{
+	for (size_t i = 0; i < count; i++)
+		if (bytes[i] != Burst[Position++ % STREAM_BURST])
+			Errors++;
+	return count;
+}
+
+static void vReport(const char *scenario, uint64_t ns, unsigned long bytes)
+{
+	char metric[64];
+
+	snprintf(metric, sizeof(metric), "%s_%s", Path->name, scenario);
+	vBenchReport(metric, (double)ns / bytes, "ns/byte");
+}
+
+static void vIrqSend(void *pvParameter)
+{
+	BaseType_t woken = pdFALSE;
+
+	Path->send_from_isr(Burst, STREAM_BURST, &woken);
+	portEND_SWITCHING_ISR(woken);
+}
+
+static void vSameTask(void)
+{
+	uint8_t rx[STREAM_BURST];
+	size_t got;
+	uint64_t ns;
+
+	ns = ullBenchWallNs();
+	for (unsigned int n = 0; n < STREAM_BURSTS; n++) {
+		Path->send(Burst, STREAM_BURST);
+		for (got = 0; got < STREAM_BURST;)
+			got += xCheck(rx, Path->receive(rx, sizeof(rx), 0));
+	}
+	vReport("same_task", ullBenchWallNs() - ns,
+		(unsigned long)STREAM_BURSTS * STREAM_BURST);
+}
+
+static void vFromIsr(void)
+{
+	xPortIrqStats before, after;
+	uint8_t rx[STREAM_BURST];
+	char metric[64];
+	size_t got;
+
+	vPortGetIrqStats(STREAM_IRQ, &before);
+	for (unsigned int n = 0; n < STREAM_IRQ_BURSTS; n++) {
+		/* Raised from a task, the handler runs before this returns */
+		vPortRaiseIrq(STREAM_IRQ);
+		for (got = 0; got < STREAM_BURST;)
+			got += xCheck(rx, Path->receive(rx, sizeof(rx),
+							portMAX_DELAY));
+	}
+	vPortGetIrqStats(STREAM_IRQ, &after);
+
+	snprintf(metric, sizeof(metric), "%s_isr_handler", Path->name);
+	vBenchReport(metric,
+		     (double)(after.ullDurationNs - before.ullDurationNs) /
+			     STREAM_IRQ_BURSTS / STREAM_BURST,
+		     "ns/byte");
+}
+
+static void vWriter(void *pvParameters)
+{
+	for (unsigned long sent = 0; sent < STREAM_BLOCKING_BYTES;
+	     sent += STREAM_BURST)
+		Path->send(Burst, STREAM_BURST);
+
+	vTaskDelete(NULL);
+}
+
+/* The reader runs above the writer and blocks whenever it has drained it all */
+static void vBlockingReader(void)
+{
+	uint8_t rx[STREAM_BURST];
+	unsigned long got = 0;
+	uint64_t ns;
+
+	ns = ullBenchWallNs();
+	xTaskCreate(vWriter, "Writer", benchSTACK_SIZE, NULL, WRITER_PRIORITY,
+		    NULL);
+	while (got < STREAM_BLOCKING_BYTES)
+		got += xCheck(rx, Path->receive(rx, sizeof(rx), portMAX_DELAY));
+	vReport("blocking", ullBenchWallNs() - ns, STREAM_BLOCKING_BYTES);
+
+	/* Let the writer delete itself before the next path starts */
+	vTaskDelay(1);
+}
+
+static void vControlTask(void *pvParameters)
+{
+	for (unsigned int i = 0; i < STREAM_BURST; i++)
+		Burst[i] = (uint8_t)(i * 7);
+
+	Bytes = xQueueCreate(STREAM_CAPACITY, sizeof(uint8_t));
+	Stream = xStreamBufferCreate(STREAM_CAPACITY, 1);
+	Messages = xMessageBufferCreate(STREAM_CAPACITY);
+
+	xPortInstallIrqHandler(STREAM_IRQ, configMAX_SYSCALL_INTERRUPT_PRIORITY,
+			       vIrqSend, NULL);
+
+	for (unsigned int i = 0; i < sizeof(Paths) / sizeof(Paths[0]); i++) {
+		Path = &Paths[i];
+		vSameTask();
+		vFromIsr();
+		vBlockingReader();
+	}
+
+	vBenchReport("errors", Errors, "bytes");
+	vBenchFinish();
+}
+
+int main(int argc, char *argv[])
+{
+	xTaskCreate(vControlTask, "Control", benchSTACK_SIZE, NULL,
+		    benchCONTROL_PRIORITY, NULL);
+
+	vTaskStartScheduler();
+
+	return 0;
+}
@@ -0,0 +1,86 @@
+/**
+ * @file task_churn.c
+ * @brief Throughput of creating and deleting short-lived tasks
+ *
+ * Built as FreeRTOS_Bench_Churn_Pooled, where the threads of deleted tasks are
+ * parked and handed to the next task, FreeRTOS_Bench_Churn_Unpooled, where
+ * every task gets a new thread, and FreeRTOS_Bench_Churn_Signal, pooled with
+ * the signal based task switch.
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "bench.h"
+
+#define CHURN_TASKS 2000
+#define CHURN_STACK_DEPTH 1024
+
+static volatile unsigned int Runs;
+
+static void vIdleWorker(void *pvParameters)
+{
+	for (;;)
+		vTaskSuspend(NULL);
+}
+
+static void vShortWorker(void *pvParameters)
+{
+	Runs++;
+	vTaskDelete(NULL);
+}
+
+static void vReport(const char *name, uint64_t wall, uint64_t cpu)
+{
+	char metric[64];
+
+	vBenchReport(name, CHURN_TASKS * 1e9 / wall, "tasks/s");
+	snprintf(metric, sizeof(metric), "%s_host_cpu", name);
+	vBenchReport(metric, (double)cpu / CHURN_TASKS / 1000.0, "us/task");
+}
+
+static void vControlTask(void *pvParameters)
+{
+	TaskHandle_t task;
+	uint64_t wall, cpu;
+
+	/* Created and deleted by this task without ever running */
+	wall = ullBenchWallNs();
+	cpu = ullBenchCpuNs();
+	for (unsigned int i = 0; i < CHURN_TASKS; i++) {
+		xTaskCreate(vIdleWorker, "Idle", CHURN_STACK_DEPTH, NULL,
+			    tskIDLE_PRIORITY + 1, &task);
+		vTaskDelete(task);
+	}
+	vReport("create_delete", ullBenchWallNs() - wall,
+		ullBenchCpuNs() - cpu);
+
+	/*
+	 * Workers that run once and delete themselves. This task drops to the
+	 * idle priority so that the idle task cleans up after every worker.
+	 */
+	vTaskPrioritySet(NULL, tskIDLE_PRIORITY);
+	wall = ullBenchWallNs();
+	cpu = ullBenchCpuNs();
+	for (unsigned int i = 0; i < CHURN_TASKS; i++) {
+		xTaskCreate(vShortWorker, "Short", CHURN_STACK_DEPTH, NULL,
+			    tskIDLE_PRIORITY + 1, NULL);
+		taskYIELD();
+	}
+	vReport("spawn_exit", ullBenchWallNs() - wall, ullBenchCpuNs() - cpu);
+	vBenchReport("spawn_exit_runs", Runs, "tasks");
+
+	vBenchFinish();
+}
+
+int main(int argc, char *argv[])
+{
+	xTaskCreate(vControlTask, "Control", benchSTACK_SIZE, NULL,
+		    benchCONTROL_PRIORITY, NULL);
+
+	vTaskStartScheduler();
+
+	return 0;
+}
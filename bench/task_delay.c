@@ -0,0 +1,171 @@
+/**
+ * @file task_delay.c
+ * @brief Cost of delaying a task and of the tick as the number of sleeping
+ * tasks grows
+ *
+ * 10 to 2000 tasks each wake on a period of their own, of 50 to 999 ticks,
+ * with vTaskDelayUntil(), as vSwapBuffers() and vDemoTask2 in src/main.c do.
+ * Among them the highest priority task blocks for 50 to 999 ticks and is
+ * unblocked again with the scheduler suspended, the way a queue blocks and
+ * wakes a task, so no switch is timed. The tick handler is then called
+ * directly, as in tick_scaling.c, waking the sleeping tasks that are due.
+ * Built as FreeRTOS_Bench_Delay_List, with the delayed tasks in sorted lists,
+ * and FreeRTOS_Bench_Delay_Wheel, with configUSE_DELAYED_TASK_WHEEL. Every wake
+ * up is checked against the tick on which it was due.
+ */
+
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "FreeRTOS.h"
+#include "list.h"
+#include "task.h"
+
+#include "bench.h"
+
+/*
+ * Short bursts, so few sleeping tasks are due before the burst ends. The
+ * slowest 2% of the bursts are left out, as a burst the host preempts would
+ * outweigh the rest.
+ */
+#define DELAY_BURSTS 200
+#define DELAY_BURST_LENGTH 50
+#define TICK_BURSTS 200
+#define TICK_BURST_LENGTH 10
+#define SLEEPER_PRIORITY (tskIDLE_PRIORITY + 1)
+#define SLEEPER_STACK_SIZE ((unsigned short)configMINIMAL_STACK_SIZE)
+#define SLEEPER_PERIOD(i) ((TickType_t)(50 + ((i)*7919) % 950))
+
+extern void vPortSystemTickHandler(int sig);
+
+static const unsigned int TaskCounts[] = { 10, 100, 1000, 2000 };
+
+static List_t NeverSignalled;
+static volatile unsigned long Errors;
+static uint64_t Bursts[DELAY_BURSTS > TICK_BURSTS ? DELAY_BURSTS : TICK_BURSTS];
+
+static int iCompare(const void *a, const void *b)
+{
+	const uint64_t *x = a, *y = b;
+
+	return (*x > *y) - (*x < *y);
+}
+
+static double dBurstMean(unsigned int bursts)
+{
+	unsigned int kept = bursts - bursts / 50;
+	uint64_t sum = 0;
+
+	qsort(Bursts, bursts, sizeof(Bursts[0]), iCompare);
+	for (unsigned int i = 0; i < kept; i++)
+		sum += Bursts[i];
+	return (double)sum / kept;
+}
+
+static void vSleeper(void *pvParameters)
+{
+	const TickType_t period = (TickType_t)(uintptr_t)pvParameters;
+	TickType_t last_wake = xTaskGetTickCount();
+
+	for (;;) {
+		/* Leaves last_wake at the tick the task was due to wake on */
+		vTaskDelayUntil(&last_wake, period);
+
+		if ((TickType_t)(xTaskGetTickCount() - last_wake) >
+		    portMAX_DELAY / 2)
+			Errors++;
+	}
+}
+
+/*
+ * Blocks this task on a list nobody signals and takes it off again before the
+ * scheduler is resumed, so it is put in the delayed lists and taken out of
+ * them without ever being switched out.
+ */
+static void vMeasureDelay(unsigned int tasks)
+{
+	uint64_t start;
+	unsigned long n = 0;
+	char metric[64];
+
+	for (unsigned int burst = 0; burst < DELAY_BURSTS; burst++) {
+		start = ullBenchWallNs();
+		for (unsigned int i = 0; i < DELAY_BURST_LENGTH; i++, n++) {
+			vTaskSuspendAll();
+			vTaskPlaceOnEventList(&NeverSignalled,
+					      SLEEPER_PERIOD(n));
+			taskENTER_CRITICAL();
+			xTaskRemoveFromEventList(&NeverSignalled);
+			taskEXIT_CRITICAL();
+			xTaskResumeAll();
+		}
+		Bursts[burst] = ullBenchWallNs() - start;
+
+		/* Let the sleeping tasks that became due run */
+		vTaskDelay(1);
+	}
+
+	snprintf(metric, sizeof(metric), "delay_%u_tasks", tasks);
+	vBenchReport(metric, dBurstMean(DELAY_BURSTS) / DELAY_BURST_LENGTH,
+		     "ns/delay");
+}
+
+static void vMeasureTick(unsigned int tasks)
+{
+	uint64_t start;
+	char metric[64];
+
+	for (unsigned int burst = 0; burst < TICK_BURSTS; burst++) {
+		start = ullBenchWallNs();
+		for (unsigned int i = 0; i < TICK_BURST_LENGTH; i++) {
+			vPortPendTicks(1);
+			vPortSystemTickHandler(SIG_TICK);
+		}
+		Bursts[burst] = ullBenchWallNs() - start;
+
+		/* The woken tasks run and delay again */
+		vTaskDelay(pdMS_TO_TICKS(10));
+	}
+
+	snprintf(metric, sizeof(metric), "tick_%u_tasks", tasks);
+	vBenchReport(metric, dBurstMean(TICK_BURSTS) / TICK_BURST_LENGTH,
+		     "ns/tick");
+}
+
+static void vControlTask(void *pvParameters)
+{
+	unsigned int created = 0;
+
+	vListInitialise(&NeverSignalled);
+
+	for (unsigned int i = 0; i < sizeof(TaskCounts) / sizeof(TaskCounts[0]);
+	     i++) {
+		for (; created < TaskCounts[i]; created++)
+			if (xTaskCreate(vSleeper, "Sleeper", SLEEPER_STACK_SIZE,
+					(void *)(uintptr_t)SLEEPER_PERIOD(created),
+					SLEEPER_PRIORITY, NULL) != pdPASS) {
+				printf("Could not create task %u\n", created);
+				vBenchFinish();
+			}
+
+		/* Let the new tasks reach their first delay */
+		vTaskDelay(pdMS_TO_TICKS(100));
+
+		vMeasureDelay(created);
+		vMeasureTick(created);
+	}
+
+	vBenchReport("errors", Errors, "early wake ups");
+	vBenchFinish();
+}
+
+int main(int argc, char *argv[])
+{
+	xTaskCreate(vControlTask, "Control", benchSTACK_SIZE, NULL,
+		    benchCONTROL_PRIORITY, NULL);
+
+	vTaskStartScheduler();
+
+	return 0;
+}
@@ -0,0 +1,98 @@
+/**
+ * @file task_memory.c
+ * @brief Host memory used by and creation cost of a large set of tasks
+ *
+ * Built as FreeRTOS_Bench_Memory_Sized, where task threads get stacks sized
+ * from the tasks' stack depth, and FreeRTOS_Bench_Memory_Default, where they
+ * get the host's default stack size next to an unused stack from the FreeRTOS
+ * heap.
+ */
+
+#include <stdio.h>
+#include <unistd.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "bench.h"
+
+#define MEMORY_TASKS 500
+#define MEMORY_STACK_DEPTH 1024
+#define WORKER_PRIORITY (tskIDLE_PRIORITY + 1)
+
+static TaskHandle_t Tasks[MEMORY_TASKS];
+
+struct memory {
+	double vm_kib;
+	double rss_kib;
+};
+
+static void vReadMemory(struct memory *m)
+{
+	unsigned long size = 0, resident = 0;
+	double page_kib = sysconf(_SC_PAGESIZE) / 1024.0;
+	FILE *statm = fopen("/proc/self/statm", "r");
+
+	if (statm) {
+		if (fscanf(statm, "%lu %lu", &size, &resident) != 2)
+			size = resident = 0;
+		fclose(statm);
+	}
+
+	m->vm_kib = size * page_kib;
+	m->rss_kib = resident * page_kib;
+}
+
+static void vWorker(void *pvParameters)
+{
+	/* Use a little stack, as any task would */
+	volatile char buffer[256];
+
+	snprintf((char *)buffer, sizeof(buffer), "%p", pvParameters);
+	vTaskSuspend(NULL);
+}
+
+static void vControlTask(void *pvParameters)
+{
+	struct memory before, created, ran;
+	uint64_t ns;
+
+	vReadMemory(&before);
+
+	ns = ullBenchWallNs();
+	for (unsigned int i = 0; i < MEMORY_TASKS; i++)
+		xTaskCreate(vWorker, "Worker", MEMORY_STACK_DEPTH, NULL,
+			    WORKER_PRIORITY, &Tasks[i]);
+	ns = ullBenchWallNs() - ns;
+	vReadMemory(&created);
+	vBenchReport("create", (double)ns / MEMORY_TASKS / 1000.0, "us/task");
+
+	/* Every worker runs once and suspends itself */
+	vTaskDelay(pdMS_TO_TICKS(500));
+	vReadMemory(&ran);
+
+	vBenchReport("vm_per_task", (created.vm_kib - before.vm_kib) /
+		     MEMORY_TASKS, "KiB");
+	vBenchReport("rss_per_task_created",
+		     (created.rss_kib - before.rss_kib) / MEMORY_TASKS, "KiB");
+	vBenchReport("rss_per_task_ran",
+		     (ran.rss_kib - before.rss_kib) / MEMORY_TASKS, "KiB");
+
+	ns = ullBenchWallNs();
+	for (unsigned int i = 0; i < MEMORY_TASKS; i++)
+		vTaskDelete(Tasks[i]);
+	ns = ullBenchWallNs() - ns;
+	vBenchReport("delete", (double)ns / MEMORY_TASKS / 1000.0, "us/task");
+
+	vBenchFinish();
+}
+
+int main(int argc, char *argv[])
+{
+	xTaskCreate(vControlTask, "Control", benchSTACK_SIZE, NULL,
+		    benchCONTROL_PRIORITY, NULL);
+
+	vTaskStartScheduler();
+
+	return 0;
+}
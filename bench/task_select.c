@@ -0,0 +1,81 @@
+/**
+ * @file task_select.c
+ * @brief Cost of selecting the highest priority ready task
+ *
+ * The only tasks that are ready run at the top and at the bottom of the
+ * priority range, so every time the top one blocks or drops its priority the
+ * scheduler has to find the bottom one. The generic selection walks the empty
+ * ready lists in between, the port optimised one reads the ready priority bit
+ * map. Built as FreeRTOS_Bench_Select_Generic_<n> and
+ * FreeRTOS_Bench_Select_Port_<n> for configMAX_PRIORITIES of 10, 32 and 256.
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "bench.h"
+
+#define SELECT_PRIORITY_PAIRS 200000
+#define SELECT_ROUND_TRIPS 20000
+#define LOW_PRIORITY (tskIDLE_PRIORITY + 1)
+#define HIGH_PRIORITY (configMAX_PRIORITIES - 1)
+
+static TaskHandle_t Control;
+
+static void vHighWorker(void *pvParameters)
+{
+	for (;;) {
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+		xTaskNotifyGive(Control);
+	}
+}
+
+static void vControlTask(void *pvParameters)
+{
+	TaskHandle_t high;
+	uint64_t ns;
+
+	Control = xTaskGetCurrentTaskHandle();
+	vBenchReport("priorities", configMAX_PRIORITIES, "levels");
+
+	/*
+	 * Raising its own priority does not switch, dropping it again yields
+	 * and the scheduler selects this task from the bottom of the range.
+	 */
+	vTaskPrioritySet(NULL, LOW_PRIORITY);
+	ns = ullBenchWallNs();
+	for (unsigned int i = 0; i < SELECT_PRIORITY_PAIRS; i++) {
+		vTaskPrioritySet(NULL, HIGH_PRIORITY);
+		vTaskPrioritySet(NULL, LOW_PRIORITY);
+	}
+	ns = ullBenchWallNs() - ns;
+	vBenchReport("priority_raise_drop", (double)ns / SELECT_PRIORITY_PAIRS,
+		     "ns");
+
+	/* A real switch to the top of the range and back */
+	xTaskCreate(vHighWorker, "High", benchSTACK_SIZE, NULL, HIGH_PRIORITY,
+		    &high);
+	ns = ullBenchWallNs();
+	for (unsigned int i = 0; i < SELECT_ROUND_TRIPS; i++) {
+		xTaskNotifyGive(high);
+		ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+	}
+	ns = ullBenchWallNs() - ns;
+	vBenchReport("notify_round_trip", (double)ns / SELECT_ROUND_TRIPS,
+		     "ns");
+
+	vTaskDelete(high);
+	vBenchFinish();
+}
+
+int main(int argc, char *argv[])
+{
+	xTaskCreate(vControlTask, "Control", benchSTACK_SIZE, NULL,
+		    benchCONTROL_PRIORITY, NULL);
+
+	vTaskStartScheduler();
+
+	return 0;
+}
@@ -0,0 +1,393 @@
+/**
+ * @file thread_metric.c
+ * @brief Thread-Metric style RTOS micro-benchmarks for the kernel and port
+ *
+ * Every test starts its tasks below the controlling task, lets them run for
+ * one measurement period and reports how many iterations they got through per
+ * second of host time, so bigger is better. The tests follow Thread-Metric's
+ * set: basic processing as a reference for the host's speed, cooperative and
+ * preemptive scheduling, interrupt processing and preemption, message
+ * passing, synchronisation and memory allocation.
+ */
+
+#include <signal.h>
+#include <stdio.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "queue.h"
+#include "semphr.h"
+#include "task.h"
+
+#include "bench.h"
+
+#ifndef benchPERIOD_MS
+#define benchPERIOD_MS 1000
+#endif
+
+#define TM_TASKS 5
+#define TM_PRIORITY (tskIDLE_PRIORITY + 1)
+#define TM_MESSAGE_WORDS 4
+#define TM_QUEUE_LENGTH 10
+#define TM_BLOCK_SIZE 128
+#define TM_CHURN_SLOTS 32
+
+/* Simulated interrupt line, raised by the tasks on their own thread */
+#define SIG_TM_IRQ (SIGRTMIN + 1)
+
+static volatile unsigned long Counters[TM_TASKS];
+static TaskHandle_t Tasks[TM_TASKS];
+static unsigned int TaskCount;
+
+static QueueHandle_t Queues[2];
+static SemaphoreHandle_t Semaphores[2];
+static void (*volatile IrqHandler)(void) = NULL;
+
+static void vStartTask(TaskFunction_t code, UBaseType_t priority,
+		       unsigned int index)
+{
+	xTaskCreate(code, "TM", benchSTACK_SIZE, (void *)(uintptr_t)index,
+		    priority, &Tasks[TaskCount++]);
+}
+
+static unsigned int uxIndex(void *pvParameters)
+{
+	return (unsigned int)(uintptr_t)pvParameters;
+}
+
+static void vIrqSignalHandler(int sig)
+{
+	if (IrqHandler)
+		IrqHandler();
+}
+
+/* Basic processing */
+
+static void vBasicTask(void *pvParameters)
+{
+	volatile unsigned long work[16];
+
+	for (;;) {
+		for (unsigned int i = 0; i < 16; i++)
+			work[i] = (work[i] ^ i) * 7 + 1;
+		Counters[0]++;
+	}
+}
+
+static void vBasicSetup(void)
+{
+	vStartTask(vBasicTask, TM_PRIORITY, 0);
+}
+
+/* Cooperative scheduling */
+
+static void vCooperativeTask(void *pvParameters)
+{
+	unsigned int index = uxIndex(pvParameters);
+
+	for (;;) {
+		Counters[index]++;
+		taskYIELD();
+	}
+}
+
+static void vCooperativeSetup(void)
+{
+	for (unsigned int i = 0; i < TM_TASKS; i++)
+		vStartTask(vCooperativeTask, TM_PRIORITY, i);
+}
+
+/* Preemptive scheduling, each task resumes the next higher priority one */
+
+static void vPreemptiveTask(void *pvParameters)
+{
+	unsigned int index = uxIndex(pvParameters);
+
+	for (;;) {
+		if (index)
+			vTaskSuspend(NULL);
+		Counters[index]++;
+		if (index < TM_TASKS - 1)
+			vTaskResume(Tasks[index + 1]);
+	}
+}
+
+static void vPreemptiveSetup(void)
+{
+	for (unsigned int i = 0; i < TM_TASKS; i++)
+		vStartTask(vPreemptiveTask, TM_PRIORITY + i, i);
+}
+
+/* Interrupt processing, the interrupt gives a semaphore the task takes */
+
+static void vIrqGiveSemaphore(void)
+{
+	BaseType_t woken = pdFALSE;
+
+	xSemaphoreGiveFromISR(Semaphores[0], &woken);
+	portEND_SWITCHING_ISR(woken);
+}
+
+static void vInterruptTask(void *pvParameters)
+{
+	for (;;) {
+		raise(SIG_TM_IRQ);
+		if (xSemaphoreTake(Semaphores[0], 0) == pdTRUE)
+			Counters[0]++;
+	}
+}
+
+static void vInterruptSetup(void)
+{
+	Semaphores[0] = xSemaphoreCreateBinary();
+	IrqHandler = vIrqGiveSemaphore;
+	vStartTask(vInterruptTask, TM_PRIORITY, 0);
+}
+
+/* Interrupt preemption, the interrupt resumes a higher priority task */
+
+static void vIrqResumeTask(void)
+{
+	portEND_SWITCHING_ISR(xTaskResumeFromISR(Tasks[1]));
+}
+
+static void vInterruptedTask(void *pvParameters)
+{
+	for (;;)
+		raise(SIG_TM_IRQ);
+}
+
+static void vPreemptingTask(void *pvParameters)
+{
+	for (;;) {
+		vTaskSuspend(NULL);
+		Counters[1]++;
+	}
+}
+
+static void vInterruptPreemptionSetup(void)
+{
+	vStartTask(vInterruptedTask, TM_PRIORITY, 0);
+	vStartTask(vPreemptingTask, TM_PRIORITY + 1, 1);
+	IrqHandler = vIrqResumeTask;
+}
+
+/* Message processing, one task sends a message to itself */
+
+static void vMessageTask(void *pvParameters)
+{
+	uint32_t message[TM_MESSAGE_WORDS] = { 1, 2, 3, 4 };
+
+	for (;;) {
+		xQueueSend(Queues[0], message, 0);
+		xQueueReceive(Queues[0], message, 0);
+		Counters[0]++;
+	}
+}
+
+static void vMessageSetup(void)
+{
+	Queues[0] = xQueueCreate(TM_QUEUE_LENGTH, sizeof(uint32_t[TM_MESSAGE_WORDS]));
+	vStartTask(vMessageTask, TM_PRIORITY, 0);
+}
+
+/* Message ping-pong, a message goes back and forth between two tasks */
+
+static void vMessagePingPongTask(void *pvParameters)
+{
+	unsigned int index = uxIndex(pvParameters);
+	uint32_t message[TM_MESSAGE_WORDS] = { 1, 2, 3, 4 };
+
+	for (;;) {
+		if (index == 0)
+			xQueueSend(Queues[0], message, portMAX_DELAY);
+		xQueueReceive(Queues[!index], message, portMAX_DELAY);
+		if (index == 1)
+			xQueueSend(Queues[1], message, portMAX_DELAY);
+		Counters[index]++;
+	}
+}
+
+static void vMessagePingPongSetup(void)
+{
+	Queues[0] = xQueueCreate(1, sizeof(uint32_t[TM_MESSAGE_WORDS]));
+	Queues[1] = xQueueCreate(1, sizeof(uint32_t[TM_MESSAGE_WORDS]));
+	vStartTask(vMessagePingPongTask, TM_PRIORITY, 0);
+	vStartTask(vMessagePingPongTask, TM_PRIORITY, 1);
+}
+
+/* Synchronisation processing, one task takes and gives a semaphore */
+
+static void vSemaphoreTask(void *pvParameters)
+{
+	for (;;) {
+		xSemaphoreTake(Semaphores[0], 0);
+		xSemaphoreGive(Semaphores[0]);
+		Counters[0]++;
+	}
+}
+
+static void vSemaphoreSetup(void)
+{
+	Semaphores[0] = xSemaphoreCreateBinary();
+	xSemaphoreGive(Semaphores[0]);
+	vStartTask(vSemaphoreTask, TM_PRIORITY, 0);
+}
+
+/* Semaphore ping-pong, two tasks wake each other */
+
+static void vSemaphorePingPongTask(void *pvParameters)
+{
+	unsigned int index = uxIndex(pvParameters);
+
+	for (;;) {
+		if (index == 0)
+			xSemaphoreGive(Semaphores[0]);
+		xSemaphoreTake(Semaphores[!index], portMAX_DELAY);
+		if (index == 1)
+			xSemaphoreGive(Semaphores[1]);
+		Counters[index]++;
+	}
+}
+
+static void vSemaphorePingPongSetup(void)
+{
+	Semaphores[0] = xSemaphoreCreateBinary();
+	Semaphores[1] = xSemaphoreCreateBinary();
+	vStartTask(vSemaphorePingPongTask, TM_PRIORITY, 0);
+	vStartTask(vSemaphorePingPongTask, TM_PRIORITY, 1);
+}
+
+/* Mutex ping-pong, two tasks block on a mutex the other one holds */
+
+static void vMutexPingPongTask(void *pvParameters)
+{
+	unsigned int index = uxIndex(pvParameters);
+
+	for (;;) {
+		xSemaphoreTake(Semaphores[0], portMAX_DELAY);
+		taskYIELD();
+		Counters[index]++;
+		xSemaphoreGive(Semaphores[0]);
+		taskYIELD();
+	}
+}
+
+static void vMutexPingPongSetup(void)
+{
+	Semaphores[0] = xSemaphoreCreateMutex();
+	vStartTask(vMutexPingPongTask, TM_PRIORITY, 0);
+	vStartTask(vMutexPingPongTask, TM_PRIORITY, 1);
+}
+
+/* Memory allocation, a fixed size block is allocated and freed */
+
+static void vMemoryTask(void *pvParameters)
+{
+	for (;;) {
+		vPortFree(pvPortMalloc(TM_BLOCK_SIZE));
+		Counters[0]++;
+	}
+}
+
+static void vMemorySetup(void)
+{
+	vStartTask(vMemoryTask, TM_PRIORITY, 0);
+}
+
+/* Memory churn, blocks of mixed sizes are replaced in a window */
+
+static void vMemoryChurnTask(void *pvParameters)
+{
+	void *blocks[TM_CHURN_SLOTS] = { NULL };
+	uint32_t random = 12345;
+	unsigned int slot;
+
+	for (;;) {
+		random = random * 1103515245 + 12345;
+		slot = (random >> 8) % TM_CHURN_SLOTS;
+
+		vPortFree(blocks[slot]);
+		blocks[slot] = pvPortMalloc(16 + (random >> 16) % 1009);
+		Counters[0]++;
+	}
+}
+
+static void vMemoryChurnSetup(void)
+{
+	vStartTask(vMemoryChurnTask, TM_PRIORITY, 0);
+}
+
+static const struct {
+	const char *name;
+	void (*setup)(void);
+} Tests[] = {
+	{ "basic_processing", vBasicSetup },
+	{ "cooperative_scheduling", vCooperativeSetup },
+	{ "preemptive_scheduling", vPreemptiveSetup },
+	{ "interrupt_processing", vInterruptSetup },
+	{ "interrupt_preemption", vInterruptPreemptionSetup },
+	{ "message_processing", vMessageSetup },
+	{ "message_pingpong", vMessagePingPongSetup },
+	{ "semaphore_processing", vSemaphoreSetup },
+	{ "semaphore_pingpong", vSemaphorePingPongSetup },
+	{ "mutex_pingpong", vMutexPingPongSetup },
+	{ "memory_allocation", vMemorySetup },
+	{ "memory_churn", vMemoryChurnSetup },
+};
+
+static void vRunTest(const char *name, void (*setup)(void))
+{
+	unsigned long total = 0;
+	uint64_t wall;
+
+	memset((void *)Counters, 0, sizeof(Counters));
+	TaskCount = 0;
+
+	/* The tasks only start running once this task blocks */
+	setup();
+	wall = ullBenchWallNs();
+	vTaskDelay(pdMS_TO_TICKS(benchPERIOD_MS));
+	wall = ullBenchWallNs() - wall;
+
+	for (unsigned int i = 0; i < TM_TASKS; i++)
+		total += Counters[i];
+
+	IrqHandler = NULL;
+	for (unsigned int i = 0; i < TaskCount; i++)
+		vTaskDelete(Tasks[i]);
+	for (unsigned int i = 0; i < 2; i++) {
+		if (Queues[i])
+			vQueueDelete(Queues[i]);
+		if (Semaphores[i])
+			vSemaphoreDelete(Semaphores[i]);
+		Queues[i] = NULL;
+		Semaphores[i] = NULL;
+	}
+
+	vBenchReport(name, total * 1e9 / wall, "ops/s");
+}
+
+static void vControlTask(void *pvParameters)
+{
+	for (unsigned int i = 0; i < sizeof(Tests) / sizeof(Tests[0]); i++)
+		vRunTest(Tests[i].name, Tests[i].setup);
+
+	vBenchFinish();
+}
+
+int main(int argc, char *argv[])
+{
+	struct sigaction irq = { 0 };
+
+	irq.sa_handler = vIrqSignalHandler;
+	sigfillset(&irq.sa_mask);
+	sigaction(SIG_TM_IRQ, &irq, NULL);
+
+	xTaskCreate(vControlTask, "Control", benchSTACK_SIZE, NULL,
+		    benchCONTROL_PRIORITY, NULL);
+
+	vTaskStartScheduler();
+
+	return 0;
+}
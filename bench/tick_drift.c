@@ -0,0 +1,85 @@
+/**
+ * @file tick_drift.c
+ * @brief Emulated time against wall time under load at a high tick rate
+ *
+ * A low priority task keeps the host busy while another one repeatedly holds
+ * interrupts off for a few tick periods. Ticks that can't be delivered on time
+ * must be replayed later, so the tick count should still match the time that
+ * passed on the host.
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "bench.h"
+
+#define RUN_SECONDS 3
+#define CRITICAL_SECTION_NS (3ULL * 1000000000ULL / configTICK_RATE_HZ)
+
+static void vBusyWorker(void *pvParameters)
+{
+	for (;;)
+		;
+}
+
+static void vCriticalWorker(void *pvParameters)
+{
+	uint64_t until;
+
+	for (;;) {
+		taskENTER_CRITICAL();
+		until = ullBenchWallNs() + CRITICAL_SECTION_NS;
+		while (ullBenchWallNs() < until)
+			;
+		taskEXIT_CRITICAL();
+		vTaskDelay(10);
+	}
+}
+
+static void vControlTask(void *pvParameters)
+{
+	xPortTickStats stats;
+	TickType_t ticks;
+	uint64_t wall;
+	double expected;
+
+	/* Line up with a tick so that start and end are measured alike */
+	vTaskDelay(1);
+	ticks = xTaskGetTickCount();
+	wall = ullBenchWallNs();
+
+	vTaskDelay(RUN_SECONDS * configTICK_RATE_HZ);
+
+	ticks = xTaskGetTickCount() - ticks;
+	wall = ullBenchWallNs() - wall;
+	expected = (double)wall * configTICK_RATE_HZ / 1000000000.0;
+
+	vPortGetTickStats(&stats);
+
+	vBenchReport("tick_rate", configTICK_RATE_HZ, "Hz");
+	vBenchReport("ticks_expected", expected, "ticks");
+	vBenchReport("ticks_counted", ticks, "ticks");
+	vBenchReport("drift", (expected - ticks) * 1000.0 / configTICK_RATE_HZ,
+		     "ms");
+	vBenchReport("late_ticks", stats.ulLateTicks, "ticks");
+	vBenchReport("deferred_ticks", stats.ulDeferredTicks, "ticks");
+	vBenchReport("replayed_ticks", stats.ulReplayedTicks, "ticks");
+
+	vBenchFinish();
+}
+
+int main(int argc, char *argv[])
+{
+	xTaskCreate(vBusyWorker, "Busy", benchSTACK_SIZE, NULL,
+		    tskIDLE_PRIORITY + 1, NULL);
+	xTaskCreate(vCriticalWorker, "Critical", benchSTACK_SIZE, NULL,
+		    tskIDLE_PRIORITY + 2, NULL);
+	xTaskCreate(vControlTask, "Control", benchSTACK_SIZE, NULL,
+		    benchCONTROL_PRIORITY, NULL);
+
+	vTaskStartScheduler();
+
+	return 0;
+}
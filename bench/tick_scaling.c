@@ -0,0 +1,101 @@
+/**
+ * @file tick_scaling.c
+ * @brief Cost of the port's tick handler as the number of tasks grows
+ *
+ * The tick handler and every task switch look up the host thread of the
+ * outgoing and incoming task. This benchmark blocks an increasing number of
+ * idle tasks and times the tick handler and a yield to self with each
+ * population, which should stay flat if those lookups are O(1).
+ */
+
+#include <signal.h>
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "semphr.h"
+#include "task.h"
+
+#include "bench.h"
+
+#define TICK_ITERATIONS 100000
+#define YIELD_ITERATIONS 100000
+#define SLEEPER_PRIORITY (tskIDLE_PRIORITY + 1)
+#define SLEEPER_STACK_SIZE ((unsigned short)configMINIMAL_STACK_SIZE)
+
+extern void vPortSystemTickHandler(int sig);
+
+static const unsigned int TaskCounts[] = { 0, 100, 200, 400, 800 };
+
+static SemaphoreHandle_t NeverGiven = NULL;
+
+static void vSleeper(void *pvParameters)
+{
+	xSemaphoreTake(NeverGiven, portMAX_DELAY);
+	vTaskSuspend(NULL);
+}
+
+/*
+ * Calls the tick handler directly from the highest priority task, so no switch
+ * ever happens and only the per tick work of the port and kernel is timed.
+ */
+static void vMeasureTick(unsigned int tasks)
+{
+	uint64_t wall;
+	char metric[64];
+
+	/* Wait for the thread that switched to this task to finish suspending */
+	taskYIELD();
+
+	wall = ullBenchWallNs();
+	for (unsigned int i = 0; i < TICK_ITERATIONS; i++) {
+		vPortPendTicks(1);
+		vPortSystemTickHandler(SIG_TICK);
+	}
+	wall = ullBenchWallNs() - wall;
+
+	snprintf(metric, sizeof(metric), "tick_handler_%u_tasks", tasks);
+	vBenchReport(metric, (double)wall / TICK_ITERATIONS, "ns/tick");
+
+	wall = ullBenchWallNs();
+	for (unsigned int i = 0; i < YIELD_ITERATIONS; i++)
+		taskYIELD();
+	wall = ullBenchWallNs() - wall;
+
+	snprintf(metric, sizeof(metric), "yield_self_%u_tasks", tasks);
+	vBenchReport(metric, (double)wall / YIELD_ITERATIONS, "ns/yield");
+}
+
+static void vControlTask(void *pvParameters)
+{
+	unsigned int created = 0;
+
+	for (unsigned int i = 0; i < sizeof(TaskCounts) / sizeof(TaskCounts[0]);
+	     i++) {
+		for (; created < TaskCounts[i]; created++)
+			if (xTaskCreate(vSleeper, "Sleeper", SLEEPER_STACK_SIZE,
+					NULL, SLEEPER_PRIORITY,
+					NULL) != pdPASS) {
+				printf("Could not create task %u\n", created);
+				vBenchFinish();
+			}
+
+		/* Let the new tasks run once and block */
+		vTaskDelay(2);
+
+		vMeasureTick(created);
+	}
+
+	vBenchFinish();
+}
+
+int main(int argc, char *argv[])
+{
+	NeverGiven = xSemaphoreCreateBinary();
+
+	xTaskCreate(vControlTask, "Control", benchSTACK_SIZE, NULL,
+		    benchCONTROL_PRIORITY, NULL);
+
+	vTaskStartScheduler();
+
+	return 0;
+}
@@ -0,0 +1,90 @@
+/**
+ * @file tickless_idle.c
+ * @brief Host CPU use and timing accuracy of an otherwise idle emulator
+ *
+ * Built with and without configUSE_TICKLESS_IDLE. An idle emulator should not
+ * use the host's CPU, and sleeping through ticks must not make task wake ups
+ * late or let the tick count drift from wall time.
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "bench.h"
+
+#define IDLE_SECONDS 2
+#define PERIODIC_WAKE_UPS 200
+#define PERIODIC_PERIOD_MS 10
+
+static void vMeasureIdle(void)
+{
+	uint64_t wall = ullBenchWallNs();
+	uint64_t cpu = ullBenchCpuNs();
+	TickType_t ticks = xTaskGetTickCount();
+
+	vTaskDelay(pdMS_TO_TICKS(IDLE_SECONDS * 1000));
+
+	wall = ullBenchWallNs() - wall;
+	cpu = ullBenchCpuNs() - cpu;
+	ticks = xTaskGetTickCount() - ticks;
+
+	vBenchReport("idle_host_cpu", 100.0 * cpu / wall, "%cpu");
+	vBenchReport("idle_drift",
+		     (double)wall / 1000000.0 - ticks * portTICK_PERIOD_MS,
+		     "ms");
+}
+
+/*
+ * Wakes up every PERIODIC_PERIOD_MS like a typical control loop and measures
+ * how late each wake up is against the host clock.
+ */
+static void vMeasurePeriodic(void)
+{
+	TickType_t last_wake = xTaskGetTickCount();
+	uint64_t start = ullBenchWallNs();
+	uint64_t cpu = ullBenchCpuNs();
+	uint64_t late_total = 0, late_max = 0, due, now;
+
+	for (unsigned int i = 1; i <= PERIODIC_WAKE_UPS; i++) {
+		vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(PERIODIC_PERIOD_MS));
+
+		now = ullBenchWallNs();
+		due = start + (uint64_t)i * PERIODIC_PERIOD_MS * 1000000ULL;
+		if (now > due) {
+			late_total += now - due;
+			if (now - due > late_max)
+				late_max = now - due;
+		}
+	}
+
+	cpu = ullBenchCpuNs() - cpu;
+
+	vBenchReport("periodic_host_cpu",
+		     100.0 * cpu / (ullBenchWallNs() - start), "%cpu");
+	vBenchReport("periodic_late_mean",
+		     (double)late_total / PERIODIC_WAKE_UPS / 1000.0, "us");
+	vBenchReport("periodic_late_max", (double)late_max / 1000.0, "us");
+}
+
+static void vControlTask(void *pvParameters)
+{
+	/* Line up with a tick so that wall time and ticks start together */
+	vTaskDelay(1);
+
+	vMeasureIdle();
+	vMeasurePeriodic();
+
+	vBenchFinish();
+}
+
+int main(int argc, char *argv[])
+{
+	xTaskCreate(vControlTask, "Control", benchSTACK_SIZE, NULL,
+		    benchCONTROL_PRIORITY, NULL);
+
+	vTaskStartScheduler();
+
+	return 0;
+}
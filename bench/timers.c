@@ -0,0 +1,158 @@
+/**
+ * @file timers.c
+ * @brief Cost of the timer service with 10000 active timers
+ *
+ * 10000 auto-reload timers are started, reset at random, stopped and started
+ * again, and then left to expire about 7 times a tick. Each command is sent
+ * from a task below the timer service task, which handles it before the call
+ * returns, and is timed both on the wall clock and by the service task's run
+ * time. Built as FreeRTOS_Bench_Timers_List, with the active timers in sorted
+ * lists, and FreeRTOS_Bench_Timers_Wheel, with configUSE_TIMER_WHEEL. Every
+ * expiry is checked against the tick on which it was due, and every timer for
+ * an expiry it missed.
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+
+#include "bench.h"
+
+#define TIMERS 10000
+#define TIMER_RESETS 20000
+#define TIMER_EXPIRY_MS 2000
+/* Out of the way while the commands are timed */
+#define LONG_PERIOD(i) pdMS_TO_TICKS(5000 + ((i)*7919) % 5000)
+/* About 7 expiries every tick */
+#define SHORT_PERIOD(i) pdMS_TO_TICKS(1000 + ((i)*7919) % 1000)
+#define CONTROL_PRIORITY (tskIDLE_PRIORITY + 1)
+
+static TimerHandle_t Timers[TIMERS];
+static TickType_t Due[TIMERS];
+static unsigned long Expired, Errors;
+static TickType_t LateMax;
+
+static void vCallback(TimerHandle_t timer)
+{
+	uintptr_t i = (uintptr_t)pvTimerGetTimerID(timer);
+	TickType_t now = xTaskGetTickCount();
+
+	if ((TickType_t)(now - Due[i]) > portMAX_DELAY / 2)
+		Errors++;
+	else if (now - Due[i] > LateMax)
+		LateMax = now - Due[i];
+	Due[i] += xTimerGetPeriod(timer);
+	Expired++;
+}
+
+static uint64_t ullServiceNs(void)
+{
+	TaskStatus_t status;
+
+	vTaskGetInfo(xTimerGetTimerDaemonTaskHandle(), &status, pdFALSE,
+		     eInvalid);
+	return status.ulRunTimeCounter;
+}
+
+static void vReport(const char *name, uint64_t wall, uint64_t service,
+		    unsigned long commands)
+{
+	char metric[64];
+
+	snprintf(metric, sizeof(metric), "%s_call", name);
+	vBenchReport(metric, (double)wall / commands, "ns");
+	snprintf(metric, sizeof(metric), "%s_service", name);
+	vBenchReport(metric, (double)service / commands, "ns");
+}
+
+static void vCommands(void)
+{
+	uint64_t wall, service;
+	unsigned int i;
+
+	wall = ullBenchWallNs();
+	service = ullServiceNs();
+	for (i = 0; i < TIMERS; i++)
+		xTimerStart(Timers[i], portMAX_DELAY);
+	vReport("start", ullBenchWallNs() - wall, ullServiceNs() - service,
+		TIMERS);
+
+	wall = ullBenchWallNs();
+	service = ullServiceNs();
+	for (unsigned long n = 0; n < TIMER_RESETS; n++)
+		xTimerReset(Timers[(n * 7919) % TIMERS], portMAX_DELAY);
+	vReport("reset", ullBenchWallNs() - wall, ullServiceNs() - service,
+		TIMER_RESETS);
+
+	wall = ullBenchWallNs();
+	service = ullServiceNs();
+	for (i = 0; i < TIMERS; i++)
+		xTimerStop(Timers[i], portMAX_DELAY);
+	vReport("stop", ullBenchWallNs() - wall, ullServiceNs() - service,
+		TIMERS);
+}
+
+static void vExpiry(void)
+{
+	uint64_t service;
+	unsigned long expired;
+	TickType_t now;
+
+	/* Changing the period starts a stopped timer */
+	for (unsigned int i = 0; i < TIMERS; i++) {
+		xTimerChangePeriod(Timers[i], SHORT_PERIOD(i), portMAX_DELAY);
+		Due[i] = xTimerGetExpiryTime(Timers[i]);
+	}
+
+	Expired = 0;
+	service = ullServiceNs();
+	vTaskDelay(pdMS_TO_TICKS(TIMER_EXPIRY_MS));
+	service = ullServiceNs() - service;
+	expired = Expired;
+
+	for (unsigned int i = 0; i < TIMERS; i++)
+		xTimerStop(Timers[i], portMAX_DELAY);
+
+	/* A timer a whole period overdue has missed an expiry */
+	now = xTaskGetTickCount();
+	for (unsigned int i = 0; i < TIMERS; i++)
+		if ((TickType_t)(now - Due[i]) < portMAX_DELAY / 2 &&
+		    now - Due[i] > SHORT_PERIOD(i))
+			Errors++;
+
+	vBenchReport("expiries", expired * 1000.0 / TIMER_EXPIRY_MS,
+		     "per second");
+	vBenchReport("expiry_service", (double)service / (expired ? expired : 1),
+		     "ns");
+	vBenchReport("expiry_late_max", LateMax, "ticks");
+}
+
+static void vControlTask(void *pvParameters)
+{
+	vBenchReport("timers", TIMERS, "active");
+
+	for (uintptr_t i = 0; i < TIMERS; i++)
+		Timers[i] = xTimerCreate("Bench", LONG_PERIOD(i), pdTRUE,
+					 (void *)i, vCallback);
+
+	/* Each command is handled by the timer service as it is sent */
+	vTaskPrioritySet(NULL, CONTROL_PRIORITY);
+
+	vCommands();
+	vExpiry();
+
+	vBenchReport("errors", Errors, "early or missed expiries");
+	vBenchFinish();
+}
+
+int main(int argc, char *argv[])
+{
+	xTaskCreate(vControlTask, "Control", benchSTACK_SIZE, NULL,
+		    benchCONTROL_PRIORITY, NULL);
+
+	vTaskStartScheduler();
+
+	return 0;
+}
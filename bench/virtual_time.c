@@ -0,0 +1,95 @@
+/**
+ * @file virtual_time.c
+ * @brief How much emulated time passes per second of host time
+ *
+ * A physics task wakes every 10 ms like vDemoTask2 in src/main.c while a
+ * lower priority task occasionally has a little work to do. The variants run
+ * the same program in fast-forward and scaled time, see vPortSetTimeMode().
+ */
+
+#include <stdio.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#include "bench.h"
+
+#ifndef benchTIME_MODE
+#define benchTIME_MODE eFastForward
+#endif
+#ifndef benchTIME_SCALE
+#define benchTIME_SCALE 1
+#endif
+#ifndef benchSIMULATED_SECONDS
+#define benchSIMULATED_SECONDS 3600
+#endif
+
+#define PHYSICS_PERIOD_MS 10
+
+static TaskHandle_t ControlTask = NULL;
+static volatile unsigned long PhysicsSteps = 0;
+
+static void vPhysicsTask(void *pvParameters)
+{
+	const unsigned long steps = benchSIMULATED_SECONDS * 1000UL /
+				    PHYSICS_PERIOD_MS;
+	TickType_t last_wake = xTaskGetTickCount();
+	volatile float position = 0.0f, speed = 1.0f;
+
+	while (PhysicsSteps < steps) {
+		vTaskDelayUntil(&last_wake, pdMS_TO_TICKS(PHYSICS_PERIOD_MS));
+
+		speed -= 0.01f * position;
+		position += 0.01f * speed;
+		PhysicsSteps++;
+	}
+
+	xTaskNotifyGive(ControlTask);
+	vTaskSuspend(NULL);
+}
+
+static void vHousekeepingTask(void *pvParameters)
+{
+	for (;;)
+		vTaskDelay(pdMS_TO_TICKS(250));
+}
+
+static void vControlTask(void *pvParameters)
+{
+	uint64_t wall = ullBenchWallNs();
+	uint64_t cpu = ullBenchCpuNs();
+	TickType_t ticks = xTaskGetTickCount();
+	double simulated;
+
+	xTaskCreate(vPhysicsTask, "Physics", benchSTACK_SIZE, NULL,
+		    tskIDLE_PRIORITY + 2, NULL);
+	xTaskCreate(vHousekeepingTask, "Housekeeping", benchSTACK_SIZE, NULL,
+		    tskIDLE_PRIORITY + 1, NULL);
+
+	ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+	wall = ullBenchWallNs() - wall;
+	cpu = ullBenchCpuNs() - cpu;
+	ticks = xTaskGetTickCount() - ticks;
+	simulated = (double)ticks / configTICK_RATE_HZ;
+
+	vBenchReport("physics_steps", PhysicsSteps, "steps");
+	vBenchReport("simulated_time", simulated, "s");
+	vBenchReport("host_time", wall / 1e9, "s");
+	vBenchReport("speed_up", simulated / (wall / 1e9), "x");
+	vBenchReport("host_cpu", 100.0 * cpu / wall, "%cpu");
+
+	vBenchFinish();
+}
+
+int main(int argc, char *argv[])
+{
+	vPortSetTimeMode(benchTIME_MODE, benchTIME_SCALE);
+
+	xTaskCreate(vControlTask, "Control", benchSTACK_SIZE, NULL,
+		    benchCONTROL_PRIORITY, &ControlTask);
+
+	vTaskStartScheduler();
+
+	return 0;
+}
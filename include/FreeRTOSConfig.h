@@ -69,9 +69,26 @@
 #define configUSE_PREEMPTION			1
 #define configUSE_IDLE_HOOK				1
 #define configUSE_TICK_HOOK				0
+#ifndef configNUM_CORES
+#define configNUM_CORES					1 /* More than 1 needs the Posix_SMP port, configure CMake with -DPOSIX_SMP_PORT=ON. */
+#endif
+#ifndef configUSE_TICKLESS_IDLE
+#if ( configNUM_CORES > 1 )
+#define configUSE_TICKLESS_IDLE			0 /* Each core's idle task waits for an interrupt instead. */
+#else
+#define configUSE_TICKLESS_IDLE			1 /* The idle task sleeps the host thread until the next task unblocks. */
+#endif
+#endif
+#ifndef configTICK_RATE_HZ
 #define configTICK_RATE_HZ				( ( TickType_t ) 1000 )
+#endif
 #define configMINIMAL_STACK_SIZE		( ( unsigned short ) 4 ) /* This can be made smaller if required. */
-#define configTOTAL_HEAP_SIZE			( ( size_t ) ( 32 * 1024 ) )
+#ifndef configTOTAL_HEAP_SIZE
+#define configTOTAL_HEAP_SIZE			( ( size_t ) ( 8 * 1024 * 1024 ) )
+#endif
+#ifndef configUSE_ARENA_HEAP
+#define configUSE_ARENA_HEAP			1 /* heap_5.c over a configTOTAL_HEAP_SIZE arena rather than heap_3.c over malloc(). */
+#endif
 #define configMAX_TASK_NAME_LEN			( 16 )
 #define configUSE_TRACE_FACILITY    	1
 #define configUSE_16_BIT_TICKS      	0
@@ -85,11 +102,26 @@
 #define configCHECK_FOR_STACK_OVERFLOW	0 /* Do not use this option on the PC port. */
 #define configUSE_APPLICATION_TASK_TAG	1
 #define configQUEUE_REGISTRY_SIZE		0
-#define configMAX_SYSCALL_INTERRUPT_PRIORITY	1
+#define configMAX_SYSCALL_INTERRUPT_PRIORITY	4 /* Simulated IRQs of priority 1 to 4 may use the FromISR API, see portmacro.h. */
 
+#ifndef configMAX_PRIORITIES
 #define configMAX_PRIORITIES		( 10 )
+#endif
+#ifndef configUSE_DELAYED_TASK_WHEEL
+#define configUSE_DELAYED_TASK_WHEEL	1 /* Delayed tasks in a timing wheel rather than sorted lists. */
+#endif
 #define configMAX_CO_ROUTINE_PRIORITIES ( 2 )
 
+/* Timer daemon, which also runs the calls deferred from interrupts such as
+xEventGroupSetBitsFromISR(). */
+#define configUSE_TIMERS				1
+#define configTIMER_TASK_PRIORITY		( configMAX_PRIORITIES - 1 )
+#define configTIMER_QUEUE_LENGTH		32
+#define configTIMER_TASK_STACK_DEPTH	configMINIMAL_STACK_SIZE
+#ifndef configUSE_TIMER_WHEEL
+#define configUSE_TIMER_WHEEL			1 /* Active timers in a timing wheel rather than sorted lists. */
+#endif
+
 /* Set the following definitions to 1 to include the API function, or zero
  to exclude the API function. */
 
@@ -100,12 +132,14 @@
 #define INCLUDE_vTaskSuspend            	1
 #define INCLUDE_vTaskDelayUntil				1
 #define INCLUDE_vTaskDelay					1
-#define INCLUDE_uxTaskGetStackHighWaterMark 0 /* Do not use this option on the PC port. */
+#define INCLUDE_uxTaskGetStackHighWaterMark 1 /* Measured on the host thread stacks by the Posix port. */
 #define INCLUDE_xTaskGetSchedulerState		1
+#define INCLUDE_xTimerPendFunctionCall		1
 
 extern void vMainQueueSendPassed(void);
 #define traceQUEUE_SEND( pxQueue ) vMainQueueSendPassed()
 
 #define configGENERATE_RUN_TIME_STATS		1
+#define configRUN_TIME_COUNTER_TYPE		uint64_t	/* Nanoseconds, 32 bits wrap after 4 seconds. */
 
 #endif /* FREERTOS_CONFIG_H */
@@ -0,0 +1,212 @@
+#include <stdint.h>
+#include <string.h>
+
+#include "channel.h"
+
+#define CACHE_LINE 64
+
+/**
+ * Each block starts a cache line of its own, so the producer and the consumer
+ * never write to the same line. pvPortMalloc() only aligns to
+ * portBYTE_ALIGNMENT, channelCreate() aligns the channel itself.
+ */
+struct channel {
+	/** written by the producer */
+	size_t head __attribute__((aligned(CACHE_LINE)));
+	/** set by a send that found the consumer waiting */
+	int pending;
+
+	/** written by the consumer, a send that wakes it clears waiting */
+	size_t tail __attribute__((aligned(CACHE_LINE)));
+	int waiting;
+	TaskHandle_t consumer;
+
+	/** set up by channelCreate() */
+	size_t mask __attribute__((aligned(CACHE_LINE)));
+	size_t item_size;
+	unsigned char *ring;
+	struct channel *next;
+	/** what pvPortMalloc() returned, for vPortFree() */
+	void *allocation;
+};
+
+/** all channels, walked by the interrupt handler */
+static channel_t *channels;
+
+#ifdef CHANNEL_IRQ
+static void channelIrqHandler(void *parameter)
+{
+	BaseType_t woken = pdFALSE;
+	channel_t *channel;
+
+	for (channel = channels; channel; channel = channel->next)
+		if (__atomic_exchange_n(&channel->pending, 0, __ATOMIC_ACQUIRE))
+			xTaskNotifyFromISR(channel->consumer, 0, eNoAction,
+					   &woken);
+
+	portEND_SWITCHING_ISR(woken);
+}
+#endif
+
+channel_t *channelCreate(size_t length, size_t item_size)
+{
+	channel_t *channel;
+	void *allocation;
+	size_t slots = 1;
+
+	if (!length || !item_size)
+		return NULL;
+
+	while (slots < length)
+		slots <<= 1;
+
+	allocation = pvPortMalloc(CACHE_LINE - 1 + sizeof(channel_t) +
+				  slots * item_size);
+	if (!allocation)
+		return NULL;
+
+	channel = (channel_t *)(((uintptr_t)allocation + CACHE_LINE - 1) &
+				~(uintptr_t)(CACHE_LINE - 1));
+	memset(channel, 0, sizeof(channel_t));
+	channel->allocation = allocation;
+	channel->mask = slots - 1;
+	channel->item_size = item_size;
+	channel->ring = (unsigned char *)(channel + 1);
+
+	/** the handler only runs outside of critical sections */
+	taskENTER_CRITICAL();
+#ifdef CHANNEL_IRQ
+	if (!channels)
+		xPortInstallIrqHandler(CHANNEL_IRQ,
+				       configMAX_SYSCALL_INTERRUPT_PRIORITY,
+				       channelIrqHandler, NULL);
+#endif
+	channel->next = channels;
+	channels = channel;
+	taskEXIT_CRITICAL();
+
+	return channel;
+}
+
+void channelDelete(channel_t *channel)
+{
+	channel_t **iterator;
+
+	taskENTER_CRITICAL();
+	for (iterator = &channels; *iterator; iterator = &(*iterator)->next)
+		if (*iterator == channel) {
+			*iterator = channel->next;
+			break;
+		}
+	taskEXIT_CRITICAL();
+
+	vPortFree(channel->allocation);
+}
+
+/** copies count items between the ring at position and a flat buffer */
+static void copyRing(channel_t *channel, size_t position, void *items,
+		     size_t count, int to_ring)
+{
+	size_t index = position & channel->mask;
+	size_t first = channel->mask + 1 - index;
+	unsigned char *slot = channel->ring + index * channel->item_size;
+	unsigned char *flat = items;
+
+	if (first > count)
+		first = count;
+
+	if (to_ring) {
+		memcpy(slot, flat, first * channel->item_size);
+		memcpy(channel->ring, flat + first * channel->item_size,
+		       (count - first) * channel->item_size);
+	} else {
+		memcpy(flat, slot, first * channel->item_size);
+		memcpy(flat + first * channel->item_size, channel->ring,
+		       (count - first) * channel->item_size);
+	}
+}
+
+size_t channelSend(channel_t *channel, const void *items, size_t count)
+{
+	size_t head = channel->head;
+	size_t space = channel->mask + 1 -
+		       (head - __atomic_load_n(&channel->tail, __ATOMIC_ACQUIRE));
+
+	if (count > space)
+		count = space;
+	if (!count)
+		return 0;
+
+	copyRing(channel, head, (void *)items, count, 1);
+
+	/**
+	 * Publishing the items and then looking for a waiting consumer pairs
+	 * with the consumer saying it waits and then looking for items, so
+	 * one of the two always sees the other.
+	 */
+	__atomic_store_n(&channel->head, head + count, __ATOMIC_SEQ_CST);
+	if (__atomic_load_n(&channel->waiting, __ATOMIC_SEQ_CST) &&
+	    __atomic_exchange_n(&channel->waiting, 0, __ATOMIC_SEQ_CST)) {
+#ifdef CHANNEL_IRQ
+		__atomic_store_n(&channel->pending, 1, __ATOMIC_RELEASE);
+		vPortRaiseIrq(CHANNEL_IRQ);
+#endif
+	}
+
+	return count;
+}
+
+static size_t takeItems(channel_t *channel, void *items, size_t count)
+{
+	size_t tail = channel->tail;
+	size_t waiting = __atomic_load_n(&channel->head, __ATOMIC_SEQ_CST) - tail;
+
+	if (count > waiting)
+		count = waiting;
+	if (count) {
+		copyRing(channel, tail, items, count, 0);
+		__atomic_store_n(&channel->tail, tail + count, __ATOMIC_RELEASE);
+	}
+
+	return count;
+}
+
+size_t channelReceive(channel_t *channel, void *items, size_t count,
+		      TickType_t ticks)
+{
+	TimeOut_t timeout;
+	size_t received;
+
+	received = takeItems(channel, items, count);
+	if (received || !ticks)
+		return received;
+
+	channel->consumer = xTaskGetCurrentTaskHandle();
+	vTaskSetTimeOutState(&timeout);
+
+	do {
+#ifdef CHANNEL_IRQ
+		/** a notification left over from an earlier wait is dropped */
+		xTaskNotifyStateClear(NULL);
+		__atomic_store_n(&channel->waiting, 1, __ATOMIC_SEQ_CST);
+
+		received = takeItems(channel, items, count);
+		if (!received)
+			xTaskNotifyWait(0, 0, NULL, ticks);
+
+		__atomic_store_n(&channel->waiting, 0, __ATOMIC_SEQ_CST);
+#else
+		vTaskDelay(1);
+#endif
+		if (!received)
+			received = takeItems(channel, items, count);
+	} while (!received && xTaskCheckForTimeOut(&timeout, &ticks) == pdFALSE);
+
+	return received;
+}
+
+size_t channelItemsWaiting(channel_t *channel)
+{
+	return __atomic_load_n(&channel->head, __ATOMIC_ACQUIRE) -
+	       __atomic_load_n(&channel->tail, __ATOMIC_ACQUIRE);
+}
@@ -0,0 +1,73 @@
+#ifndef __CHANNEL_H__
+#define __CHANNEL_H__
+
+#include <stddef.h>
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+/**
+ * A channel hands fixed size items from one host thread to one task.
+ *
+ * The producer can be any host thread or a signal handler, the kernel need not
+ * know about it. channelSend() only copies into a lock-free ring and never
+ * blocks or takes a kernel or host lock. The consumer task blocks in
+ * channelReceive() and is woken by a single deferred notification: a send
+ * only raises CHANNEL_IRQ when the consumer is waiting, and the line's handler
+ * notifies the task from interrupt context, where the kernel can be called.
+ * Sends made while a notification is pending are picked up by the same wake
+ * up. On ports without the simulated interrupt controller the consumer checks
+ * the ring every tick instead.
+ *
+ * A channel uses the consumer task's notification while it waits, like a
+ * stream buffer does.
+ */
+
+/** Interrupt line shared by all channels */
+#if defined(portMAX_IRQS) && !defined(CHANNEL_IRQ)
+#define CHANNEL_IRQ (portMAX_IRQS - 1)
+#endif
+
+typedef struct channel channel_t;
+
+/**
+ * @brief Creates a channel
+ *
+ * @param length Number of items the channel holds, rounded up to a power of two
+ * @param item_size Size of an item in bytes
+ * @return The channel, or NULL if there was not enough memory
+ */
+channel_t *channelCreate(size_t length, size_t item_size);
+
+/**
+ * @brief Deletes a channel that no task is waiting on and no thread sends to
+ */
+void channelDelete(channel_t *channel);
+
+/**
+ * @brief Sends items to a channel, from any host thread or signal handler
+ *
+ * Only one thread may send to a channel at a time.
+ *
+ * @return Number of items sent, items that do not fit are not sent
+ */
+size_t channelSend(channel_t *channel, const void *items, size_t count);
+
+/**
+ * @brief Receives items from a channel, from its consumer task
+ *
+ * Returns as soon as at least one item is available.
+ *
+ * @param items Buffer for up to count items
+ * @param ticks Time to wait for the first item
+ * @return Number of items received, 0 if none arrived in time
+ */
+size_t channelReceive(channel_t *channel, void *items, size_t count,
+		      TickType_t ticks);
+
+/**
+ * @brief Number of items waiting in a channel
+ */
+size_t channelItemsWaiting(channel_t *channel);
+
+#endif
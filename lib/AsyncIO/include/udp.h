@@ -5,10 +5,10 @@
 #define SOCKET_TYPE_TCP IPPROTO_TCP
 
 #include "FreeRTOS.h"
-#include "queue.h"
+#include "channel.h"
 
 void udpInit(void);
 void udpOpenSocket(char *ip, unsigned short port, int con_type,
-		   xQueueHandle queue);
+		   channel_t *channel);
 
 #endif
@@ -5,16 +5,18 @@
 #include <fcntl.h>
 #include <arpa/inet.h>
 #include <netinet/in.h>
+#include <pthread.h>
+#include <sched.h>
 #include <signal.h>
 #include <stdio.h>
 #include <sys/socket.h>
+#include <sys/syscall.h>
 #include <unistd.h>
 #include <stdlib.h>
 
 #include "udp.h"
 
 #include "task.h"
-#include "semphr.h"
 
 #define CHECK(x)                                                               \
 	do {                                                                   \
@@ -27,7 +29,7 @@
 
 typedef struct async_callback {
 	int fd;
-	QueueHandle_t queue;
+	channel_t *channel;
 	struct async_callback *next;
 	int type;
 	int protocol;
@@ -35,70 +37,88 @@ typedef struct async_callback {
 } async_callback_t;
 
 struct callback_registry {
-	SemaphoreHandle_t lock;
 	async_callback_t *head;
+	pthread_t reader;
+	pid_t reader_tid;
 	unsigned char initialized : 1;
 } cr = { 0 };
 
 void addAsyncCallback(async_callback_t *cb)
 {
-	async_callback_t *iterator;
+	async_callback_t **iterator;
 
-	for (iterator = (async_callback_t *)&cr.head; iterator->next;
-	     iterator = iterator->next)
+	for (iterator = &cr.head; *iterator; iterator = &(*iterator)->next)
 		;
 
-	iterator->next = cb;
+	/** the reader thread walks the list without a lock */
+	__atomic_store_n(iterator, cb, __ATOMIC_RELEASE);
 }
 
 //TODO delete cb
 
-void sigactionHandler(int signal, siginfo_t *info, void *context)
+void readSocket(int fd)
 {
 	async_callback_t *iterator;
-	int fd;
 	ssize_t read_len;
 	char rx[200];
-	portBASE_TYPE false = pdFALSE;
-
-	CHECK(info);
 
-	/** socket file descriptor */
-	fd = info->si_fd;
-
-	/** find appropriate udp socket callback structure */
-	xSemaphoreTake(cr.lock, portMAX_DELAY);
-	for (iterator = (async_callback_t *)&cr.head;
-	     iterator->next && (iterator->fd != fd); iterator = iterator->next)
+	/** sockets are only ever added to the list */
+	for (iterator = __atomic_load_n(&cr.head, __ATOMIC_ACQUIRE);
+	     iterator && (iterator->fd != fd);
+	     iterator = __atomic_load_n(&iterator->next, __ATOMIC_ACQUIRE))
 		;
 
-	read_len = read(fd, &rx, 200);
-
-	if (read_len && iterator->queue)
-		for (unsigned int i = 0; i < read_len; i++)
-			xQueueSendFromISR(iterator->queue, &rx[i], &false);
-
-	xSemaphoreGive(cr.lock);
+	/**
+	 * SIGIO is not queued, one signal can stand for several datagrams.
+	 * Bytes that do not fit in the channel are dropped.
+	 */
+	while ((read_len = read(fd, &rx, sizeof(rx))) > 0)
+		if (iterator && iterator->channel)
+			channelSend(iterator->channel, rx, read_len);
 }
 
-void udpInit(void)
+/**
+ * Every socket sends its SIGIO to this thread alone, which makes it the one
+ * producer of each socket's channel. It waits for the signal instead of
+ * handling it, so no task is interrupted and nothing runs in signal context.
+ */
+void *readerThread(void *arg)
 {
-	struct sigaction sa = { 0 };
+	sigset_t signals;
+	siginfo_t info;
 
-	if (!cr.lock) {
-		cr.lock = xSemaphoreCreateMutex();
+	__atomic_store_n(&cr.reader_tid, (pid_t)syscall(SYS_gettid),
+			 __ATOMIC_RELEASE);
 
-		CHECK(cr.lock);
+	sigemptyset(&signals);
+	sigaddset(&signals, SIGIO);
 
-		/** register signal handler for incomming udp signals */
-		sa.sa_flags = SA_SIGINFO;
-		sa.sa_sigaction = sigactionHandler;
+	while (1)
+		if (sigwaitinfo(&signals, &info) == SIGIO)
+			readSocket(info.si_fd);
 
-		/** only interested in SIGIO */
-		sigfillset(&sa.sa_mask);
-		sigdelset(&sa.sa_mask, SIGIO);
+	return NULL;
+}
 
-		CHECK(!sigaction(SIGIO, &sa, NULL));
+void udpInit(void)
+{
+	sigset_t signals;
+	sigset_t previous;
+
+	if (!cr.initialized) {
+		/**
+		 * the reader starts with every signal blocked, SIGIO so that
+		 * it can wait for it and the rest so that it never takes a
+		 * signal meant for a task
+		 */
+		sigfillset(&signals);
+		pthread_sigmask(SIG_BLOCK, &signals, &previous);
+		CHECK(!pthread_create(&cr.reader, NULL, readerThread, NULL));
+		pthread_sigmask(SIG_SETMASK, &previous, NULL);
+
+		/** sockets are pointed at the reader by its thread ID */
+		while (!__atomic_load_n(&cr.reader_tid, __ATOMIC_ACQUIRE))
+			sched_yield();
 
 		cr.initialized = 1;
 	}
@@ -106,6 +126,8 @@ void udpInit(void)
 
 void makeAsync(int *fd)
 {
+	struct f_owner_ex owner = { .type = F_OWNER_TID,
+				    .pid = cr.reader_tid };
 	int file_status = fcntl(*fd, F_GETFL);
 
 	CHECK(file_status);
@@ -118,12 +140,12 @@ void makeAsync(int *fd)
 	/** set I/O signal to SIGIO */
 	CHECK(!fcntl(*fd, F_SETSIG, SIGIO));
 
-	/** send I/O signals to current process */
-	CHECK(!fcntl(*fd, F_SETOWN, getpid()));
+	/** send I/O signals to the reader thread only */
+	CHECK(!fcntl(*fd, F_SETOWN_EX, &owner));
 }
 
 void udpOpenSocket(char *ip, unsigned short port, int con_type,
-		   xQueueHandle queue)
+		   channel_t *channel)
 {
 	//TODO error handling that doesn't exit
 	taskENTER_CRITICAL();
@@ -132,7 +154,7 @@ void udpOpenSocket(char *ip, unsigned short port, int con_type,
 
 	CHECK(cb);
 
-	cb->queue = queue;
+	cb->channel = channel;
 
 	if (con_type == SOCKET_TYPE_TCP) {
 		cb->type = SOCK_STREAM;
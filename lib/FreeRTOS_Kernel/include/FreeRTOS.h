@@ -248,6 +248,14 @@ extern "C" {
 	#define configUSE_TIMERS 0
 #endif
 
+#ifndef configUSE_TIMER_WHEEL
+	#define configUSE_TIMER_WHEEL 0
+#endif
+
+#ifndef configUSE_DELAYED_TASK_WHEEL
+	#define configUSE_DELAYED_TASK_WHEEL 0
+#endif
+
 #ifndef configUSE_COUNTING_SEMAPHORES
 	#define configUSE_COUNTING_SEMAPHORES 0
 #endif
@@ -316,6 +324,18 @@ extern "C" {
 	#define portSETUP_TCB( pxTCB ) ( void ) pxTCB
 #endif
 
+#ifndef configNUM_CORES
+	#define configNUM_CORES 1
+#endif
+
+#ifndef portGET_CORE_ID
+	#define portGET_CORE_ID() 0
+#endif
+
+#ifndef portIDLE_WAIT_FOR_INTERRUPT
+	#define portIDLE_WAIT_FOR_INTERRUPT()
+#endif
+
 #ifndef configQUEUE_REGISTRY_SIZE
 	#define configQUEUE_REGISTRY_SIZE 0U
 #endif
@@ -326,6 +346,28 @@ extern "C" {
 	#define pcQueueGetName( xQueue )
 #endif
 
+#ifndef portHAS_STACK_OVERFLOW_CHECKING
+	#define portHAS_STACK_OVERFLOW_CHECKING 0
+#endif
+
+/* Ports that run each task on a stack they create themselves, such as a host
+thread's, set this to 1.  The kernel then does not allocate a stack and passes
+the port the requested depth instead. */
+#ifndef portUSE_HOST_THREAD_STACKS
+	#define portUSE_HOST_THREAD_STACKS 0
+#endif
+
+#if( ( portUSE_HOST_THREAD_STACKS == 1 ) && ( configCHECK_FOR_STACK_OVERFLOW > 0 ) )
+	#error configCHECK_FOR_STACK_OVERFLOW must be 0 when the port uses host thread stacks
+#endif
+
+/* The kernel can't see stacks the port created itself.  Ports that can measure
+them return the free space left, in words of the task's stack depth, from
+portGET_STACK_HIGH_WATER_MARK(). */
+#ifndef portGET_STACK_HIGH_WATER_MARK
+	#define portGET_STACK_HIGH_WATER_MARK( pxTCB ) 0
+#endif
+
 #ifndef portPOINTER_SIZE_TYPE
 	#define portPOINTER_SIZE_TYPE uint32_t
 #endif
@@ -658,10 +700,88 @@ extern "C" {
 	#define traceTASK_NOTIFY_GIVE_FROM_ISR()
 #endif
 
+#ifndef traceSTREAM_BUFFER_CREATE_FAILED
+	#define traceSTREAM_BUFFER_CREATE_FAILED( xIsMessageBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_CREATE
+	#define traceSTREAM_BUFFER_CREATE( pxStreamBuffer, xIsMessageBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_DELETE
+	#define traceSTREAM_BUFFER_DELETE( xStreamBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_RESET
+	#define traceSTREAM_BUFFER_RESET( xStreamBuffer )
+#endif
+
+#ifndef traceBLOCKING_ON_STREAM_BUFFER_SEND
+	#define traceBLOCKING_ON_STREAM_BUFFER_SEND( xStreamBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_SEND
+	#define traceSTREAM_BUFFER_SEND( xStreamBuffer, xBytesSent )
+#endif
+
+#ifndef traceSTREAM_BUFFER_SEND_FAILED
+	#define traceSTREAM_BUFFER_SEND_FAILED( xStreamBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_SEND_FROM_ISR
+	#define traceSTREAM_BUFFER_SEND_FROM_ISR( xStreamBuffer, xBytesSent )
+#endif
+
+#ifndef traceBLOCKING_ON_STREAM_BUFFER_RECEIVE
+	#define traceBLOCKING_ON_STREAM_BUFFER_RECEIVE( xStreamBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_RECEIVE
+	#define traceSTREAM_BUFFER_RECEIVE( xStreamBuffer, xReceivedLength )
+#endif
+
+#ifndef traceSTREAM_BUFFER_RECEIVE_FAILED
+	#define traceSTREAM_BUFFER_RECEIVE_FAILED( xStreamBuffer )
+#endif
+
+#ifndef traceSTREAM_BUFFER_RECEIVE_FROM_ISR
+	#define traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength )
+#endif
+
+#ifndef traceMEMORY_POOL_CREATE
+	#define traceMEMORY_POOL_CREATE( pxPool )
+#endif
+
+#ifndef traceMEMORY_POOL_CREATE_FAILED
+	#define traceMEMORY_POOL_CREATE_FAILED()
+#endif
+
+#ifndef traceMEMORY_POOL_DELETE
+	#define traceMEMORY_POOL_DELETE( xPool )
+#endif
+
+#ifndef traceMEMORY_POOL_ALLOC
+	#define traceMEMORY_POOL_ALLOC( xPool, pvBlock )
+#endif
+
+#ifndef traceMEMORY_POOL_FREE
+	#define traceMEMORY_POOL_FREE( xPool, pvBlock )
+#endif
+
+#ifndef configMESSAGE_BUFFER_LENGTH_TYPE
+	#define configMESSAGE_BUFFER_LENGTH_TYPE size_t
+#endif
+
 #ifndef configGENERATE_RUN_TIME_STATS
 	#define configGENERATE_RUN_TIME_STATS 0
 #endif
 
+#ifndef configRUN_TIME_COUNTER_TYPE
+	/* Defaults to uint32_t for backward compatibility, but can be overridden in
+	FreeRTOSConfig.h if uint32_t is too restrictive. */
+	#define configRUN_TIME_COUNTER_TYPE uint32_t
+#endif
+
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
 
 	#ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
@@ -764,6 +884,10 @@ extern "C" {
 	#define configAPPLICATION_ALLOCATED_HEAP 0
 #endif
 
+#ifndef configUSE_ARENA_HEAP
+	#define configUSE_ARENA_HEAP 0
+#endif
+
 #ifndef configUSE_TASK_NOTIFICATIONS
 	#define configUSE_TASK_NOTIFICATIONS 1
 #endif
@@ -789,6 +913,24 @@ extern "C" {
 	#endif /* INCLUDE_vTaskSuspend */
 #endif /* configUSE_TICKLESS_IDLE */
 
+#if( configNUM_CORES > 1 )
+	#ifndef portYIELD_CORE
+		#error portYIELD_CORE() must be defined when configNUM_CORES is more than 1
+	#endif
+	#ifndef portGET_TASK_LOCK
+		#error portGET_TASK_LOCK() and portRELEASE_TASK_LOCK() must be defined when configNUM_CORES is more than 1
+	#endif
+	#if( configUSE_TICKLESS_IDLE != 0 )
+		#error configUSE_TICKLESS_IDLE must be 0 when configNUM_CORES is more than 1
+	#endif
+	#if( configUSE_PORT_OPTIMISED_TASK_SELECTION != 0 )
+		#error configUSE_PORT_OPTIMISED_TASK_SELECTION must be 0 when configNUM_CORES is more than 1
+	#endif
+	#if( configSUPPORT_STATIC_ALLOCATION != 0 )
+		#error configSUPPORT_STATIC_ALLOCATION must be 0 when configNUM_CORES is more than 1, the idle tasks are allocated dynamically
+	#endif
+#endif /* configNUM_CORES */
+
 #if( ( configSUPPORT_STATIC_ALLOCATION == 0 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 0 ) )
 	#error configSUPPORT_STATIC_ALLOCATION and configSUPPORT_DYNAMIC_ALLOCATION cannot both be 0, but can both be 1.
 #endif
@@ -937,7 +1079,7 @@ typedef struct xSTATIC_TCB
 		void			*pvDummy15[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
 	#endif
 	#if ( configGENERATE_RUN_TIME_STATS == 1 )
-		uint32_t		ulDummy16;
+		configRUN_TIME_COUNTER_TYPE	ulDummy16;
 	#endif
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		struct	_reent	xDummy17;
@@ -949,6 +1091,10 @@ typedef struct xSTATIC_TCB
 	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 		uint8_t			uxDummy20;
 	#endif
+	#if( configNUM_CORES > 1 )
+		BaseType_t		xDummy21;
+		UBaseType_t		uxDummy22;
+	#endif
 
 } StaticTask_t;
 
@@ -978,7 +1124,7 @@ typedef struct xSTATIC_QUEUE
 
 	StaticList_t xDummy3[ 2 ];
 	UBaseType_t uxDummy4[ 3 ];
-	uint8_t ucDummy5[ 2 ];
+	uint8_t ucDummy5[ 3 ];
 
 	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 		uint8_t ucDummy6;
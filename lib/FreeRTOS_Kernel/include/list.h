@@ -211,6 +211,40 @@ typedef struct xLIST
 	listSECOND_LIST_INTEGRITY_CHECK_VALUE				/*< Set to a known value if configUSE_LIST_DATA_INTEGRITY_CHECK_BYTES is set to 1. */
 } List_t;
 
+#if( ( configUSE_TIMER_WHEEL == 1 ) || ( configUSE_DELAYED_TASK_WHEEL == 1 ) )
+
+	/* Each level of a timing wheel resolves listWHEEL_SLOT_BITS bits of an
+	item value, and there are enough levels to cover all the bits of
+	TickType_t. */
+	#define listWHEEL_SLOT_BITS		( 6U )
+	#define listWHEEL_SLOTS			( 1U << listWHEEL_SLOT_BITS )
+	#define listWHEEL_SLOT_MASK		( ( TickType_t ) listWHEEL_SLOTS - ( TickType_t ) 1U )
+	#define listWHEEL_LEVELS		( ( ( sizeof( TickType_t ) * 8U ) + listWHEEL_SLOT_BITS - 1U ) / listWHEEL_SLOT_BITS )
+
+	/* Index of the lowest set bit of a level's slot map, which is not 0. */
+	#ifndef listWHEEL_FIRST_SLOT
+		#define listWHEEL_FIRST_SLOT( ullMap )	( ( UBaseType_t ) __builtin_ctzll( ullMap ) )
+	#endif
+
+	/*
+	 * A hierarchical timing wheel holds list items in the order of their item
+	 * value, a tick count, like a sorted list, but inserts them in constant
+	 * time.  An item is stored at the level of the most significant digit in
+	 * which its value differs from the time of the wheel, in the slot picked by
+	 * its value's digit at that level.  The items in a level 0 slot therefore
+	 * all have the same value, and the items in a slot of a higher level are
+	 * moved down once the time of the wheel reaches the start of the slot.
+	 * Items are removed from their slot with uxListRemove() as from any list.
+	 */
+	typedef struct xTIMING_WHEEL
+	{
+		List_t xSlots[ listWHEEL_LEVELS ][ listWHEEL_SLOTS ];	/*< The items of each slot, in no particular order. */
+		uint64_t ullSlotMap[ listWHEEL_LEVELS ];				/*< A bit is set for every slot that may hold items.  Bits of slots that were emptied by uxListRemove() are cleared when the slot is next looked at. */
+		TickType_t xTime;										/*< No item in the wheel has a value before this time. */
+	} TimingWheel_t;
+
+#endif /* configUSE_TIMER_WHEEL || configUSE_DELAYED_TASK_WHEEL */
+
 /*
  * Access macro to set the owner of a list item.  The owner of a list item
  * is the object (usually a TCB) that contains the list item.
@@ -445,6 +479,70 @@ void vListInsertEnd( List_t * const pxList, ListItem_t * const pxNewListItem ) P
  */
 UBaseType_t uxListRemove( ListItem_t * const pxItemToRemove ) PRIVILEGED_FUNCTION;
 
+#if( ( configUSE_TIMER_WHEEL == 1 ) || ( configUSE_DELAYED_TASK_WHEEL == 1 ) )
+
+	/*
+	 * Access macro to set the time of a timing wheel.  This is only allowed
+	 * while the wheel is empty, such as when the tick count has overflowed.
+	 */
+	#define listWHEEL_SET_TIME( pxWheel, xNewTime )	( ( pxWheel )->xTime = ( xNewTime ) )
+
+	/*
+	 * Check to see if a list is one of the slots of a timing wheel, so whether
+	 * a list item contained within pxList is in the wheel.
+	 */
+	#define listWHEEL_CONTAINS_LIST( pxWheel, pxList ) ( ( BaseType_t ) ( ( ( pxList ) >= &( ( pxWheel )->xSlots[ 0 ][ 0 ] ) ) && ( ( pxList ) <= &( ( pxWheel )->xSlots[ listWHEEL_LEVELS - 1U ][ listWHEEL_SLOTS - 1U ] ) ) ) )
+
+	/*
+	 * Must be called before a timing wheel is used.  Initialises every slot
+	 * and starts the wheel at time 0.
+	 *
+	 * @param pxWheel Pointer to the wheel being initialised.
+	 */
+	void vWheelInitialise( TimingWheel_t * const pxWheel ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Insert a list item into a timing wheel at its item value, which must not
+	 * be before the time of the wheel.
+	 *
+	 * @param pxWheel The wheel into which the item is to be inserted.
+	 *
+	 * @param pxNewListItem The item that is to be placed in the wheel.
+	 */
+	void vWheelInsert( TimingWheel_t * const pxWheel, ListItem_t * const pxNewListItem ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Find the first slot of a timing wheel that holds items.
+	 *
+	 * @param pxWheel The wheel to search.
+	 *
+	 * @param pxDueTime Set to the time at which the slot is due.  That is the
+	 * value of the slot's items at level 0, and the time at which its items
+	 * are moved down a level above it.
+	 *
+	 * @return The slot, or NULL if the wheel is empty.
+	 */
+	List_t *pxWheelGetNextSlot( TimingWheel_t * const pxWheel, TickType_t * const pxDueTime ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Advance a timing wheel to the time at which the slot returned by
+	 * pxWheelGetNextSlot() is due.  The items of a slot above level 0 are
+	 * moved down a level.
+	 *
+	 * @param pxWheel The wheel to advance.
+	 *
+	 * @param pxSlot The slot returned by pxWheelGetNextSlot().
+	 *
+	 * @param xDueTime The time returned with the slot, which must not be after
+	 * the current tick count.
+	 *
+	 * @return pxSlot, if it is at level 0 and its items have reached their
+	 * item value, otherwise NULL.
+	 */
+	List_t *pxWheelAdvance( TimingWheel_t * const pxWheel, List_t * const pxSlot, const TickType_t xDueTime ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_TIMER_WHEEL || configUSE_DELAYED_TASK_WHEEL */
+
 #ifdef __cplusplus
 }
 #endif
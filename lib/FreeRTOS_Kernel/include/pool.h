@@ -0,0 +1,290 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/*
+ * A memory pool hands out blocks of a single size from storage set aside when
+ * the pool is created.  The free blocks are linked through their first word,
+ * so taking a block and giving it back are each a constant time operation
+ * that never walks the heap, and a pool cannot fragment.  Every pool call
+ * only holds off interrupts for the few instructions needed to unlink or link
+ * a block, and can be made from a task or from an interrupt service routine.
+ *
+ * Pools suit objects that are allocated and freed again at a high rate, such
+ * as the jobs passed from the drawing functions to the task that renders them.
+ * A pool that is empty returns NULL rather than blocking, and
+ * xPoolContains() tells a block of the pool apart from memory the caller
+ * obtained some other way when it fell back to pvPortMalloc().
+ */
+
+#ifndef POOL_H
+#define POOL_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include pool.h"
+#endif
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/**
+ * Type by which memory pools are referenced.  For example, a call to
+ * xPoolCreate() returns a PoolHandle_t variable that can then be used as a
+ * parameter to pvPoolAlloc(), vPoolFree(), etc.
+ */
+typedef void * PoolHandle_t;
+
+/**
+ * pool.h
+ * <pre>
+ PoolHandle_t xPoolCreate( size_t xBlockSize, UBaseType_t uxBlocks );
+ * </pre>
+ *
+ * Creates a new memory pool using dynamically allocated memory.  The pool
+ * structure and all of its blocks are allocated with a single call to
+ * pvPortMalloc().
+ *
+ * @param xBlockSize The size, in bytes, of every block in the pool.  It is
+ * rounded up to a multiple of portBYTE_ALIGNMENT, and to at least the size of
+ * a pointer, so every block is aligned as pvPortMalloc() aligns memory.
+ *
+ * @param uxBlocks The number of blocks in the pool.
+ *
+ * @return If NULL is returned, then the pool cannot be created because there
+ * is insufficient heap memory available for FreeRTOS to allocate it.  A
+ * non-NULL value being returned indicates that the pool has been created
+ * successfully - the returned value should be stored as the handle to the
+ * created pool.
+ *
+ * Example use:
+<pre>
+
+typedef struct AMessage
+{
+	uint32_t ulId;
+	uint8_t ucData[ 20 ];
+} AMessage_t;
+
+PoolHandle_t xMessagePool;
+
+void vAFunction( void )
+{
+	// Create a pool of 32 blocks, each large enough to hold an AMessage_t.
+	xMessagePool = xPoolCreate( sizeof( AMessage_t ), 32 );
+
+	if( xMessagePool == NULL )
+	{
+		// There was not enough heap memory space available to create the
+		// pool.
+	}
+}
+
+void vSendingTask( void *pvParameters )
+{
+AMessage_t *pxMessage;
+
+	for( ;; )
+	{
+		// Take a block from the pool, fill it in and pass the pointer to the
+		// receiving task, which returns it to the pool with vPoolFree().
+		pxMessage = ( AMessage_t * ) pvPoolAlloc( xMessagePool );
+
+		if( pxMessage != NULL )
+		{
+			pxMessage->ulId = 1;
+			xQueueSend( xPointerQueue, &pxMessage, portMAX_DELAY );
+		}
+	}
+}
+</pre>
+ * \defgroup xPoolCreate xPoolCreate
+ * \ingroup MemoryPoolManagement
+ */
+PoolHandle_t xPoolCreate( size_t xBlockSize, UBaseType_t uxBlocks ) PRIVILEGED_FUNCTION;
+
+/**
+ * pool.h
+ * <pre>
+ void vPoolDelete( PoolHandle_t xPool );
+ * </pre>
+ *
+ * Deletes a memory pool that was previously created using a call to
+ * xPoolCreate().  The memory of the pool and of all its blocks is freed, so
+ * no block taken from the pool may be used after the pool has been deleted.
+ *
+ * @param xPool The handle of the pool to be deleted.
+ *
+ * \defgroup vPoolDelete vPoolDelete
+ * \ingroup MemoryPoolManagement
+ */
+void vPoolDelete( PoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * pool.h
+ * <pre>
+ void *pvPoolAlloc( PoolHandle_t xPool );
+ * </pre>
+ *
+ * Takes a block from a memory pool.  The contents of the block are not
+ * initialised.  It is safe to call pvPoolAlloc() from a task or from an
+ * interrupt service routine, and it never blocks.
+ *
+ * @param xPool The handle of the pool from which a block is taken.
+ *
+ * @return A pointer to the block, or NULL if every block of the pool is in
+ * use.
+ *
+ * \defgroup pvPoolAlloc pvPoolAlloc
+ * \ingroup MemoryPoolManagement
+ */
+void *pvPoolAlloc( PoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * pool.h
+ * <pre>
+ void vPoolFree( PoolHandle_t xPool, void *pv );
+ * </pre>
+ *
+ * Returns a block to the memory pool it was taken from.  It is safe to call
+ * vPoolFree() from a task or from an interrupt service routine, which need not
+ * be the one that took the block.
+ *
+ * @param xPool The handle of the pool the block was taken from.
+ *
+ * @param pv The block, as returned by pvPoolAlloc().  Passing NULL has no
+ * effect.
+ *
+ * \defgroup vPoolFree vPoolFree
+ * \ingroup MemoryPoolManagement
+ */
+void vPoolFree( PoolHandle_t xPool, void *pv ) PRIVILEGED_FUNCTION;
+
+/**
+ * pool.h
+ * <pre>
+ BaseType_t xPoolContains( PoolHandle_t xPool, const void *pv );
+ * </pre>
+ *
+ * Queries whether pv points into the storage of a memory pool, for callers
+ * that fall back to another allocator when the pool is empty and have to know
+ * where to return the memory.
+ *
+ * @param xPool The handle of the pool being queried.
+ *
+ * @param pv The memory being queried.
+ *
+ * @return pdTRUE if pv is a block of the pool, otherwise pdFALSE.
+ *
+ * \defgroup xPoolContains xPoolContains
+ * \ingroup MemoryPoolManagement
+ */
+BaseType_t xPoolContains( PoolHandle_t xPool, const void *pv ) PRIVILEGED_FUNCTION;
+
+/**
+ * pool.h
+ * <pre>
+ UBaseType_t uxPoolGetFreeBlocks( PoolHandle_t xPool );
+ * </pre>
+ *
+ * Queries a memory pool to see how many of its blocks are free.
+ *
+ * @param xPool The handle of the pool being queried.
+ *
+ * @return The number of blocks that can be taken from the pool before it is
+ * empty.
+ *
+ * \defgroup uxPoolGetFreeBlocks uxPoolGetFreeBlocks
+ * \ingroup MemoryPoolManagement
+ */
+UBaseType_t uxPoolGetFreeBlocks( PoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
+/**
+ * pool.h
+ * <pre>
+ UBaseType_t uxPoolGetMinimumEverFreeBlocks( PoolHandle_t xPool );
+ * </pre>
+ *
+ * Queries a memory pool for the fewest blocks it has had free since it was
+ * created, which shows how much of the pool the application really needs.
+ * A pool that has reached 0 has probably been empty when a block was needed.
+ *
+ * @param xPool The handle of the pool being queried.
+ *
+ * @return The lowest number of free blocks the pool has had.
+ *
+ * \defgroup uxPoolGetMinimumEverFreeBlocks uxPoolGetMinimumEverFreeBlocks
+ * \ingroup MemoryPoolManagement
+ */
+UBaseType_t uxPoolGetMinimumEverFreeBlocks( PoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif	/* !defined( POOL_H ) */
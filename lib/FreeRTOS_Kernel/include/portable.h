@@ -137,11 +137,28 @@ extern "C" {
  * scheduler control.  The registers have to be placed on the stack in
  * the order that the port expects to find them.
  *
+ * Ports that set portHAS_STACK_OVERFLOW_CHECKING to 1 are also passed the
+ * other extreme of the stack, i.e. the lowest usable address when the stack
+ * grows down.
+ *
+ * Ports that set portUSE_HOST_THREAD_STACKS to 1 create the stack themselves
+ * and are passed its depth in words instead.
+ *
  */
-#if( portUSING_MPU_WRAPPERS == 1 )
-	StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters, BaseType_t xRunPrivileged ) PRIVILEGED_FUNCTION;
+#if( portUSE_HOST_THREAD_STACKS == 1 )
+	StackType_t *pxPortInitialiseStack( uint32_t ulStackDepth, TaskFunction_t pxCode, void *pvParameters ) PRIVILEGED_FUNCTION;
+#elif( portUSING_MPU_WRAPPERS == 1 )
+	#if( portHAS_STACK_OVERFLOW_CHECKING == 1 )
+		StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, StackType_t *pxEndOfStack, TaskFunction_t pxCode, void *pvParameters, BaseType_t xRunPrivileged ) PRIVILEGED_FUNCTION;
+	#else
+		StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters, BaseType_t xRunPrivileged ) PRIVILEGED_FUNCTION;
+	#endif
 #else
-	StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters ) PRIVILEGED_FUNCTION;
+	#if( portHAS_STACK_OVERFLOW_CHECKING == 1 )
+		StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, StackType_t *pxEndOfStack, TaskFunction_t pxCode, void *pvParameters ) PRIVILEGED_FUNCTION;
+	#else
+		StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters ) PRIVILEGED_FUNCTION;
+	#endif
 #endif
 
 /* Used by heap_5.c. */
@@ -164,6 +181,36 @@ typedef struct HeapRegion
  */
 void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEGED_FUNCTION;
 
+/* Blocks are counted by size class in HeapStats_t, by their size including the
+block header.  Class n holds the blocks of up to
+( portHEAP_SMALLEST_SIZE_CLASS << n ) bytes and the last class all the larger
+ones. */
+#ifndef portHEAP_SIZE_CLASSES
+	#define portHEAP_SIZE_CLASSES			10
+#endif
+#define portHEAP_SMALLEST_SIZE_CLASS		( ( size_t ) 16 )
+
+/* Used to pass information about the heap out of vPortGetHeapStats(). */
+typedef struct xHEAP_STATS
+{
+	size_t xAvailableHeapSpaceInBytes;		/* The total heap size currently available - this is the sum of all the free blocks, not the largest block that can be allocated. */
+	size_t xSizeOfLargestFreeBlockInBytes;	/* The maximum size, in bytes, of all the free blocks within the heap at the time vPortGetHeapStats() is called. */
+	size_t xSizeOfSmallestFreeBlockInBytes;	/* The minimum size, in bytes, of all the free blocks within the heap at the time vPortGetHeapStats() is called. */
+	size_t xNumberOfFreeBlocks;				/* The number of free memory blocks within the heap at the time vPortGetHeapStats() is called. */
+	size_t xMinimumEverFreeBytesRemaining;	/* The minimum amount of total free memory (sum of all free blocks) there has been in the heap since the system booted. */
+	size_t xNumberOfSuccessfulAllocations;	/* The number of calls to pvPortMalloc() that have returned a valid memory block. */
+	size_t xNumberOfSuccessfulFrees;		/* The number of calls to vPortFree() that has successfully freed a block of memory. */
+	size_t xAllocatedBlocksInClass[ portHEAP_SIZE_CLASSES ];	/* The number of blocks currently allocated in each size class. */
+	size_t xFreeBlocksInClass[ portHEAP_SIZE_CLASSES ];		/* The number of free blocks in each size class. */
+} HeapStats_t;
+
+/*
+ * Fills pxHeapStats with the state of the heap.  The free blocks are walked
+ * with the scheduler suspended, so the call takes longer the more fragmented
+ * the heap is.  Only heap_5.c provides it.
+ */
+void vPortGetHeapStats( HeapStats_t *pxHeapStats ) PRIVILEGED_FUNCTION;
+
 
 /*
  * Map to the memory management routines required for the port.
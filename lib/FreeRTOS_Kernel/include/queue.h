@@ -1529,6 +1529,243 @@ BaseType_t xQueueGiveFromISR( QueueHandle_t xQueue, BaseType_t * const pxHigherP
  */
 BaseType_t xQueueReceiveFromISR( QueueHandle_t xQueue, void * const pvBuffer, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+/**
+ * queue. h
+ * <pre>
+ size_t xQueueSendMultiple(
+							   QueueHandle_t xQueue,
+							   const void *pvItems,
+							   size_t xItemCount,
+							   TickType_t xTicksToWait
+						   );
+ * </pre>
+ *
+ * Post several items to the back of a queue.  The items are copied in as few
+ * critical sections as there is room for them, and each copy unblocks at most
+ * one waiting task per item, rather than one critical section and event list
+ * check per item as a loop around xQueueSend() would take.  Must not be used
+ * on a mutex, and cannot be used to overwrite.
+ *
+ * @param xQueue The handle to the queue on which the items are to be posted.
+ *
+ * @param pvItems Pointer to an array of xItemCount items, each the item size
+ * the queue was created with.
+ *
+ * @param xItemCount The number of items to post.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block, in
+ * total, waiting for space while the queue is full.  The call returns
+ * immediately with the items there was room for if this is set to 0.
+ *
+ * @return The number of items posted, xItemCount unless the block time
+ * expired first.
+ *
+ * Example usage:
+   <pre>
+ uint8_t ucBytes[ 64 ];
+ size_t xReceived;
+
+	xReceived = xReadFromDevice( ucBytes, sizeof( ucBytes ) );
+
+	// Post every byte to a queue of uint8_t, waiting up to 10 ticks in all
+	// for the receiving task to make room.
+	if( xQueueSendMultiple( xQueue, ucBytes, xReceived, 10 ) != xReceived )
+	{
+		// Some of the bytes were dropped.
+	}
+ </pre>
+ * \defgroup xQueueSendMultiple xQueueSendMultiple
+ * \ingroup QueueManagement
+ */
+size_t xQueueSendMultiple( QueueHandle_t xQueue, const void * const pvItems, size_t xItemCount, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ size_t xQueueSendMultipleFromISR(
+									  QueueHandle_t xQueue,
+									  const void *pvItems,
+									  size_t xItemCount,
+									  BaseType_t *pxHigherPriorityTaskWoken
+								  );
+ * </pre>
+ *
+ * A version of xQueueSendMultiple() that can be called from an interrupt
+ * service routine.  It posts as many of the items as there is room for in a
+ * single critical section.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if posting the items
+ * unblocked a task with a priority higher than the running task, in which
+ * case a context switch should be requested before the interrupt is exited.
+ *
+ * @return The number of items posted.
+ *
+ * \defgroup xQueueSendMultipleFromISR xQueueSendMultipleFromISR
+ * \ingroup QueueManagement
+ */
+size_t xQueueSendMultipleFromISR( QueueHandle_t xQueue, const void * const pvItems, size_t xItemCount, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ size_t xQueueReceiveMultiple(
+								  QueueHandle_t xQueue,
+								  void *pvBuffer,
+								  size_t xMaxItems,
+								  TickType_t xTicksToWait
+							  );
+ * </pre>
+ *
+ * Receive up to xMaxItems items from a queue in a single critical section.
+ * The call returns as soon as at least one item is available, with every item
+ * that was waiting up to xMaxItems.  Must not be used on a mutex.
+ *
+ * @param xQueue The handle to the queue from which the items are received.
+ *
+ * @param pvBuffer Pointer to an array with room for xMaxItems items.
+ *
+ * @param xMaxItems The most items to receive.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item if the queue is empty.
+ *
+ * @return The number of items received, 0 if the block time expired.
+ *
+ * Example usage:
+   <pre>
+ Message_t xMessages[ 8 ];
+ size_t x, xCount;
+
+	// Handle the messages in batches of up to 8 while there are any.
+	while( ( xCount = xQueueReceiveMultiple( xQueue, xMessages, 8, 0 ) ) > 0 )
+	{
+		for( x = 0; x < xCount; x++ )
+		{
+			vHandleMessage( &( xMessages[ x ] ) );
+		}
+	}
+ </pre>
+ * \defgroup xQueueReceiveMultiple xQueueReceiveMultiple
+ * \ingroup QueueManagement
+ */
+size_t xQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, size_t xMaxItems, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ size_t xQueueReceiveMultipleFromISR(
+										 QueueHandle_t xQueue,
+										 void *pvBuffer,
+										 size_t xMaxItems,
+										 BaseType_t *pxHigherPriorityTaskWoken
+									 );
+ * </pre>
+ *
+ * A version of xQueueReceiveMultiple() that can be called from an interrupt
+ * service routine.
+ *
+ * @param pxHigherPriorityTaskWoken Set to pdTRUE if receiving the items
+ * unblocked a task with a priority higher than the running task, in which
+ * case a context switch should be requested before the interrupt is exited.
+ *
+ * @return The number of items received.
+ *
+ * \defgroup xQueueReceiveMultipleFromISR xQueueReceiveMultipleFromISR
+ * \ingroup QueueManagement
+ */
+size_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue, void * const pvBuffer, size_t xMaxItems, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ void *pvQueueReserve( QueueHandle_t xQueue, TickType_t xTicksToWait );
+ void vQueueCommit( QueueHandle_t xQueue );
+ * </pre>
+ *
+ * Post an item without copying it.  pvQueueReserve() waits for space as
+ * xQueueSend() does and returns a pointer to the next free slot in the queue's
+ * own storage, which the caller fills in place.  vQueueCommit() then posts the
+ * item and unblocks a task waiting to receive, as xQueueSend() does.  Until the
+ * item is committed receivers do not see it, and every other send or
+ * reservation finds the queue full: a task blocks until the item is committed,
+ * and the FromISR calls fail.  The zero copy calls therefore suit a queue with
+ * a single writer.
+ *
+ * @param xQueue The handle to the queue, which must not be a semaphore or a
+ * mutex.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for space should the queue be full.
+ *
+ * @return Pointer to the slot, uxItemSize bytes long, or NULL if the block
+ * time expired before there was space.
+ *
+ * Example usage:
+   <pre>
+ Packet_t *pxPacket;
+
+	pxPacket = ( Packet_t * ) pvQueueReserve( xPacketQueue, portMAX_DELAY );
+	vFillPacket( pxPacket );
+	vQueueCommit( xPacketQueue );
+ </pre>
+ * \defgroup pvQueueReserve pvQueueReserve
+ * \ingroup QueueManagement
+ */
+void *pvQueueReserve( QueueHandle_t xQueue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+void vQueueCommit( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ void *pvQueueReserveFromISR( QueueHandle_t xQueue );
+ void vQueueCommitFromISR( QueueHandle_t xQueue, BaseType_t *pxHigherPriorityTaskWoken );
+ * </pre>
+ *
+ * Versions of pvQueueReserve() and vQueueCommit() that can be called from an
+ * interrupt service routine.  pvQueueReserveFromISR() returns NULL at once if
+ * the queue is full.  vQueueCommitFromISR() sets *pxHigherPriorityTaskWoken to
+ * pdTRUE if posting the item unblocked a task with a priority higher than the
+ * running task.
+ *
+ * \defgroup pvQueueReserveFromISR pvQueueReserveFromISR
+ * \ingroup QueueManagement
+ */
+void *pvQueueReserveFromISR( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+void vQueueCommitFromISR( QueueHandle_t xQueue, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/**
+ * queue. h
+ * <pre>
+ void *pvQueueAcquire( QueueHandle_t xQueue, TickType_t xTicksToWait );
+ void vQueueRelease( QueueHandle_t xQueue );
+ * </pre>
+ *
+ * Receive an item without copying it.  pvQueueAcquire() waits for an item as
+ * xQueueReceive() does and returns a pointer to it in the queue's own storage.
+ * vQueueRelease() then removes the item and unblocks a task waiting to send,
+ * as xQueueReceive() does.  Until the item is released it cannot be
+ * overwritten, and every other receive, peek or acquisition finds the queue
+ * empty: a task blocks until the item is released, and the FromISR calls fail.
+ * The zero copy calls therefore suit a queue with a single reader.  Sends to
+ * the front of the queue, including xQueueOverwrite(), find the queue full
+ * while an item is acquired: a task blocks until the item is released, and the
+ * FromISR calls return errQUEUE_FULL.
+ *
+ * @param xQueue The handle to the queue, which must not be a semaphore or a
+ * mutex.
+ *
+ * @param xTicksToWait The maximum amount of time the task should block
+ * waiting for an item should the queue be empty.
+ *
+ * @return Pointer to the item, or NULL if the block time expired before there
+ * was one.
+ *
+ * \defgroup pvQueueAcquire pvQueueAcquire
+ * \ingroup QueueManagement
+ */
+void *pvQueueAcquire( QueueHandle_t xQueue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+void vQueueRelease( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+
 /*
  * Utilities to query queues that are safe to use from an ISR.  These utilities
  * should be used only from witin an ISR, or within a critical section.
@@ -238,3 +238,122 @@ List_t * const pxList = ( List_t * ) pxItemToRemove->pvContainer;
 }
 /*-----------------------------------------------------------*/
 
+#if( ( configUSE_TIMER_WHEEL == 1 ) || ( configUSE_DELAYED_TASK_WHEEL == 1 ) )
+
+void vWheelInitialise( TimingWheel_t * const pxWheel )
+{
+UBaseType_t uxLevel, uxSlot;
+
+	for( uxLevel = 0U; uxLevel < listWHEEL_LEVELS; uxLevel++ )
+	{
+		for( uxSlot = 0U; uxSlot < listWHEEL_SLOTS; uxSlot++ )
+		{
+			vListInitialise( &( pxWheel->xSlots[ uxLevel ][ uxSlot ] ) );
+		}
+
+		pxWheel->ullSlotMap[ uxLevel ] = 0U;
+	}
+
+	pxWheel->xTime = ( TickType_t ) 0U;
+}
+/*-----------------------------------------------------------*/
+
+void vWheelInsert( TimingWheel_t * const pxWheel, ListItem_t * const pxNewListItem )
+{
+const TickType_t xValueOfInsertion = pxNewListItem->xItemValue;
+const TickType_t xDifferentDigits = xValueOfInsertion ^ pxWheel->xTime;
+UBaseType_t uxLevel = 0U, uxSlot;
+
+	/* Find the most significant digit in which the item value and the time of
+	the wheel differ.  The item value is never before the time of the wheel, so
+	its digit at that level is the greater one, and the slot is due in the
+	future. */
+	while( ( uxLevel < ( listWHEEL_LEVELS - 1U ) ) && ( ( xDifferentDigits >> ( listWHEEL_SLOT_BITS * ( uxLevel + 1U ) ) ) != ( TickType_t ) 0U ) )
+	{
+		uxLevel++;
+	}
+
+	uxSlot = ( UBaseType_t ) ( ( xValueOfInsertion >> ( listWHEEL_SLOT_BITS * uxLevel ) ) & listWHEEL_SLOT_MASK );
+	vListInsertEnd( &( pxWheel->xSlots[ uxLevel ][ uxSlot ] ), pxNewListItem );
+	pxWheel->ullSlotMap[ uxLevel ] |= ( ( uint64_t ) 1U ) << uxSlot;
+}
+/*-----------------------------------------------------------*/
+
+List_t *pxWheelGetNextSlot( TimingWheel_t * const pxWheel, TickType_t * const pxDueTime )
+{
+UBaseType_t uxLevel, uxSlot;
+TickType_t xHigherDigits;
+List_t *pxReturn = NULL;
+
+	/* The slots of a level are only due after those of the levels below it,
+	and, as the time of the wheel never passes a slot that holds items, the
+	lowest slot that holds items at a level is the first one due. */
+	for( uxLevel = 0U; ( uxLevel < listWHEEL_LEVELS ) && ( pxReturn == NULL ); uxLevel++ )
+	{
+		while( ( pxWheel->ullSlotMap[ uxLevel ] != 0U ) && ( pxReturn == NULL ) )
+		{
+			uxSlot = listWHEEL_FIRST_SLOT( pxWheel->ullSlotMap[ uxLevel ] );
+
+			if( listLIST_IS_EMPTY( &( pxWheel->xSlots[ uxLevel ][ uxSlot ] ) ) != pdFALSE )
+			{
+				/* The slot's items have all been removed. */
+				pxWheel->ullSlotMap[ uxLevel ] &= ~( ( ( uint64_t ) 1U ) << uxSlot );
+			}
+			else
+			{
+				/* The items in the slot share the digits above this level
+				with the time of the wheel. */
+				if( uxLevel < ( listWHEEL_LEVELS - 1U ) )
+				{
+					xHigherDigits = pxWheel->xTime & ~( ( ( ( TickType_t ) 1U ) << ( listWHEEL_SLOT_BITS * ( uxLevel + 1U ) ) ) - ( TickType_t ) 1U );
+				}
+				else
+				{
+					xHigherDigits = ( TickType_t ) 0U;
+				}
+
+				*pxDueTime = xHigherDigits | ( ( TickType_t ) uxSlot << ( listWHEEL_SLOT_BITS * uxLevel ) );
+				pxReturn = &( pxWheel->xSlots[ uxLevel ][ uxSlot ] );
+			}
+		}
+	}
+
+	return pxReturn;
+}
+/*-----------------------------------------------------------*/
+
+List_t *pxWheelAdvance( TimingWheel_t * const pxWheel, List_t * const pxSlot, const TickType_t xDueTime )
+{
+const UBaseType_t uxIndex = ( UBaseType_t ) ( pxSlot - &( pxWheel->xSlots[ 0 ][ 0 ] ) );
+List_t *pxReturn = NULL;
+ListItem_t *pxItem;
+
+	pxWheel->xTime = xDueTime;
+
+	if( uxIndex < listWHEEL_SLOTS )
+	{
+		/* The map bit is cleared once the slot is found empty. */
+		pxReturn = pxSlot;
+	}
+	else
+	{
+		/* The item values of the slot's items now share this level's digit
+		with the time of the wheel, so each goes to a lower level.  An item
+		whose value is the time of the wheel goes to the level 0 slot that is
+		due now. */
+		pxWheel->ullSlotMap[ uxIndex / listWHEEL_SLOTS ] &= ~( ( ( uint64_t ) 1U ) << ( uxIndex % listWHEEL_SLOTS ) );
+
+		while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+		{
+			pxItem = listGET_HEAD_ENTRY( pxSlot );
+			( void ) uxListRemove( pxItem );
+			vWheelInsert( pxWheel, pxItem );
+		}
+	}
+
+	return pxReturn;
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_TIMER_WHEEL || configUSE_DELAYED_TASK_WHEEL */
+
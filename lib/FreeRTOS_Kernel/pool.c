@@ -0,0 +1,294 @@
+/*
+    FreeRTOS V9.0.0 - Copyright (C) 2016 Real Time Engineers Ltd.
+    All rights reserved
+
+    VISIT http://www.FreeRTOS.org TO ENSURE YOU ARE USING THE LATEST VERSION.
+
+    This file is part of the FreeRTOS distribution.
+
+    FreeRTOS is free software; you can redistribute it and/or modify it under
+    the terms of the GNU General Public License (version 2) as published by the
+    Free Software Foundation >>>> AND MODIFIED BY <<<< the FreeRTOS exception.
+
+    ***************************************************************************
+    >>!   NOTE: The modification to the GPL is included to allow you to     !<<
+    >>!   distribute a combined work that includes FreeRTOS without being   !<<
+    >>!   obliged to provide the source code for proprietary components     !<<
+    >>!   outside of the FreeRTOS kernel.                                   !<<
+    ***************************************************************************
+
+    FreeRTOS is distributed in the hope that it will be useful, but WITHOUT ANY
+    WARRANTY; without even the implied warranty of MERCHANTABILITY or FITNESS
+    FOR A PARTICULAR PURPOSE.  Full license text is available on the following
+    link: http://www.freertos.org/a00114.html
+
+    ***************************************************************************
+     *                                                                       *
+     *    FreeRTOS provides completely free yet professionally developed,    *
+     *    robust, strictly quality controlled, supported, and cross          *
+     *    platform software that is more than just the market leader, it     *
+     *    is the industry's de facto standard.                               *
+     *                                                                       *
+     *    Help yourself get started quickly while simultaneously helping     *
+     *    to support the FreeRTOS project by purchasing a FreeRTOS           *
+     *    tutorial book, reference manual, or both:                          *
+     *    http://www.FreeRTOS.org/Documentation                              *
+     *                                                                       *
+    ***************************************************************************
+
+    http://www.FreeRTOS.org/FAQHelp.html - Having a problem?  Start by reading
+    the FAQ page "My application does not run, what could be wrong?".  Have you
+    defined configASSERT()?
+
+    http://www.FreeRTOS.org/support - In return for receiving this top quality
+    embedded software for free we request you assist our global community by
+    participating in the support forum.
+
+    http://www.FreeRTOS.org/training - Investing in training allows your team to
+    be as productive as possible as early as possible.  Now you can receive
+    FreeRTOS training directly from Richard Barry, CEO of Real Time Engineers
+    Ltd, and the world's leading authority on the world's leading RTOS.
+
+    http://www.FreeRTOS.org/plus - A selection of FreeRTOS ecosystem products,
+    including FreeRTOS+Trace - an indispensable productivity tool, a DOS
+    compatible FAT file system, and our tiny thread aware UDP/IP stack.
+
+    http://www.FreeRTOS.org/labs - Where new FreeRTOS products go to incubate.
+    Come and try FreeRTOS+TCP, our new open source TCP/IP stack for FreeRTOS.
+
+    http://www.OpenRTOS.com - Real Time Engineers ltd. license FreeRTOS to High
+    Integrity Systems ltd. to sell under the OpenRTOS brand.  Low cost OpenRTOS
+    licenses offer ticketed support, indemnification and commercial middleware.
+
+    http://www.SafeRTOS.com - High Integrity Systems also provide a safety
+    engineered and independently SIL3 certified version for use in safety and
+    mission critical applications that require provable dependability.
+
+    1 tab == 4 spaces!
+*/
+
+/* Standard includes. */
+#include <stdint.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "pool.h"
+
+/* Lint e961 and e750 are suppressed as a MISRA exception justified because the
+MPU ports require MPU_WRAPPERS_INCLUDED_FROM_API_FILE to be defined for the
+header files above, but not in this file, in order to generate the correct
+privileged Vs unprivileged linkage and placement. */
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE /*lint !e961 !e750. */
+
+/* The size of the pool structure, rounded up so the first block that follows
+it is aligned. */
+#define poolHEADER_SIZE		( ( sizeof( Pool_t ) + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/* A free block holds the link to the next free block in its first word. */
+typedef struct PoolFreeBlock
+{
+	struct PoolFreeBlock *pxNext;
+} PoolFreeBlock_t;
+
+/* Structures used by memory pools. */
+typedef struct xMEMORY_POOL /*lint !e9058 Style convention uses tag. */
+{
+	PoolFreeBlock_t *pxFreeBlocks;		/* The first free block, or NULL if the pool is empty. */
+	uint8_t *pucBlocks;					/* The first block of the pool's storage. */
+	uint8_t *pucBlocksEnd;				/* One past the last block of the pool's storage. */
+	size_t xBlockSize;					/* The size of each block, after rounding up. */
+	UBaseType_t uxFreeBlocks;			/* The number of blocks on the free list. */
+	UBaseType_t uxMinimumFreeBlocks;	/* The fewest blocks there have been on the free list. */
+} Pool_t;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	PoolHandle_t xPoolCreate( size_t xBlockSize, UBaseType_t uxBlocks )
+	{
+	Pool_t *pxPool;
+	uint8_t *pucBlock;
+	PoolFreeBlock_t **ppxLink;
+	UBaseType_t ux;
+
+		configASSERT( uxBlocks > ( UBaseType_t ) 0 );
+
+		/* Each block has to hold the free list link while it is free, and
+		has to start on an aligned address. */
+		if( xBlockSize < sizeof( PoolFreeBlock_t ) )
+		{
+			xBlockSize = sizeof( PoolFreeBlock_t );
+		}
+		xBlockSize = ( xBlockSize + ( size_t ) portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+		/* The Pool_t structure is placed at the start of the allocated memory
+		and the blocks follow it. */
+		pxPool = ( Pool_t * ) pvPortMalloc( poolHEADER_SIZE + ( xBlockSize * ( size_t ) uxBlocks ) ); /*lint !e9079 malloc() only returns void*. */
+
+		if( pxPool != NULL )
+		{
+			pxPool->pucBlocks = ( ( uint8_t * ) pxPool ) + poolHEADER_SIZE;
+			pxPool->pucBlocksEnd = pxPool->pucBlocks + ( xBlockSize * ( size_t ) uxBlocks );
+			pxPool->xBlockSize = xBlockSize;
+			pxPool->uxFreeBlocks = uxBlocks;
+			pxPool->uxMinimumFreeBlocks = uxBlocks;
+
+			/* Link the blocks in address order, so a pool that is only lightly
+			used keeps handing out the same few blocks. */
+			ppxLink = &( pxPool->pxFreeBlocks );
+			pucBlock = pxPool->pucBlocks;
+			for( ux = ( UBaseType_t ) 0; ux < uxBlocks; ux++ )
+			{
+				*ppxLink = ( PoolFreeBlock_t * ) pucBlock; /*lint !e826 !e9087 Blocks are aligned and at least as large as the link. */
+				ppxLink = &( ( *ppxLink )->pxNext );
+				pucBlock += xBlockSize;
+			}
+			*ppxLink = NULL;
+
+			traceMEMORY_POOL_CREATE( pxPool );
+		}
+		else
+		{
+			traceMEMORY_POOL_CREATE_FAILED();
+		}
+
+		return ( PoolHandle_t ) pxPool;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+void vPoolDelete( PoolHandle_t xPool )
+{
+Pool_t * const pxPool = ( Pool_t * ) xPool;
+
+	configASSERT( pxPool );
+
+	traceMEMORY_POOL_DELETE( xPool );
+
+	/* The structure and the blocks were allocated using a single call to
+	pvPortMalloc(), hence only one call to vPortFree() is required. */
+	vPortFree( ( void * ) pxPool ); /*lint !e9087 Standard free() semantics require void *, plus pxPool was allocated by pvPortMalloc(). */
+}
+/*-----------------------------------------------------------*/
+
+void *pvPoolAlloc( PoolHandle_t xPool )
+{
+Pool_t * const pxPool = ( Pool_t * ) xPool;
+PoolFreeBlock_t *pxBlock;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxPool );
+
+	/* Only the head of the free list changes, so interrupts are held off for
+	no longer than it takes to unlink it.  The interrupt mask is used rather
+	than a critical section so the same call serves tasks and interrupts. */
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		pxBlock = pxPool->pxFreeBlocks;
+
+		if( pxBlock != NULL )
+		{
+			pxPool->pxFreeBlocks = pxBlock->pxNext;
+			pxPool->uxFreeBlocks--;
+
+			if( pxPool->uxFreeBlocks < pxPool->uxMinimumFreeBlocks )
+			{
+				pxPool->uxMinimumFreeBlocks = pxPool->uxFreeBlocks;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	traceMEMORY_POOL_ALLOC( xPool, pxBlock );
+
+	return ( void * ) pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+void vPoolFree( PoolHandle_t xPool, void *pv )
+{
+Pool_t * const pxPool = ( Pool_t * ) xPool;
+PoolFreeBlock_t * const pxBlock = ( PoolFreeBlock_t * ) pv;
+UBaseType_t uxSavedInterruptStatus;
+
+	configASSERT( pxPool );
+
+	if( pxBlock != NULL )
+	{
+		/* The block must be one of this pool's, on a block boundary. */
+		configASSERT( xPoolContains( xPool, pv ) != pdFALSE );
+		configASSERT( ( ( size_t ) ( ( uint8_t * ) pv - pxPool->pucBlocks ) % pxPool->xBlockSize ) == ( size_t ) 0 );
+
+		traceMEMORY_POOL_FREE( xPool, pv );
+
+		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		{
+			pxBlock->pxNext = pxPool->pxFreeBlocks;
+			pxPool->pxFreeBlocks = pxBlock;
+			pxPool->uxFreeBlocks++;
+		}
+		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPoolContains( PoolHandle_t xPool, const void *pv )
+{
+const Pool_t * const pxPool = ( Pool_t * ) xPool;
+BaseType_t xReturn;
+
+	configASSERT( pxPool );
+
+	/* The storage never moves, so no critical section is needed. */
+	if( ( ( const uint8_t * ) pv >= pxPool->pucBlocks ) && ( ( const uint8_t * ) pv < pxPool->pucBlocksEnd ) )
+	{
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPoolGetFreeBlocks( PoolHandle_t xPool )
+{
+const Pool_t * const pxPool = ( Pool_t * ) xPool;
+
+	configASSERT( pxPool );
+
+	return pxPool->uxFreeBlocks;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPoolGetMinimumEverFreeBlocks( PoolHandle_t xPool )
+{
+const Pool_t * const pxPool = ( Pool_t * ) xPool;
+
+	configASSERT( pxPool );
+
+	return pxPool->uxMinimumFreeBlocks;
+}
+/*-----------------------------------------------------------*/
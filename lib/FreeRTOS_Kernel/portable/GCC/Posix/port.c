@@ -54,74 +54,282 @@
  * Implementation of functions defined in portable.h for the Posix port.
  *----------------------------------------------------------*/
 
+#ifndef _GNU_SOURCE
+#define _GNU_SOURCE		/* cpu_set_t and pthread_setaffinity_np() */
+#endif
+
 #include <pthread.h>
 #include <sched.h>
 #include <signal.h>
 #include <errno.h>
-#include <sys/time.h>
+#include <semaphore.h>
 #include <time.h>
-#include <sys/times.h>
 #include <stdlib.h>
+#include <string.h>
 #include <stdio.h>
 #include <unistd.h>
 #include <limits.h>
+#include <sys/mman.h>
+#include <setjmp.h>
 
 /* Scheduler includes. */
 #include "FreeRTOS.h"
 #include "task.h"
+#include "pool.h"
 /*-----------------------------------------------------------*/
 
-#define MAX_NUMBER_OF_TASKS 		( _POSIX_THREAD_THREADS_MAX )
-/*-----------------------------------------------------------*/
-
-/* Parameters to pass to the newly created pthread. */
-typedef struct XPARAMS
-{
-	pdTASK_CODE pxCode;
-	void *pvParams;
-} xParams;
-
-/* Each task maintains its own interrupt status in the critical nesting variable. */
+/* Each task maintains its own interrupt status in the critical nesting variable.
+The state is allocated per task and pxPortInitialiseStack() returns it as the
+task's top of stack, which tasks.c stores as the first member of the TCB. Going
+from a task handle to its thread is therefore a single dereference, whatever the
+number of tasks. */
 typedef struct THREAD_SUSPENSIONS
 {
 	pthread_t hThread;
-	xTaskHandle hTask;
+	pdTASK_CODE pxCode;
+	void *pvParams;
 	unsigned portBASE_TYPE uxCriticalNesting;
+	/* Set once the thread has left the task's code and is parked. */
+	volatile portBASE_TYPE xExited;
+	/* Set when the task is deleted, the thread then leaves the task's code
+	through xParkContext. */
+	volatile portBASE_TYPE xDeleted;
+	sigjmp_buf xParkContext;
+	pthread_cond_t hParkCondition;
+	struct THREAD_SUSPENSIONS *pxNextPooled;
+	/* The thread's CPU time when it was handed the task. */
+	unsigned long long ullCpuTimeBase;
+	/* The SCHED_FIFO priority last given to the thread, 0 if none. */
+	int iHostPriority;
+#if ( portUSE_HOST_THREAD_STACKS == 1 )
+	/* The stack mapped for the thread, guard page included, and where the
+	task's own use of it starts. */
+	unsigned char *pucStack;
+	size_t xStackSize;
+	unsigned char * volatile pucStackStart;
+	uint32_t ulStackDepth;
+#endif
+	struct THREAD_SUSPENSIONS *pxPrevious;
+	struct THREAD_SUSPENSIONS *pxNext;
+#if ( portUSE_CONDVAR_SWITCH == 1 )
+	/* The thread sleeps on its own condition variable until it is handed the
+	processor, so only the successor is woken on a switch. */
+	pthread_cond_t hRunCondition;
+	volatile portBASE_TYPE xRunning;
+#endif
 } xThreadState;
+
+#define prvGetThreadState( hTask )	( *( xThreadState * volatile * )( hTask ) )
+
+#define portTICK_PERIOD_NANOSECONDS	( 1000000000ULL / configTICK_RATE_HZ )
 /*-----------------------------------------------------------*/
 
-static xThreadState *pxThreads;
+static xThreadState *pxThreadList = NULL;
 static pthread_once_t hSigSetupThread = PTHREAD_ONCE_INIT;
-static pthread_attr_t xThreadAttributes;
 static pthread_mutex_t xSuspendResumeThreadMutex = PTHREAD_MUTEX_INITIALIZER;
 static pthread_mutex_t xSingleThreadMutex = PTHREAD_MUTEX_INITIALIZER;
 static pthread_t hMainThread = ( pthread_t )NULL;
+static __thread xThreadState *pxThisThread = NULL;
+
+/* Threads of deleted tasks, parked until a task with the same stack size is
+created. */
+static xThreadState *pxThreadPool = NULL;
+
+/* Blocks for the states of the first portTHREAD_STATE_BLOCKS threads, those of
+any more threads come from pvPortMalloc(). */
+static PoolHandle_t xThreadStatePool = NULL;
+static pthread_once_t hThreadStatePoolOnce = PTHREAD_ONCE_INIT;
+static unsigned portBASE_TYPE uxPooledThreads = 0;
+static pthread_mutex_t xThreadPoolMutex = PTHREAD_MUTEX_INITIALIZER;
+static unsigned long long ullRunTimeStart = 0;
+static pthread_t hTickThread;
+static pthread_mutex_t xTickMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t xTickCondition;
+static pthread_t hSleepingThread;
 /*-----------------------------------------------------------*/
 
 static volatile portBASE_TYPE xSentinel = 0;
 static volatile portBASE_TYPE xSchedulerEnd = pdFALSE;
-static volatile portBASE_TYPE xInterruptsEnabled = pdTRUE;
 static volatile portBASE_TYPE xServicingTick = pdFALSE;
-static volatile portBASE_TYPE xPendYield = pdFALSE;
-static volatile portLONG lIndexOfLastAddedTask = 0;
-static volatile unsigned portBASE_TYPE uxCriticalNesting;
+
+/* The interrupt mask and critical nesting of the running task. Only the running
+task's thread changes them, and the tick and interrupt handlers that read them
+are passed on to that thread, so they need ordering against signal handlers but
+not against other CPUs. Relaxed atomics with signal fences give that without a
+barrier. The next thread takes them over under xSingleThreadMutex. xPendYield
+can be set from any thread and is taken with an exchange. */
+static portBASE_TYPE xInterruptsEnabled = pdTRUE;
+static unsigned portBASE_TYPE uxCriticalNesting;
+static portBASE_TYPE xPendYield = pdFALSE;
+
+/* Set while a signal handler on this thread is switching to another task. */
+static __thread portBASE_TYPE xSwitchingFromHandler = pdFALSE;
+
+/* Ticks raised by the tick thread that the tick handler has not processed yet.
+The signal only says that there is work, so ticks are never lost when signals
+coalesce or the handler has to back off. */
+static volatile unsigned portBASE_TYPE uxPendingTicks = 0;
+static volatile unsigned long ulLateTicks = 0;
+static volatile unsigned long ulDeferredTicks = 0;
+static volatile unsigned long ulReplayedTicks = 0;
+static volatile unsigned long ulWakeUps = 0;
+static volatile unsigned long ulMaxWakeLatencyNs = 0;
+static volatile unsigned long long ullWakeLatencyNs = 0;
+
+/* The tick thread's time line, guarded by xTickMutex. While tickless idle
+sleeps, ullSleepUntilTick is the only tick that is raised. */
+static struct timespec xTickStart;
+static unsigned long long ullTicksRaised = 0;
+static unsigned long long ullSleepUntilTick = 0;
+static volatile portBASE_TYPE xSleeping = pdFALSE;
+
+/* How emulated time relates to the host's, chosen before the scheduler starts.
+In fast-forward mode each tick is raised as soon as the previous one has been
+processed, xTickProcessed is posted by the tick interrupt to say so. */
+static ePortTimeMode eTimeMode = eRealTime;
+static unsigned long ulTimeScale = 1;
+static unsigned long long ullTickPeriodNs = portTICK_PERIOD_NANOSECONDS;
+static sem_t xTickProcessed;
+
+/* How the host schedules the emulator's threads. xHostRealTime is only set once
+SCHED_FIFO has actually been granted. */
+static ePortHostScheduling eHostScheduling = eHostNormal;
+static portBASE_TYPE xHostRealTime = pdFALSE;
+static portBASE_TYPE xHostCpusSet = pdFALSE;
+static cpu_set_t xHostCpus;
+static int iHostTickPriority = 0;
+static int iHostTaskPriorityBase = 0;
+
+#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 ) && ( portPRIORITY_GROUPS > 1 )
+/* The second level of the ready priority bit map, see portmacro.h. */
+uint32_t ulPortReadyPriorities[ portPRIORITY_GROUPS ] = { 0 };
+#endif
+
+/* The simulated interrupt controller. A line is pending while ullRaisedAt holds
+the time it was raised, ullPendingIrqs only tells the dispatcher where to look.
+The dispatcher runs on the running task's thread, uxIsrPriority is the priority
+of the handler it is in, 0 when it interrupted the task itself. */
+typedef struct IRQ_LINE
+{
+	xPortIrqHandler pxHandler;
+	void *pvParameter;
+	unsigned portBASE_TYPE uxPriority;
+	volatile unsigned long long ullRaisedAt;
+	xPortIrqStats xStats;
+} xIrqLine;
+
+static xIrqLine xIrqLines[ portMAX_IRQS ];
+static volatile unsigned long long ullPendingIrqs = 0;
+static volatile unsigned long long ullEnabledIrqs = 0;
+static volatile portBASE_TYPE xSchedulerStarted = pdFALSE;
+static __thread unsigned portBASE_TYPE uxIsrPriority = 0;
+static __thread unsigned portBASE_TYPE uxIsrNesting = 0;
+
+#if ( portMAX_IRQS > 64 )
+	#error portMAX_IRQS can be at most 64
+#endif
+
+static inline portBASE_TYPE prvInterruptsEnabled( void )
+{
+	return __atomic_load_n( &xInterruptsEnabled, __ATOMIC_RELAXED );
+}
+
+static inline void prvSetInterruptsEnabled( portBASE_TYPE xEnabled )
+{
+	if ( pdFALSE == xEnabled )
+	{
+		__atomic_store_n( &xInterruptsEnabled, pdFALSE, __ATOMIC_RELAXED );
+		/* Nothing that follows may be done before interrupts are masked... */
+		__atomic_signal_fence( __ATOMIC_SEQ_CST );
+	}
+	else
+	{
+		/* ...or after they are unmasked. */
+		__atomic_signal_fence( __ATOMIC_SEQ_CST );
+		__atomic_store_n( &xInterruptsEnabled, xEnabled, __ATOMIC_RELAXED );
+	}
+}
+
+static inline unsigned portBASE_TYPE prvCriticalNesting( void )
+{
+	return __atomic_load_n( &uxCriticalNesting, __ATOMIC_RELAXED );
+}
+
+static inline void prvSetCriticalNesting( unsigned portBASE_TYPE uxNesting )
+{
+	__atomic_store_n( &uxCriticalNesting, uxNesting, __ATOMIC_RELAXED );
+}
+
+static inline void prvPendYield( void )
+{
+	__atomic_store_n( &xPendYield, pdTRUE, __ATOMIC_RELAXED );
+}
+
+static inline portBASE_TYPE prvYieldPending( void )
+{
+	return __atomic_load_n( &xPendYield, __ATOMIC_RELAXED );
+}
+
+static inline portBASE_TYPE prvTakePendingYield( void )
+{
+	/* Only pay for the exchange when a yield is pending. */
+	if ( pdFALSE == __atomic_load_n( &xPendYield, __ATOMIC_RELAXED ) )
+	{
+		return pdFALSE;
+	}
+	return __atomic_exchange_n( &xPendYield, pdFALSE, __ATOMIC_RELAXED );
+}
+
+#if ( portUSE_HOST_THREAD_STACKS == 1 ) && ( portHOST_PREFAULT_STACK_SIZE >= portHOST_MINIMAL_STACK_SIZE )
+	#error portHOST_PREFAULT_STACK_SIZE must leave room on the smallest host thread stack
+#endif
 /*-----------------------------------------------------------*/
 
 /*
  * Setup the timer to generate the tick interrupts.
  */
 static void prvSetupTimerInterrupt( void );
+static void *prvTickThread( void *pvParams );
+static void prvTickToTimespec( unsigned long long ullTick, struct timespec *pxTime );
+static unsigned long long prvTicksElapsed( void );
+static void prvRaiseElapsedTicks( void );
+static void prvReadTimeModeFromEnvironment( void );
+static void prvReadHostSchedulingFromEnvironment( void );
+static portBASE_TYPE prvParseCpuList( const char *pcCpus, cpu_set_t *pxCpus );
+static void prvSetupHostScheduling( void );
+static void prvFollowTaskPriority( xThreadState *pxThread );
+static void prvPrefaultStack( void ) __attribute__(( noinline ));
+#if ( portUSE_HOST_THREAD_STACKS == 1 )
+static size_t prvHostStackSize( uint32_t ulStackDepth );
+static size_t prvStackBytesUsed( xThreadState *pxThread );
+static void prvScrubStack( xThreadState *pxThread ) __attribute__(( noinline ));
+#endif
+static xThreadState *prvTakePooledThread( size_t xStackSize );
+static void prvCreateThreadStatePool( void );
+static xThreadState *prvAllocateThreadState( void );
+static void prvFreeThreadState( xThreadState *pxThread );
+static portBASE_TYPE prvParkThread( xThreadState *pxThread );
+static void prvRunTask( xThreadState *pxThread, const sigset_t *pxTaskSignals ) __attribute__(( noinline ));
+static void prvUnlockThreadPoolMutex( void *pvUnused );
+static unsigned long long prvClockNanoseconds( clockid_t xClock );
+static void prvProcessPendingTicks( void );
+static void prvIrqSignalHandler( int sig );
+static void prvDispatchIrqs( void );
+static int prvHighestPendingIrq( unsigned portBASE_TYPE uxAbove, portBASE_TYPE xKernelAvailable );
+static void prvSignalIrq( void );
+static inline void prvRaisePendingIrqs( void );
 static void *prvWaitForStart( void * pvParams );
 static void prvSuspendSignalHandler(int sig);
 static void prvResumeSignalHandler(int sig);
 static void prvSetupSignalsAndSchedulerPolicy( void );
-static void prvSuspendThread( pthread_t xThreadId );
-static void prvResumeThread( pthread_t xThreadId );
-static pthread_t prvGetThreadHandle( xTaskHandle hTask );
-static portLONG prvGetFreeThreadState( void );
-static void prvSetTaskCriticalNesting( pthread_t xThreadId, unsigned portBASE_TYPE uxNesting );
-static unsigned portBASE_TYPE prvGetTaskCriticalNesting( pthread_t xThreadId );
-static void prvDeleteThread( void *xThreadId );
+static void prvSuspendThread( xThreadState *pxThread );
+static void prvResumeThread( xThreadState *pxThread );
+static void prvSwitchThread( xThreadState *pxThreadToSuspend, xThreadState *pxThreadToResume );
+static void prvLinkThread( xThreadState *pxThread );
+static void prvUnlinkThread( xThreadState *pxThread );
+#if ( portUSE_CONDVAR_SWITCH == 1 )
+static void prvUnlockSingleThreadMutex( void *pvUnused );
+#endif
 /*-----------------------------------------------------------*/
 
 /*
@@ -136,13 +344,148 @@ void vPortSystemTickHandler( int sig );
 void vPortStartFirstTask( void );
 /*-----------------------------------------------------------*/
 
+#if ( portUSE_HOST_THREAD_STACKS == 1 )
+
+size_t prvHostStackSize( uint32_t ulStackDepth )
+{
+size_t xSize = ( size_t )ulStackDepth * sizeof( portSTACK_TYPE ) * portHOST_STACK_SCALE;
+size_t xPageSize = ( size_t )sysconf( _SC_PAGESIZE );
+
+	if ( xSize < portHOST_MINIMAL_STACK_SIZE )
+	{
+		xSize = portHOST_MINIMAL_STACK_SIZE;
+	}
+	if ( xSize < PTHREAD_STACK_MIN )
+	{
+		xSize = PTHREAD_STACK_MIN;
+	}
+	return ( xSize + xPageSize - 1 ) & ~( xPageSize - 1 );
+}
+/*-----------------------------------------------------------*/
+
+size_t prvStackBytesUsed( xThreadState *pxThread )
+{
+/* Pages of the stack that were never touched are not resident, and they read
+as zero when they are (mlockall() without MCL_ONFAULT, or the prefault), so the
+deepest byte the task used is the lowest non-zero one. A zero the task wrote at
+the very bottom isn't seen, which can only make the estimate a little low. */
+size_t xPageSize = ( size_t )sysconf( _SC_PAGESIZE );
+unsigned char *pucBottom = pxThread->pucStack + xPageSize;
+unsigned char *pucStart = pxThread->pucStackStart;
+unsigned char *pucPage;
+unsigned char ucResident[ 64 ];
+size_t xPage = sizeof( ucResident );
+size_t xOffset;
+
+	if ( NULL == pucStart )
+	{
+		/* The thread hasn't started yet. */
+		return 0;
+	}
+
+	for ( pucPage = pucBottom; pucPage < pucStart; pucPage += xPageSize, xPage++ )
+	{
+		/* Residency is asked for a batch of pages at a time, the last batch
+		can go past the task's part of the stack but not past the mapping. */
+		if ( sizeof( ucResident ) == xPage )
+		{
+			xPage = 0;
+			if ( 0 != mincore( pucPage, sizeof( ucResident ) * xPageSize < ( size_t )( pucStart - pucPage ) ? sizeof( ucResident ) * xPageSize : ( size_t )( pucStart - pucPage ), ucResident ) )
+			{
+				memset( ucResident, 1, sizeof( ucResident ) );
+			}
+		}
+		if ( 0 == ( ucResident[ xPage ] & 1 ) )
+		{
+			continue;
+		}
+
+		/* Whole words are compared first, the page is word aligned. */
+		for ( xOffset = 0; ( xOffset < xPageSize ) && ( pucPage + xOffset < pucStart ); xOffset += sizeof( uintptr_t ) )
+		{
+			if ( 0 != *( uintptr_t * )( pucPage + xOffset ) )
+			{
+				while ( 0 == pucPage[ xOffset ] )
+				{
+					xOffset++;
+				}
+				if ( pucPage + xOffset < pucStart )
+				{
+					return ( size_t )( pucStart - ( pucPage + xOffset ) );
+				}
+				return 0;
+			}
+		}
+	}
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetStackBytesUsed( void *pxTask )
+{
+	return prvStackBytesUsed( prvGetThreadState( pxTask ) );
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxPortGetStackHighWaterMark( void *pxTCB )
+{
+xThreadState *pxThread = prvGetThreadState( pxTCB );
+size_t xTargetBytes = sizeof( portSTACK_TYPE ) * portHOST_STACK_SCALE;
+size_t xUsedWords = ( prvStackBytesUsed( pxThread ) + xTargetBytes - 1 ) / xTargetBytes;
+
+	if ( xUsedWords >= pxThread->ulStackDepth )
+	{
+		return 0;
+	}
+	return ( unsigned portBASE_TYPE )( pxThread->ulStackDepth - xUsedWords );
+}
+/*-----------------------------------------------------------*/
+
+void prvScrubStack( xThreadState *pxThread )
+{
+/* Called by a thread that is about to be parked. The pages the task used are
+given back to the host, so parked threads hold no more memory than new ones and
+the stack reads as zero again for the next task's high water mark. Everything
+from a little below this function's frame down is unused. */
+size_t xPageSize = ( size_t )sysconf( _SC_PAGESIZE );
+unsigned char *pucBottom = pxThread->pucStack + xPageSize;
+unsigned char *pucLimit = ( unsigned char * )__builtin_frame_address( 0 ) - 512;
+unsigned char *pucPage = ( unsigned char * )( ( uintptr_t )pucLimit & ~( ( uintptr_t )xPageSize - 1 ) );
+
+	if ( 0 != madvise( pucBottom, ( size_t )( pucPage - pucBottom ), MADV_DONTNEED ) )
+	{
+		/* Locked memory can't be given back, only what was used is cleared. */
+		pucPage = pxThread->pucStackStart - prvStackBytesUsed( pxThread );
+	}
+	if ( pucPage < pucLimit )
+	{
+		memset( pucPage, 0, ( size_t )( pucLimit - pucPage ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+#endif /* portUSE_HOST_THREAD_STACKS */
+
 /*
  * See header file for description.
  */
+#if ( portUSE_HOST_THREAD_STACKS == 1 )
+portSTACK_TYPE *pxPortInitialiseStack( uint32_t ulStackDepth, pdTASK_CODE pxCode, void *pvParameters )
+#else
 portSTACK_TYPE *pxPortInitialiseStack( portSTACK_TYPE *pxTopOfStack, pdTASK_CODE pxCode, void *pvParameters )
+#endif
 {
-/* Should actually keep this struct on the stack. */
-xParams *pxThisThreadParams = pvPortMalloc( sizeof( xParams ) );
+xThreadState *pxThread;
+pthread_attr_t xThreadAttributes;
+clockid_t xThreadClock;
+struct sched_param xParam;
+int iPolicy;
+#if ( portUSE_HOST_THREAD_STACKS == 1 )
+size_t xPageSize = ( size_t )sysconf( _SC_PAGESIZE );
+size_t xStackSize = prvHostStackSize( ulStackDepth ) + xPageSize;
+#else
+size_t xStackSize = 0;
+#endif
 
 	(void)pthread_once( &hSigSetupThread, prvSetupSignalsAndSchedulerPolicy );
 
@@ -151,48 +494,214 @@ xParams *pxThisThreadParams = pvPortMalloc( sizeof( xParams ) );
 		hMainThread = pthread_self();
 	}
 
-	/* No need to join the threads. */
-	pthread_attr_init( &xThreadAttributes );
-	pthread_attr_setdetachstate( &xThreadAttributes, PTHREAD_CREATE_DETACHED );
+	/* A thread left by a deleted task is handed the new one. The CPU time it
+	used so far isn't the new task's. */
+	pxThread = prvTakePooledThread( xStackSize );
+	if ( NULL != pxThread )
+	{
+		pxThread->ullCpuTimeBase = 0;
+		if ( 0 == pthread_getcpuclockid( pxThread->hThread, &xThreadClock ) )
+		{
+			pxThread->ullCpuTimeBase = prvClockNanoseconds( xThreadClock );
+		}
+
+		/* A new thread would inherit this thread's host priority, without it
+		the parked one might not get a CPU for the hand-over below. */
+		if ( ( pdTRUE == xHostRealTime ) && ( 0 == pthread_getschedparam( pthread_self(), &iPolicy, &xParam ) ) )
+		{
+			(void)pthread_setschedparam( pxThread->hThread, iPolicy, &xParam );
+			pxThread->iHostPriority = xParam.sched_priority;
+		}
+	}
+	else
+	{
+		pxThread = prvAllocateThreadState();
+#if ( portUSE_HOST_THREAD_STACKS == 1 )
+		/* The task runs on this stack, not one from the FreeRTOS heap. It is
+		mapped here rather than by the C library to put a guard page below it
+		and to measure its high water mark. */
+		pxThread->xStackSize = xStackSize;
+		pxThread->pucStack = mmap( NULL, xStackSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0 );
+		if ( MAP_FAILED == pxThread->pucStack )
+		{
+			printf( "Task stack allocation failed.\n" );
+			prvFreeThreadState( pxThread );
+			return 0;
+		}
+		(void)mprotect( pxThread->pucStack, xPageSize, PROT_NONE );
+		pxThread->pucStackStart = NULL;
+#endif
+		pxThread->xExited = pdFALSE;
+		pxThread->ullCpuTimeBase = 0;
+		pxThread->iHostPriority = 0;
+		(void)pthread_cond_init( &pxThread->hParkCondition, NULL );
+#if ( portUSE_CONDVAR_SWITCH == 1 )
+		(void)pthread_cond_init( &pxThread->hRunCondition, NULL );
+#endif
+	}
 
 	/* Add the task parameters. */
-	pxThisThreadParams->pxCode = pxCode;
-	pxThisThreadParams->pvParams = pvParameters;
+	pxThread->pxCode = pxCode;
+	pxThread->pvParams = pvParameters;
+	pxThread->uxCriticalNesting = 0;
+	pxThread->xDeleted = pdFALSE;
+#if ( portUSE_HOST_THREAD_STACKS == 1 )
+	pxThread->ulStackDepth = ulStackDepth;
+#endif
+#if ( portUSE_CONDVAR_SWITCH == 1 )
+	pxThread->xRunning = pdFALSE;
+#endif
 
 	vPortEnterCritical();
 
-	lIndexOfLastAddedTask = prvGetFreeThreadState();
-
-	/* Create the new pThread. */
 	if ( 0 == pthread_mutex_lock( &xSingleThreadMutex ) )
 	{
 		xSentinel = 0;
-		if ( 0 != pthread_create( &( pxThreads[ lIndexOfLastAddedTask ].hThread ), &xThreadAttributes, prvWaitForStart, (void *)pxThisThreadParams ) )
+		if ( pdTRUE == pxThread->xExited )
+		{
+			/* Unpark the thread. */
+			(void)pthread_mutex_lock( &xThreadPoolMutex );
+			pxThread->xExited = pdFALSE;
+			(void)pthread_cond_broadcast( &pxThread->hParkCondition );
+			(void)pthread_mutex_unlock( &xThreadPoolMutex );
+		}
+		else
 		{
-			/* Thread create failed, signal the failure */
-			pxTopOfStack = 0;
+			/* Create the new pThread. It is joined when it ends, which it only
+			does when the pool is full. */
+			pthread_attr_init( &xThreadAttributes );
+#if ( portUSE_HOST_THREAD_STACKS == 1 )
+			(void)pthread_attr_setstack( &xThreadAttributes, pxThread->pucStack + xPageSize, xStackSize - xPageSize );
+#endif
+			if ( 0 != pthread_create( &pxThread->hThread, &xThreadAttributes, prvWaitForStart, (void *)pxThread ) )
+			{
+				/* Thread create failed, signal the failure */
+				printf( "Task thread creation failed.\n" );
+				(void)pthread_mutex_unlock( &xSingleThreadMutex );
+				vPortExitCritical();
+				pthread_attr_destroy( &xThreadAttributes );
+				(void)pthread_cond_destroy( &pxThread->hParkCondition );
+#if ( portUSE_CONDVAR_SWITCH == 1 )
+				(void)pthread_cond_destroy( &pxThread->hRunCondition );
+#endif
+#if ( portUSE_HOST_THREAD_STACKS == 1 )
+				(void)munmap( pxThread->pucStack, pxThread->xStackSize );
+#endif
+				prvFreeThreadState( pxThread );
+				return 0;
+			}
+			pthread_attr_destroy( &xThreadAttributes );
+
+			prvLinkThread( pxThread );
 		}
 
-		/* Wait until the task suspends. */
+		/* Wait until the task suspends. Under SCHED_FIFO the new thread only
+		gets a CPU that this one shares if this one gives it up. */
 		(void)pthread_mutex_unlock( &xSingleThreadMutex );
-		while ( xSentinel == 0 );
+		while ( xSentinel == 0 )
+		{
+			sched_yield();
+		}
 		vPortExitCritical();
 	}
 
-	return pxTopOfStack;
+#if ( portUSE_HOST_THREAD_STACKS == 0 )
+	( void )pxTopOfStack;
+#endif
+	return ( portSTACK_TYPE * )pxThread;
+}
+/*-----------------------------------------------------------*/
+
+xThreadState *prvTakePooledThread( size_t xStackSize )
+{
+xThreadState *pxThread;
+xThreadState **ppxLink;
+
+	/* Not to be preempted by the tick while holding the mutex. */
+	vPortEnterCritical();
+	(void)pthread_mutex_lock( &xThreadPoolMutex );
+	for ( ppxLink = &pxThreadPool; NULL != *ppxLink; ppxLink = &( *ppxLink )->pxNextPooled )
+	{
+#if ( portUSE_HOST_THREAD_STACKS == 1 )
+		if ( ( *ppxLink )->xStackSize == xStackSize )
+#endif
+		{
+			break;
+		}
+	}
+	pxThread = *ppxLink;
+	if ( NULL != pxThread )
+	{
+		*ppxLink = pxThread->pxNextPooled;
+		uxPooledThreads--;
+	}
+	(void)pthread_mutex_unlock( &xThreadPoolMutex );
+	vPortExitCritical();
+
+#if ( portUSE_HOST_THREAD_STACKS == 0 )
+	( void )xStackSize;
+#endif
+	return pxThread;
+}
+/*-----------------------------------------------------------*/
+
+void prvCreateThreadStatePool( void )
+{
+	xThreadStatePool = xPoolCreate( sizeof( xThreadState ), portTHREAD_STATE_BLOCKS );
+}
+/*-----------------------------------------------------------*/
+
+xThreadState *prvAllocateThreadState( void )
+{
+xThreadState *pxThread = NULL;
+
+	(void)pthread_once( &hThreadStatePoolOnce, prvCreateThreadStatePool );
+	if ( NULL != xThreadStatePool )
+	{
+		pxThread = pvPoolAlloc( xThreadStatePool );
+	}
+	if ( NULL == pxThread )
+	{
+		pxThread = pvPortMalloc( sizeof( xThreadState ) );
+	}
+	return pxThread;
+}
+/*-----------------------------------------------------------*/
+
+void prvFreeThreadState( xThreadState *pxThread )
+{
+	if ( ( NULL != xThreadStatePool ) && ( pdFALSE != xPoolContains( xThreadStatePool, pxThread ) ) )
+	{
+		vPoolFree( xThreadStatePool, pxThread );
+	}
+	else
+	{
+		vPortFree( pxThread );
+	}
 }
 /*-----------------------------------------------------------*/
 
 void vPortStartFirstTask( void )
 {
 	/* Initialise the critical nesting count ready for the first task. */
-	uxCriticalNesting = 0;
+	prvSetCriticalNesting( 0 );
 
 	/* Start the first task. */
 	vPortEnableInterrupts();
 
 	/* Start the first task. */
-	prvResumeThread( prvGetThreadHandle( xTaskGetCurrentTaskHandle() ) );
+	xSchedulerStarted = pdTRUE;
+	prvFollowTaskPriority( prvGetThreadState( xTaskGetCurrentTaskHandle() ) );
+#if ( portUSE_CONDVAR_SWITCH == 1 )
+	/* The hand-off is made under the mutex that the task threads wait on. */
+	if ( 0 == pthread_mutex_lock( &xSingleThreadMutex ) )
+	{
+		prvResumeThread( prvGetThreadState( xTaskGetCurrentTaskHandle() ) );
+		(void)pthread_mutex_unlock( &xSingleThreadMutex );
+	}
+#else
+	prvResumeThread( prvGetThreadState( xTaskGetCurrentTaskHandle() ) );
+#endif
 }
 /*-----------------------------------------------------------*/
 
@@ -206,7 +715,6 @@ int iSignal;
 sigset_t xSignals;
 sigset_t xSignalToBlock;
 sigset_t xSignalsBlocked;
-portLONG lIndex;
 
 	/* Establish the signals to block before they are needed. */
 	sigfillset( &xSignalToBlock );
@@ -214,10 +722,8 @@ portLONG lIndex;
 	/* Block until the end */
 	(void)pthread_sigmask( SIG_SETMASK, &xSignalToBlock, &xSignalsBlocked );
 
-	for ( lIndex = 0; lIndex < MAX_NUMBER_OF_TASKS; lIndex++ )
-	{
-		pxThreads[ lIndex ].uxCriticalNesting = 0;
-	}
+	/* Before the tick thread exists, so that it is created with the result. */
+	prvSetupHostScheduling();
 
 	/* Start the timer that generates the tick ISR.  Interrupts are disabled
 	here already. */
@@ -244,7 +750,6 @@ portLONG lIndex;
 	pthread_mutex_destroy( &xSuspendResumeThreadMutex );
 	/** xResult = pthread_mutex_destroy( &xSingleThreadMutex ); */
 	pthread_mutex_destroy( &xSingleThreadMutex );
-	vPortFree( (void *)pxThreads );
 
 	/* Should not get here! */
 	return 0;
@@ -253,18 +758,17 @@ portLONG lIndex;
 
 void vPortEndScheduler( void )
 {
-portBASE_TYPE xNumberOfThreads;
+xThreadState *pxThread;
 /** portBASE_TYPE xResult; */
-	for ( xNumberOfThreads = 0; xNumberOfThreads < MAX_NUMBER_OF_TASKS; xNumberOfThreads++ )
+	for ( pxThread = pxThreadList; NULL != pxThread; pxThread = pxThread->pxNext )
 	{
-		if ( ( pthread_t )NULL != pxThreads[ xNumberOfThreads ].hThread )
-		{
-			/* Kill all of the threads, they are in the detached state. */
-			pthread_cancel( pxThreads[ xNumberOfThreads ].hThread );
-			/** xResult = pthread_cancel( pxThreads[ xNumberOfThreads ].hThread ); */
-		}
+		/* Kill all of the threads, the parked ones too. */
+		pthread_cancel( pxThread->hThread );
+		/** xResult = pthread_cancel( pxThread->hThread ); */
 	}
 
+	(void)pthread_cancel( hTickThread );
+
 	/* Signal the scheduler to exit its loop. */
 	xSchedulerEnd = pdTRUE;
 	(void)pthread_kill( hMainThread, SIG_RESUME );
@@ -273,68 +777,132 @@ portBASE_TYPE xNumberOfThreads;
 
 void vPortYieldFromISR( void )
 {
+xThreadState *pxThreadToSuspend;
+xThreadState *pxThreadToResume;
+
 	/* Calling Yield from a Interrupt/Signal handler often doesn't work because the
 	 * xSingleThreadMutex is already owned by an original call to Yield. Therefore,
 	 * simply indicate that a yield is required soon.
 	 */
-	xPendYield = pdTRUE;
+	prvPendYield();
+
+	/* An interrupt on another host thread has to wake tickless idle itself. */
+	if ( ( pdTRUE == xSleeping ) && ( 0 == pthread_equal( pthread_self(), hSleepingThread ) ) )
+	{
+		(void)pthread_kill( hSleepingThread, SIG_TICK );
+	}
+
+	/* Inside the interrupt dispatcher the switch is made once the outermost
+	handler has returned. */
+	if ( 0 != uxIsrNesting )
+	{
+		return;
+	}
+
+	/* A handler taken on top of one that switched this thread out, once the
+	 * thread is resumed, only pends the yield. The first handler switches
+	 * again before it returns, so handler frames never pile up on the stack,
+	 * whatever the signal's mask and flags.
+	 */
+	if ( pdTRUE == xSwitchingFromHandler )
+	{
+		return;
+	}
+
+	/* When the signal interrupted the running task outside of a critical
+	 * section and the mutex is free, switch on the way out of the handler
+	 * like the tick does, rather than at the next critical section exit.
+	 */
+	xSwitchingFromHandler = pdTRUE;
+	pxThreadToSuspend = prvGetThreadState( xTaskGetCurrentTaskHandle() );
+	while ( ( pdTRUE == prvYieldPending() ) && ( pdTRUE == prvInterruptsEnabled() ) && ( pdTRUE != xServicingTick ) && ( 0 != pthread_equal( pthread_self(), pxThreadToSuspend->hThread ) ) )
+	{
+		if ( 0 != pthread_mutex_trylock( &xSingleThreadMutex ) )
+		{
+			break;
+		}
+
+		xServicingTick = pdTRUE;
+		(void)prvTakePendingYield();
+
+		vTaskSwitchContext();
+		pxThreadToResume = prvGetThreadState( xTaskGetCurrentTaskHandle() );
+
+		if ( pxThreadToSuspend != pxThreadToResume )
+		{
+#if ( portUSE_CONDVAR_SWITCH == 1 )
+			xServicingTick = pdFALSE;
+#endif
+			prvSwitchThread( pxThreadToSuspend, pxThreadToResume );
+		}
+		else
+		{
+			(void)pthread_mutex_unlock( &xSingleThreadMutex );
+		}
+		xServicingTick = pdFALSE;
+	}
+	xSwitchingFromHandler = pdFALSE;
 }
 /*-----------------------------------------------------------*/
 
 void vPortEnterCritical( void )
 {
-	vPortDisableInterrupts();
-	uxCriticalNesting++;
+	prvSetInterruptsEnabled( pdFALSE );
+	prvSetCriticalNesting( prvCriticalNesting() + 1 );
 }
 /*-----------------------------------------------------------*/
 
 void vPortExitCritical( void )
 {
+unsigned portBASE_TYPE uxNesting = prvCriticalNesting();
+
 	/* Check for unmatched exits. */
-	if ( uxCriticalNesting > 0 )
+	if ( uxNesting > 0 )
 	{
-		uxCriticalNesting--;
+		uxNesting--;
+		prvSetCriticalNesting( uxNesting );
 	}
 
 	/* If we have reached 0 then re-enable the interrupts. */
-	if( uxCriticalNesting == 0 )
+	if( uxNesting == 0 )
 	{
 		/* Have we missed ticks? This is the equivalent of pending an interrupt. */
-		if ( pdTRUE == xPendYield )
+		if ( ( 0 == uxIsrNesting ) && ( pdTRUE == prvTakePendingYield() ) )
 		{
-			xPendYield = pdFALSE;
 			vPortYield();
 		}
 		vPortEnableInterrupts();
+
+		/* Take the ticks that were held off now rather than at the next one. */
+		if ( 0 < __atomic_load_n( &uxPendingTicks, __ATOMIC_RELAXED ) )
+		{
+			(void)pthread_kill( pthread_self(), SIG_TICK );
+		}
 	}
 }
 /*-----------------------------------------------------------*/
 
 void vPortYield( void )
 {
-pthread_t xTaskToSuspend;
-pthread_t xTaskToResume;
+xThreadState *pxThreadToSuspend;
+xThreadState *pxThreadToResume;
 
 	if ( 0 == pthread_mutex_lock( &xSingleThreadMutex ) )
 	{
-		xTaskToSuspend = prvGetThreadHandle( xTaskGetCurrentTaskHandle() );
+		pxThreadToSuspend = prvGetThreadState( xTaskGetCurrentTaskHandle() );
 
 		vTaskSwitchContext();
 
-		xTaskToResume = prvGetThreadHandle( xTaskGetCurrentTaskHandle() );
-		if ( xTaskToSuspend != xTaskToResume )
+		pxThreadToResume = prvGetThreadState( xTaskGetCurrentTaskHandle() );
+		if ( pxThreadToSuspend != pxThreadToResume )
 		{
-			/* Remember and switch the critical nesting. */
-			prvSetTaskCriticalNesting( xTaskToSuspend, uxCriticalNesting );
-			uxCriticalNesting = prvGetTaskCriticalNesting( xTaskToResume );
-			/* Switch tasks. */
-			prvResumeThread( xTaskToResume );
-			prvSuspendThread( xTaskToSuspend );
+			prvSwitchThread( pxThreadToSuspend, pxThreadToResume );
 		}
 		else
 		{
 			/* Yielding to self */
 			(void)pthread_mutex_unlock( &xSingleThreadMutex );
+			prvRaisePendingIrqs();
 		}
 	}
 }
@@ -342,180 +910,1158 @@ pthread_t xTaskToResume;
 
 void vPortDisableInterrupts( void )
 {
-	xInterruptsEnabled = pdFALSE;
+	prvSetInterruptsEnabled( pdFALSE );
 }
 /*-----------------------------------------------------------*/
 
 void vPortEnableInterrupts( void )
 {
-	xInterruptsEnabled = pdTRUE;
+	prvSetInterruptsEnabled( pdTRUE );
+	prvRaisePendingIrqs();
 }
 /*-----------------------------------------------------------*/
 
 portBASE_TYPE xPortSetInterruptMask( void )
 {
-portBASE_TYPE xReturn = xInterruptsEnabled;
-	xInterruptsEnabled = pdFALSE;
+portBASE_TYPE xReturn = prvInterruptsEnabled();
+
+	prvSetInterruptsEnabled( pdFALSE );
 	return xReturn;
 }
 /*-----------------------------------------------------------*/
 
 void vPortClearInterruptMask( portBASE_TYPE xMask )
 {
-	xInterruptsEnabled = xMask;
+	prvSetInterruptsEnabled( xMask );
+	if ( pdTRUE == xMask )
+	{
+		prvRaisePendingIrqs();
+	}
 }
 /*-----------------------------------------------------------*/
 
 /*
- * Setup the systick timer to generate the tick interrupts at the required
+ * Start the thread that generates the tick interrupts at the required
  * frequency.
  */
 void prvSetupTimerInterrupt( void )
 {
-struct itimerval itimer, oitimer;
-portTickType xMicroSeconds = portTICK_RATE_MICROSECONDS;
-
-	/* Initialise the structure with the current timer information. */
-	if ( 0 == getitimer( TIMER_TYPE, &itimer ) )
+pthread_attr_t xTickThreadAttributes;
+pthread_condattr_t xTickConditionAttributes;
+
+	pthread_condattr_init( &xTickConditionAttributes );
+	(void)pthread_condattr_setclock( &xTickConditionAttributes, TICK_CLOCK );
+	(void)pthread_cond_init( &xTickCondition, &xTickConditionAttributes );
+	pthread_condattr_destroy( &xTickConditionAttributes );
+	(void)clock_gettime( TICK_CLOCK, &xTickStart );
+
+	prvReadTimeModeFromEnvironment();
+	ullTickPeriodNs = portTICK_PERIOD_NANOSECONDS / ulTimeScale;
+	(void)sem_init( &xTickProcessed, 0, 0 );
+
+	/* The thread inherits the fully blocked signal mask of the caller, so
+	SIG_TICK is only ever handled by the task threads. Like an interrupt it
+	preempts every task thread when they run under SCHED_FIFO. */
+	pthread_attr_init( &xTickThreadAttributes );
+	if ( pdTRUE == xHostRealTime )
 	{
-		/* Set the interval between timer events. */
-		itimer.it_interval.tv_sec = 0;
-		itimer.it_interval.tv_usec = xMicroSeconds;
+	struct sched_param xParam = { .sched_priority = iHostTickPriority };
 
-		/* Set the current count-down. */
-		itimer.it_value.tv_sec = 0;
-		itimer.it_value.tv_usec = xMicroSeconds;
-
-		/* Set-up the timer interrupt. */
-		if ( 0 != setitimer( TIMER_TYPE, &itimer, &oitimer ) )
-		{
-			printf( "Set Timer problem.\n" );
-		}
+		(void)pthread_attr_setinheritsched( &xTickThreadAttributes, PTHREAD_EXPLICIT_SCHED );
+		(void)pthread_attr_setschedpolicy( &xTickThreadAttributes, SCHED_FIFO );
+		(void)pthread_attr_setschedparam( &xTickThreadAttributes, &xParam );
 	}
-	else
+	if ( 0 != pthread_create( &hTickThread, &xTickThreadAttributes, prvTickThread, NULL ) )
 	{
-		printf( "Get Timer problem.\n" );
+		printf( "Tick thread creation failed.\n" );
 	}
+	pthread_attr_destroy( &xTickThreadAttributes );
 }
 /*-----------------------------------------------------------*/
 
-void vPortSystemTickHandler( int sig )
+void *prvTickThread( void *pvParams )
 {
-pthread_t xTaskToSuspend;
-pthread_t xTaskToResume;
+struct timespec xDeadline;
+unsigned long long ullNextTick;
+unsigned long long ullTicksDue;
+unsigned long long ullWakeLatency;
+
+	( void )pvParams;
 
-	if ( ( pdTRUE == xInterruptsEnabled ) && ( pdTRUE != xServicingTick ) )
+	(void)pthread_mutex_lock( &xTickMutex );
+
+	for ( ;; )
 	{
-		if ( 0 == pthread_mutex_trylock( &xSingleThreadMutex ) )
+		if ( eFastForward == eTimeMode )
 		{
-			xServicingTick = pdTRUE;
+			/* Raise the next tick once the last one has been taken. */
+			ullTicksRaised++;
+			vPortPendTicks( 1 );
+			(void)pthread_mutex_unlock( &xTickMutex );
+			(void)kill( getpid(), SIG_TICK );
+			for ( ;; )
+			{
+				/* Raise a deferred tick again as nothing else might. */
+				(void)clock_gettime( CLOCK_REALTIME, &xDeadline );
+				xDeadline.tv_nsec += 1000000;
+				if ( xDeadline.tv_nsec >= 1000000000 )
+				{
+					xDeadline.tv_sec++;
+					xDeadline.tv_nsec -= 1000000000;
+				}
+				if ( 0 == sem_timedwait( &xTickProcessed, &xDeadline ) )
+				{
+					break;
+				}
+				(void)kill( getpid(), SIG_TICK );
+			}
+			(void)pthread_mutex_lock( &xTickMutex );
+			continue;
+		}
 
-			xTaskToSuspend = prvGetThreadHandle( xTaskGetCurrentTaskHandle() );
-			/* Tick Increment. */
-			xTaskIncrementTick();
+		/* Absolute deadlines don't accumulate the error of each wake up. */
+		ullNextTick = ullTicksRaised + 1;
+		if ( ullSleepUntilTick > ullNextTick )
+		{
+			ullNextTick = ullSleepUntilTick;
+		}
+		prvTickToTimespec( ullNextTick, &xDeadline );
 
-			/* Select Next Task. */
-#if ( configUSE_PREEMPTION == 1 )
-			vTaskSwitchContext();
-#endif
-			xTaskToResume = prvGetThreadHandle( xTaskGetCurrentTaskHandle() );
+		/* Signalled when tickless idle starts or ends, go round again. */
+		if ( ETIMEDOUT != pthread_cond_timedwait( &xTickCondition, &xTickMutex, &xDeadline ) )
+		{
+			continue;
+		}
 
-			/* The only thread that can process this tick is the running thread. */
-			if ( xTaskToSuspend != xTaskToResume )
+		/* How late the host woke the thread is the jitter of the tick. */
+		ullWakeLatency = prvClockNanoseconds( TICK_CLOCK ) - ( ( unsigned long long )xDeadline.tv_sec * 1000000000ULL + ( unsigned long long )xDeadline.tv_nsec );
+		if ( ullWakeLatency < ( 1ULL << 63 ) )
+		{
+			ulWakeUps++;
+			ullWakeLatencyNs += ullWakeLatency;
+			if ( ullWakeLatency > ulMaxWakeLatencyNs )
 			{
-				/* Remember and switch the critical nesting. */
-				prvSetTaskCriticalNesting( xTaskToSuspend, uxCriticalNesting );
-				uxCriticalNesting = prvGetTaskCriticalNesting( xTaskToResume );
-				/* Resume next task. */
-				prvResumeThread( xTaskToResume );
-				/* Suspend the current task. */
-				prvSuspendThread( xTaskToSuspend );
+				ulMaxWakeLatencyNs = ( unsigned long )ullWakeLatency;
 			}
-			else
+
+			/* Show what real-time mode achieved, whether or not it was granted. */
+			if ( ( eHostRealTime == eHostScheduling ) && ( configTICK_RATE_HZ == ulWakeUps ) )
 			{
-				/* Release the lock as we are Resuming. */
-				(void)pthread_mutex_unlock( &xSingleThreadMutex );
+				printf( "Tick jitter over %lu ticks: %llu us mean, %lu us max.\n", ulWakeUps, ullWakeLatencyNs / ulWakeUps / 1000ULL, ulMaxWakeLatencyNs / 1000UL );
 			}
-			xServicingTick = pdFALSE;
 		}
-		else
+
+		/* Raise every period that has elapsed, not just one per wake up. */
+		ullTicksDue = prvTicksElapsed();
+		if ( ullTicksDue <= ullTicksRaised )
+		{
+			continue;
+		}
+		if ( ullTicksDue > ullNextTick )
 		{
-			xPendYield = pdTRUE;
+			ulLateTicks += ( unsigned long )( ullTicksDue - ullNextTick );
 		}
+
+		prvRaiseElapsedTicks();
+		(void)kill( getpid(), SIG_TICK );
 	}
-	else
-	{
-		xPendYield = pdTRUE;
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+void prvTickToTimespec( unsigned long long ullTick, struct timespec *pxTime )
+{
+unsigned long long ullNs = ullTick * ullTickPeriodNs + xTickStart.tv_nsec;
+
+	pxTime->tv_sec = xTickStart.tv_sec + ( time_t )( ullNs / 1000000000ULL );
+	pxTime->tv_nsec = ( long )( ullNs % 1000000000ULL );
+}
+/*-----------------------------------------------------------*/
+
+unsigned long long prvTicksElapsed( void )
+{
+struct timespec xNow;
+
+	(void)clock_gettime( TICK_CLOCK, &xNow );
+	return ( ( unsigned long long )( xNow.tv_sec - xTickStart.tv_sec ) * 1000000000ULL + xNow.tv_nsec - xTickStart.tv_nsec ) / ullTickPeriodNs;
+}
+/*-----------------------------------------------------------*/
+
+void prvRaiseElapsedTicks( void )
+{
+/* Must be called with xTickMutex held. */
+unsigned long long ullTicksDue = prvTicksElapsed();
+
+	if ( ullTicksDue > ullTicksRaised )
+	{
+		vPortPendTicks( ( unsigned portBASE_TYPE )( ullTicksDue - ullTicksRaised ) );
+		ullTicksRaised = ullTicksDue;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortPendTicks( unsigned portBASE_TYPE uxTicks )
+{
+	(void)__atomic_add_fetch( &uxPendingTicks, uxTicks, __ATOMIC_SEQ_CST );
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetTickStats( xPortTickStats *pxStats )
+{
+	pxStats->ulLateTicks = ulLateTicks;
+	pxStats->ulDeferredTicks = ulDeferredTicks;
+	pxStats->ulReplayedTicks = ulReplayedTicks;
+	pxStats->ulWakeUps = ulWakeUps;
+	pxStats->ulMaxWakeLatencyNs = ulMaxWakeLatencyNs;
+	pxStats->ullWakeLatencyNs = ullWakeLatencyNs;
+}
+/*-----------------------------------------------------------*/
+
+void vPortSetTimeMode( ePortTimeMode eMode, unsigned long ulScale )
+{
+	eTimeMode = eMode;
+	ulTimeScale = ( ( eScaledTime == eMode ) && ( ulScale > 0 ) ) ? ulScale : 1;
+}
+/*-----------------------------------------------------------*/
+
+void prvReadTimeModeFromEnvironment( void )
+{
+/* FREERTOS_TIME_MODE overrides the mode the program chose, so that unchanged
+binaries can be run in virtual time: "real", "scaled:<k>" or "fast". */
+const char *pcMode = getenv( "FREERTOS_TIME_MODE" );
+
+	if ( NULL == pcMode )
+	{
+		/* Keep the program's choice. */
+	}
+	else if ( 0 == strcmp( pcMode, "real" ) )
+	{
+		vPortSetTimeMode( eRealTime, 1 );
+	}
+	else if ( 0 == strncmp( pcMode, "scaled:", 7 ) )
+	{
+		vPortSetTimeMode( eScaledTime, strtoul( pcMode + 7, NULL, 10 ) );
+	}
+	else if ( 0 == strcmp( pcMode, "fast" ) )
+	{
+		vPortSetTimeMode( eFastForward, 1 );
+	}
+	else
+	{
+		printf( "Unknown FREERTOS_TIME_MODE \"%s\", using real-time.\n", pcMode );
+		vPortSetTimeMode( eRealTime, 1 );
+	}
+
+	if ( eScaledTime == eTimeMode )
+	{
+		printf( "Time runs at %lux real-time.\n", ulTimeScale );
+	}
+	else if ( eFastForward == eTimeMode )
+	{
+		printf( "Time is fast-forwarded.\n" );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortSetHostScheduling( ePortHostScheduling eMode, const char *pcCpus )
+{
+	eHostScheduling = eMode;
+	if ( NULL != pcCpus )
+	{
+		xHostCpusSet = prvParseCpuList( pcCpus, &xHostCpus );
+	}
+}
+/*-----------------------------------------------------------*/
+
+ePortHostScheduling ePortGetHostScheduling( void )
+{
+	return ( pdTRUE == xHostRealTime ) ? eHostRealTime : eHostNormal;
+}
+/*-----------------------------------------------------------*/
+
+void prvReadHostSchedulingFromEnvironment( void )
+{
+/* FREERTOS_HOST_SCHED overrides the program's choice: "normal" or "fifo",
+optionally followed by the CPUs to run on, e.g. "fifo:2-3". */
+const char *pcMode = getenv( "FREERTOS_HOST_SCHED" );
+const char *pcCpus;
+size_t xLength;
+
+	if ( NULL == pcMode )
+	{
+		/* Keep the program's choice. */
+		return;
+	}
+
+	pcCpus = strchr( pcMode, ':' );
+	xLength = ( NULL != pcCpus ) ? ( size_t )( pcCpus - pcMode ) : strlen( pcMode );
+	if ( NULL != pcCpus )
+	{
+		pcCpus++;
+	}
+
+	if ( ( 6 == xLength ) && ( 0 == strncmp( pcMode, "normal", xLength ) ) )
+	{
+		vPortSetHostScheduling( eHostNormal, pcCpus );
+	}
+	else if ( ( 4 == xLength ) && ( 0 == strncmp( pcMode, "fifo", xLength ) ) )
+	{
+		vPortSetHostScheduling( eHostRealTime, pcCpus );
+	}
+	else
+	{
+		printf( "Unknown FREERTOS_HOST_SCHED \"%s\", using normal host scheduling.\n", pcMode );
+		vPortSetHostScheduling( eHostNormal, NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE prvParseCpuList( const char *pcCpus, cpu_set_t *pxCpus )
+{
+/* CPU numbers and ranges separated by commas, e.g. "0,2-3". */
+const char *pcNext = pcCpus;
+char *pcEnd;
+unsigned long ulFirst;
+unsigned long ulLast;
+
+	CPU_ZERO( pxCpus );
+	while ( '\0' != *pcNext )
+	{
+		ulFirst = strtoul( pcNext, &pcEnd, 10 );
+		if ( pcEnd == pcNext )
+		{
+			break;
+		}
+		ulLast = ulFirst;
+		if ( '-' == *pcEnd )
+		{
+			pcNext = pcEnd + 1;
+			ulLast = strtoul( pcNext, &pcEnd, 10 );
+			if ( pcEnd == pcNext )
+			{
+				break;
+			}
+		}
+		for ( ; ( ulFirst <= ulLast ) && ( ulFirst < CPU_SETSIZE ); ulFirst++ )
+		{
+			CPU_SET( ulFirst, pxCpus );
+		}
+
+		pcNext = pcEnd;
+		if ( ',' == *pcNext )
+		{
+			pcNext++;
+		}
+		else if ( '\0' != *pcNext )
+		{
+			break;
+		}
+	}
+
+	if ( ( '\0' != *pcNext ) || ( 0 == CPU_COUNT( pxCpus ) ) )
+	{
+		printf( "Invalid CPU list \"%s\", not pinning.\n", pcCpus );
+		return pdFALSE;
+	}
+	return pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void prvSetupHostScheduling( void )
+{
+/* Called by the thread that starts the scheduler before the tick thread is
+created. Threads created from now on inherit its CPU affinity. */
+struct sched_param xParam;
+xThreadState *pxThread;
+int iError;
+
+	prvReadHostSchedulingFromEnvironment();
+
+	if ( pdTRUE == xHostCpusSet )
+	{
+		iError = pthread_setaffinity_np( pthread_self(), sizeof( cpu_set_t ), &xHostCpus );
+		for ( pxThread = pxThreadList; ( 0 == iError ) && ( NULL != pxThread ); pxThread = pxThread->pxNext )
+		{
+			iError = pthread_setaffinity_np( pxThread->hThread, sizeof( cpu_set_t ), &xHostCpus );
+		}
+		if ( 0 != iError )
+		{
+			printf( "Pinning to the CPU list failed (%s).\n", strerror( iError ) );
+		}
+	}
+
+	if ( eHostRealTime != eHostScheduling )
+	{
+		return;
+	}
+
+	/* Page faults would add to the latency. With MCL_ONFAULT the thread stacks
+	are not faulted in whole here, the part a task uses is prefaulted by its
+	thread when it first runs. */
+#ifdef MCL_ONFAULT
+	if ( 0 != mlockall( MCL_CURRENT | MCL_FUTURE | MCL_ONFAULT ) )
+#else
+	if ( 0 != mlockall( MCL_CURRENT | MCL_FUTURE ) )
+#endif
+	{
+		printf( "mlockall() failed (%s), memory is not locked.\n", strerror( errno ) );
+	}
+
+	/* The tick preempts every task, the tasks' priorities are spread over the
+	host priorities below it. */
+	iHostTickPriority = sched_get_priority_max( SCHED_FIFO ) - 1;
+	iHostTaskPriorityBase = portHOST_TASK_PRIORITY_BASE;
+	if ( iHostTaskPriorityBase < sched_get_priority_min( SCHED_FIFO ) )
+	{
+		iHostTaskPriorityBase = sched_get_priority_min( SCHED_FIFO );
+	}
+	if ( iHostTaskPriorityBase > iHostTickPriority - 2 )
+	{
+		iHostTaskPriorityBase = iHostTickPriority - 2;
+	}
+
+	/* This thread only waits for the scheduler to end. Giving it the lowest
+	task priority finds out whether SCHED_FIFO is permitted. */
+	xParam.sched_priority = iHostTaskPriorityBase;
+	iError = pthread_setschedparam( pthread_self(), SCHED_FIFO, &xParam );
+	if ( 0 != iError )
+	{
+		printf( "SCHED_FIFO is not permitted (%s), using normal host scheduling.\n", strerror( iError ) );
+		return;
+	}
+
+	xHostRealTime = pdTRUE;
+	printf( "Task threads run under SCHED_FIFO.\n" );
+}
+/*-----------------------------------------------------------*/
+
+void prvFollowTaskPriority( xThreadState *pxThread )
+{
+/* Called with the thread's task already current, before the thread is
+resumed. Only a change of the task's priority, e.g. through inheritance, costs
+a system call. */
+struct sched_param xParam;
+UBaseType_t uxPriority;
+UBaseType_t uxSpan;
+
+	if ( pdTRUE != xHostRealTime )
+	{
+		return;
+	}
+
+	uxPriority = uxTaskPriorityGetFromISR( xTaskGetCurrentTaskHandle() );
+	uxSpan = ( UBaseType_t )( iHostTickPriority - 1 - iHostTaskPriorityBase );
+	xParam.sched_priority = iHostTaskPriorityBase + ( int )( ( uxPriority * uxSpan ) / ( ( configMAX_PRIORITIES > uxSpan ) ? ( configMAX_PRIORITIES - 1 ) : uxSpan ) );
+
+	if ( xParam.sched_priority != pxThread->iHostPriority )
+	{
+		(void)pthread_setschedparam( pxThread->hThread, SCHED_FIFO, &xParam );
+		pxThread->iHostPriority = xParam.sched_priority;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void prvPrefaultStack( void )
+{
+/* Touches the stack the task is about to use, once, before the faults could
+delay it. */
+volatile unsigned char ucStack[ portHOST_PREFAULT_STACK_SIZE ];
+size_t xOffset;
+
+	for ( xOffset = 0; xOffset < sizeof( ucStack ); xOffset += 1024 )
+	{
+		ucStack[ xOffset ] = 0;
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+{
+sigset_t xAllSignals;
+sigset_t xPreviousSignals;
+unsigned portBASE_TYPE uxTicks;
+TickType_t xStep;
+
+	if ( eFastForward == eTimeMode )
+	{
+		/* Nothing to wait for, jump over the idle time. The tick that
+		unblocks the task is left to the tick interrupt. */
+		vPortEnterCritical();
+		(void)pthread_mutex_lock( &xTickMutex );
+		if ( ( eStandardSleep == eTaskConfirmSleepModeStatus() ) && ( 0 == __atomic_load_n( &uxPendingTicks, __ATOMIC_SEQ_CST ) ) )
+		{
+			vTaskStepTick( xExpectedIdleTime - 1 );
+			vPortPendTicks( 1 );
+		}
+		(void)pthread_mutex_unlock( &xTickMutex );
+		vPortExitCritical();
+		return;
+	}
+
+	/* Nothing may be handled between deciding to sleep and sleeping, or its
+	wake up would be missed. sigsuspend() reopens the mask atomically. */
+	sigfillset( &xAllSignals );
+	(void)pthread_sigmask( SIG_BLOCK, &xAllSignals, &xPreviousSignals );
+	vPortEnterCritical();
+
+	/* A line held off while the kernel was busy, e.g. one raised as this
+	thread was switched in, is only raised again when interrupts are enabled,
+	and a switch a handler asked for is made when the critical section ends,
+	so both have to be taken before sleeping. */
+	(void)pthread_mutex_lock( &xTickMutex );
+	if ( ( eAbortSleep == eTaskConfirmSleepModeStatus() ) || ( 0 < __atomic_load_n( &uxPendingTicks, __ATOMIC_SEQ_CST ) ) ||
+		 ( 0 != ( __atomic_load_n( &ullPendingIrqs, __ATOMIC_SEQ_CST ) & __atomic_load_n( &ullEnabledIrqs, __ATOMIC_SEQ_CST ) ) ) ||
+		 ( pdTRUE == prvYieldPending() ) )
+	{
+		(void)pthread_mutex_unlock( &xTickMutex );
+		(void)pthread_sigmask( SIG_SETMASK, &xPreviousSignals, NULL );
+		vPortExitCritical();
+		return;
+	}
+
+	/* Reprogram the tick thread as a one-shot timer for the wake up tick. */
+	ullSleepUntilTick = ullTicksRaised + xExpectedIdleTime;
+	hSleepingThread = pthread_self();
+	xSleeping = pdTRUE;
+	(void)pthread_cond_signal( &xTickCondition );
+	(void)pthread_mutex_unlock( &xTickMutex );
+
+	/* Woken by the wake up tick or by any other signal, e.g. SIGIO. All other threads of the port block them, so they land here. */
+	(void)sigsuspend( &xPreviousSignals );
+
+	xSleeping = pdFALSE;
+	(void)pthread_mutex_lock( &xTickMutex );
+	prvRaiseElapsedTicks();
+	ullSleepUntilTick = 0;
+	(void)pthread_cond_signal( &xTickCondition );
+	(void)pthread_mutex_unlock( &xTickMutex );
+
+	/* The kernel can be stepped up to, but not onto, the tick that unblocks a
+	task. That last tick is left to the tick interrupt so that it does the
+	unblocking. */
+	uxTicks = __atomic_exchange_n( &uxPendingTicks, 0, __ATOMIC_SEQ_CST );
+	xStep = ( uxTicks < xExpectedIdleTime ) ? ( TickType_t )uxTicks : xExpectedIdleTime - 1;
+	vTaskStepTick( xStep );
+	vPortPendTicks( uxTicks - xStep );
+
+	(void)pthread_sigmask( SIG_SETMASK, &xPreviousSignals, NULL );
+	vPortExitCritical();
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_TICKLESS_IDLE */
+
+void prvProcessPendingTicks( void )
+{
+/* Must be called with xSingleThreadMutex held. */
+unsigned portBASE_TYPE uxTicks = __atomic_exchange_n( &uxPendingTicks, 0, __ATOMIC_SEQ_CST );
+
+	if ( uxTicks > 1 )
+	{
+		ulReplayedTicks += uxTicks - 1;
+	}
+
+	/* Ticks that arrive while the scheduler is suspended are added to
+	uxPendedTicks by the kernel and replayed by xTaskResumeAll(). */
+	while ( uxTicks > 0 )
+	{
+		xTaskIncrementTick();
+		uxTicks--;
+	}
+
+	if ( eFastForward == eTimeMode )
+	{
+		(void)sem_post( &xTickProcessed );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortSystemTickHandler( int sig )
+{
+xThreadState *pxThreadToSuspend;
+xThreadState *pxThreadToResume;
+
+	/* The tick has to be processed by the thread that is currently running:
+	with condition variables a task thread can only put itself to sleep, and
+	the interrupt mask is only ordered against that thread. Pass it on if the
+	signal landed on any other thread (e.g. one created by a library, or a task
+	thread on its way to being suspended). */
+	pxThreadToSuspend = prvGetThreadState( xTaskGetCurrentTaskHandle() );
+	if ( 0 == pthread_equal( pthread_self(), pxThreadToSuspend->hThread ) )
+	{
+		(void)pthread_kill( pxThreadToSuspend->hThread, sig );
+		return;
+	}
+
+	if ( ( pdTRUE == prvInterruptsEnabled() ) && ( pdTRUE != xServicingTick ) )
+	{
+		if ( 0 == pthread_mutex_trylock( &xSingleThreadMutex ) )
+		{
+			xServicingTick = pdTRUE;
+
+			pxThreadToSuspend = prvGetThreadState( xTaskGetCurrentTaskHandle() );
+			/* Tick Increment, including the ticks that could not be taken earlier. */
+			prvProcessPendingTicks();
+
+			/* Select Next Task. */
+#if ( configUSE_PREEMPTION == 1 )
+			vTaskSwitchContext();
+#endif
+			pxThreadToResume = prvGetThreadState( xTaskGetCurrentTaskHandle() );
+
+			/* The only thread that can process this tick is the running thread. */
+			if ( pxThreadToSuspend != pxThreadToResume )
+			{
+#if ( portUSE_CONDVAR_SWITCH == 1 )
+				/* This thread sleeps in the switch, so the tick is done. */
+				xServicingTick = pdFALSE;
+#endif
+				prvSwitchThread( pxThreadToSuspend, pxThreadToResume );
+			}
+			else
+			{
+				/* Release the lock as we are Resuming. */
+				(void)pthread_mutex_unlock( &xSingleThreadMutex );
+			}
+			xServicingTick = pdFALSE;
+		}
+		else
+		{
+			/* The ticks stay pending for the next attempt. */
+			ulDeferredTicks++;
+			prvPendYield();
+		}
+	}
+	else
+	{
+		ulDeferredTicks++;
+		prvPendYield();
+	}
+
+	/* Catches interrupts whose signal went to a thread that was switched out. */
+	prvRaisePendingIrqs();
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xPortInstallIrqHandler( unsigned portBASE_TYPE uxIrq, unsigned portBASE_TYPE uxPriority, xPortIrqHandler pxHandler, void *pvParameter )
+{
+xIrqLine *pxLine;
+
+	if ( ( uxIrq >= portMAX_IRQS ) || ( 0 == uxPriority ) || ( uxPriority > portMAX_IRQ_PRIORITY ) )
+	{
+		return pdFAIL;
+	}
+
+	/* SIG_IRQ has to be handled before a line can be raised. */
+	(void)pthread_once( &hSigSetupThread, prvSetupSignalsAndSchedulerPolicy );
+
+	/* The line is disabled while it changes, a raise is dropped. */
+	vPortDisableIrq( uxIrq );
+	pxLine = &xIrqLines[ uxIrq ];
+	pxLine->pxHandler = NULL;
+	__atomic_store_n( &pxLine->ullRaisedAt, 0, __ATOMIC_SEQ_CST );
+	(void)__atomic_and_fetch( &ullPendingIrqs, ~( 1ULL << uxIrq ), __ATOMIC_SEQ_CST );
+	memset( &pxLine->xStats, 0, sizeof( pxLine->xStats ) );
+	pxLine->uxPriority = uxPriority;
+	pxLine->pvParameter = pvParameter;
+	__atomic_store_n( &pxLine->pxHandler, pxHandler, __ATOMIC_SEQ_CST );
+
+	if ( NULL != pxHandler )
+	{
+		vPortEnableIrq( uxIrq );
+	}
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnableIrq( unsigned portBASE_TYPE uxIrq )
+{
+	if ( ( uxIrq < portMAX_IRQS ) && ( NULL != xIrqLines[ uxIrq ].pxHandler ) )
+	{
+		(void)__atomic_or_fetch( &ullEnabledIrqs, 1ULL << uxIrq, __ATOMIC_SEQ_CST );
+
+		/* A line raised while it was disabled is taken now. */
+		if ( 0 != ( __atomic_load_n( &ullPendingIrqs, __ATOMIC_SEQ_CST ) & ( 1ULL << uxIrq ) ) )
+		{
+			prvSignalIrq();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortDisableIrq( unsigned portBASE_TYPE uxIrq )
+{
+	if ( uxIrq < portMAX_IRQS )
+	{
+		(void)__atomic_and_fetch( &ullEnabledIrqs, ~( 1ULL << uxIrq ), __ATOMIC_SEQ_CST );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortRaiseIrq( unsigned portBASE_TYPE uxIrq )
+{
+/* Only uses async-signal-safe calls, so it can be called from signal handlers. */
+xIrqLine *pxLine;
+unsigned long long ullNotRaised = 0;
+
+	if ( ( uxIrq >= portMAX_IRQS ) || ( NULL == __atomic_load_n( &xIrqLines[ uxIrq ].pxHandler, __ATOMIC_SEQ_CST ) ) )
+	{
+		return;
+	}
+	pxLine = &xIrqLines[ uxIrq ];
+
+	/* Whoever sets the time pends the line, it stays pending until the
+	dispatcher takes the time back. */
+	if ( 0 == __atomic_compare_exchange_n( &pxLine->ullRaisedAt, &ullNotRaised, prvClockNanoseconds( CLOCK_MONOTONIC ), pdFALSE, __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST ) )
+	{
+		(void)__atomic_add_fetch( &pxLine->xStats.ulCoalesced, 1, __ATOMIC_RELAXED );
+		return;
+	}
+	(void)__atomic_or_fetch( &ullPendingIrqs, 1ULL << uxIrq, __ATOMIC_SEQ_CST );
+
+	if ( 0 != ( __atomic_load_n( &ullEnabledIrqs, __ATOMIC_SEQ_CST ) & ( 1ULL << uxIrq ) ) )
+	{
+		prvSignalIrq();
+	}
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xPortIsInsideInterrupt( void )
+{
+	return ( 0 != uxIsrNesting ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetIrqStats( unsigned portBASE_TYPE uxIrq, xPortIrqStats *pxStats )
+{
+	if ( uxIrq < portMAX_IRQS )
+	{
+		*pxStats = xIrqLines[ uxIrq ].xStats;
+	}
+	else
+	{
+		memset( pxStats, 0, sizeof( *pxStats ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+#ifdef configASSERT
+
+void vPortValidateInterruptPriority( void )
+{
+	/* The kernel never holds off the lines above the syscall priority, so
+	their handlers must not call it. */
+	configASSERT( uxIsrPriority <= configMAX_SYSCALL_INTERRUPT_PRIORITY );
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configASSERT */
+
+void prvSignalIrq( void )
+{
+	/* A task raising a line is the running one, so it takes it right away.
+	Any other thread leaves it to whichever thread doesn't block SIG_IRQ, the
+	handler passes it on to the running task from there. */
+	if ( NULL != pxThisThread )
+	{
+		(void)pthread_kill( pthread_self(), SIG_IRQ );
+	}
+	else
+	{
+		(void)kill( getpid(), SIG_IRQ );
 	}
 }
 /*-----------------------------------------------------------*/
 
-void vPortForciblyEndThread( void *pxTaskToDelete )
+void prvRaisePendingIrqs( void )
 {
-xTaskHandle hTaskToDelete = ( xTaskHandle )pxTaskToDelete;
-pthread_t xTaskToDelete;
-pthread_t xTaskToResume;
-/** portBASE_TYPE xResult; */
+	/* Lines that were held off are taken as soon as they can be. */
+	if ( ( 0 != ( __atomic_load_n( &ullPendingIrqs, __ATOMIC_RELAXED ) & __atomic_load_n( &ullEnabledIrqs, __ATOMIC_RELAXED ) ) ) && ( NULL != pxThisThread ) )
+	{
+		(void)pthread_kill( pthread_self(), SIG_IRQ );
+	}
+}
+/*-----------------------------------------------------------*/
 
-	if ( 0 == pthread_mutex_lock( &xSingleThreadMutex ) )
+void prvIrqSignalHandler( int sig )
+{
+xThreadState *pxThread;
+int iErrno = errno;
+
+	/* Pending lines wait for the first task to start. */
+	if ( pdTRUE != xSchedulerStarted )
+	{
+		return;
+	}
+
+	/* Like the tick, interrupts are taken by the running task's thread. */
+	pxThread = prvGetThreadState( xTaskGetCurrentTaskHandle() );
+	if ( pxThread != pxThisThread )
+	{
+		(void)pthread_kill( pxThread->hThread, sig );
+	}
+	else
+	{
+		prvDispatchIrqs();
+	}
+	errno = iErrno;
+}
+/*-----------------------------------------------------------*/
+
+int prvHighestPendingIrq( unsigned portBASE_TYPE uxAbove, portBASE_TYPE xKernelAvailable )
+{
+unsigned long long ullPending = __atomic_load_n( &ullPendingIrqs, __ATOMIC_SEQ_CST ) & __atomic_load_n( &ullEnabledIrqs, __ATOMIC_SEQ_CST );
+unsigned portBASE_TYPE uxBest = uxAbove;
+unsigned portBASE_TYPE uxPriority;
+int iIrq;
+int iBest = -1;
+
+	/* The lowest numbered line wins between lines of the same priority. */
+	while ( 0 != ullPending )
 	{
-		xTaskToDelete = prvGetThreadHandle( hTaskToDelete );
-		xTaskToResume = prvGetThreadHandle( xTaskGetCurrentTaskHandle() );
+		iIrq = __builtin_ctzll( ullPending );
+		ullPending &= ullPending - 1;
+		uxPriority = xIrqLines[ iIrq ].uxPriority;
 
-		if ( xTaskToResume == xTaskToDelete )
+		if ( uxPriority <= uxBest )
 		{
-			/* This is a suicidal thread, need to select a different task to run. */
-			vTaskSwitchContext();
-			xTaskToResume = prvGetThreadHandle( xTaskGetCurrentTaskHandle() );
+			continue;
 		}
+		if ( ( uxPriority <= configMAX_SYSCALL_INTERRUPT_PRIORITY ) && ( pdFALSE == xKernelAvailable ) )
+		{
+			xIrqLines[ iIrq ].xStats.ulDeferred++;
+			continue;
+		}
+		uxBest = uxPriority;
+		iBest = iIrq;
+	}
+
+	return iBest;
+}
+/*-----------------------------------------------------------*/
+
+void prvDispatchIrqs( void )
+{
+/* Runs in the SIG_IRQ handler of the running task's thread. */
+unsigned portBASE_TYPE uxInterrupted = uxIsrPriority;
+portBASE_TYPE xKernelLocked = pdFALSE;
+portBASE_TYPE xKernelBusy = pdFALSE;
+portBASE_TYPE xKernelAvailable;
+unsigned long long ullRaisedAt;
+unsigned long long ullStart;
+unsigned long long ullTime;
+xIrqLine *pxLine;
+sigset_t xIrqSignal;
+int iIrq;
+
+	/* Each level runs a handler of a higher priority than the one it
+	preempted, so nesting is bounded by the number of priorities. */
+	uxIsrNesting++;
+	configASSERT( uxIsrNesting <= portMAX_IRQ_PRIORITY );
+
+	(void)sigemptyset( &xIrqSignal );
+	(void)sigaddset( &xIrqSignal, SIG_IRQ );
+
+	for ( ;; )
+	{
+		/* Lines that use the kernel are held off like the tick, by critical
+		sections (including those of the FromISR functions of the handler
+		being preempted) and by a switch the task was making. */
+		xKernelAvailable = ( ( pdTRUE == prvInterruptsEnabled() ) && ( pdTRUE != xServicingTick ) && ( pdFALSE == xKernelBusy ) ) ? pdTRUE : pdFALSE;
+		iIrq = prvHighestPendingIrq( uxInterrupted, xKernelAvailable );
+		if ( iIrq < 0 )
+		{
+			break;
+		}
+		pxLine = &xIrqLines[ iIrq ];
 
-		if ( pthread_self() != xTaskToDelete )
+		/* A task that was interrupted might be switching, a handler that was
+		preempted already holds the mutex on its behalf. */
+		if ( ( pxLine->uxPriority <= configMAX_SYSCALL_INTERRUPT_PRIORITY ) && ( 0 == uxInterrupted ) && ( pdFALSE == xKernelLocked ) )
 		{
-			/* Cancelling a thread that is not me. */
-			if ( xTaskToDelete != ( pthread_t )NULL )
+			if ( 0 != pthread_mutex_trylock( &xSingleThreadMutex ) )
 			{
-				/* Send a signal to wake the task so that it definitely cancels. */
-				pthread_testcancel();
-				pthread_cancel( xTaskToDelete );
-				/** xResult = pthread_cancel( xTaskToDelete ); */
-				/* Pthread Clean-up function will note the cancellation. */
+				xKernelBusy = pdTRUE;
+				continue;
 			}
-			(void)pthread_mutex_unlock( &xSingleThreadMutex );
+			xKernelLocked = pdTRUE;
+		}
+
+		/* Taken, a raise from here on pends the line again. */
+		(void)__atomic_and_fetch( &ullPendingIrqs, ~( 1ULL << iIrq ), __ATOMIC_SEQ_CST );
+		ullRaisedAt = __atomic_exchange_n( &pxLine->ullRaisedAt, 0, __ATOMIC_SEQ_CST );
+		if ( 0 == ullRaisedAt )
+		{
+			/* A nested dispatcher got to it first. */
+			continue;
+		}
+
+		ullStart = prvClockNanoseconds( CLOCK_MONOTONIC );
+		uxIsrPriority = pxLine->uxPriority;
+
+		/* SIG_IRQ is blocked while the dispatcher runs. Only a line of a
+		higher priority can preempt the handler, so there is nothing to let in
+		above the highest priority. */
+		if ( pxLine->uxPriority < portMAX_IRQ_PRIORITY )
+		{
+			(void)pthread_sigmask( SIG_UNBLOCK, &xIrqSignal, NULL );
+			pxLine->pxHandler( pxLine->pvParameter );
+			(void)pthread_sigmask( SIG_BLOCK, &xIrqSignal, NULL );
 		}
 		else
 		{
-			/* Resume the other thread. */
-			prvResumeThread( xTaskToResume );
-			/* Pthread Clean-up function will note the cancellation. */
-			/* Release the execution. */
-			uxCriticalNesting = 0;
-			vPortEnableInterrupts();
+			pxLine->pxHandler( pxLine->pvParameter );
+		}
+		uxIsrPriority = uxInterrupted;
+		ullTime = prvClockNanoseconds( CLOCK_MONOTONIC );
+
+		pxLine->xStats.ulDispatched++;
+		if ( 0 != uxInterrupted )
+		{
+			pxLine->xStats.ulNested++;
+		}
+		pxLine->xStats.ullDurationNs += ullTime - ullStart;
+		if ( ullTime - ullStart > pxLine->xStats.ulMaxDurationNs )
+		{
+			pxLine->xStats.ulMaxDurationNs = ( unsigned long )( ullTime - ullStart );
+		}
+		ullTime = ( ullStart > ullRaisedAt ) ? ullStart - ullRaisedAt : 0;
+		pxLine->xStats.ullLatencyNs += ullTime;
+		if ( ullTime > pxLine->xStats.ulMaxLatencyNs )
+		{
+			pxLine->xStats.ulMaxLatencyNs = ( unsigned long )ullTime;
+		}
+	}
+
+	if ( pdTRUE == xKernelLocked )
+	{
+		(void)pthread_mutex_unlock( &xSingleThreadMutex );
+	}
+	uxIsrNesting--;
+
+	/* As PendSV would, switch once the last handler has returned. SIG_IRQ is
+	blocked again, so the thread takes no interrupt on this frame once it is
+	resumed, only after the handler has returned. */
+	if ( ( 0 == uxIsrNesting ) && ( pdTRUE == prvYieldPending() ) )
+	{
+		vPortYieldFromISR();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void prvSwitchThread( xThreadState *pxThreadToSuspend, xThreadState *pxThreadToResume )
+{
+	/* Must be called with xSingleThreadMutex held. */
+
+	/* Remember and switch the critical nesting. */
+	pxThreadToSuspend->uxCriticalNesting = prvCriticalNesting();
+	prvSetCriticalNesting( pxThreadToResume->uxCriticalNesting );
+	prvFollowTaskPriority( pxThreadToResume );
+	/* Resume next task. */
+	prvResumeThread( pxThreadToResume );
+	/* Suspend the current task. */
+	prvSuspendThread( pxThreadToSuspend );
+}
+/*-----------------------------------------------------------*/
+
+void vPortForciblyEndThread( void *pxTaskToDelete )
+{
+xThreadState *pxThreadToDelete;
+xThreadState *pxThreadToResume;
+sigset_t xAllSignals;
+
+	/* Another task's thread is ended in vPortCleanUpTCB(), which the kernel
+	calls before freeing the TCB that this function is then passed. Only a
+	task deleting itself has to be dealt with here. */
+	if ( xTaskGetCurrentTaskHandle() != ( xTaskHandle )pxTaskToDelete )
+	{
+		return;
+	}
+
+	if ( 0 == pthread_mutex_lock( &xSingleThreadMutex ) )
+	{
+		pxThreadToDelete = prvGetThreadState( pxTaskToDelete );
+
+		/* This is a suicidal thread, need to select a different task to run. */
+		vTaskSwitchContext();
+		pxThreadToResume = prvGetThreadState( xTaskGetCurrentTaskHandle() );
+
+		/* No signal is handled by the thread once it has left the task. */
+		sigfillset( &xAllSignals );
+		(void)pthread_sigmask( SIG_BLOCK, &xAllSignals, NULL );
+		pxThreadToDelete->xDeleted = pdTRUE;
+
+		/* Resume the other thread, which sets its own interrupt mask. */
+		prvSetCriticalNesting( pxThreadToResume->uxCriticalNesting );
+		prvFollowTaskPriority( pxThreadToResume );
+		prvResumeThread( pxThreadToResume );
+		/* Release the execution. */
+		(void)pthread_mutex_unlock( &xSingleThreadMutex );
+		/* Leave the task's code, the thread is parked for reuse. */
+		siglongjmp( pxThreadToDelete->xParkContext, 1 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortCleanUpTCB( void *pxTCB )
+{
+xThreadState *pxThread = prvGetThreadState( pxTCB );
+
+	if ( NULL == pxThread )
+	{
+		/* The thread was never created. */
+		return;
+	}
+
+	if ( pdFALSE == pxThread->xDeleted )
+	{
+		/* Deleted by another task, the thread is suspended. It leaves the
+		task's code once it is resumed. The thread may still be on its way
+		into the suspension, which it completes before it lets go of
+		xSingleThreadMutex. */
+		pxThread->xDeleted = pdTRUE;
+		if ( 0 == pthread_mutex_lock( &xSingleThreadMutex ) )
+		{
+			prvResumeThread( pxThread );
 			(void)pthread_mutex_unlock( &xSingleThreadMutex );
-			/* Commit suicide */
-			pthread_exit( (void *)1 );
 		}
 	}
+
+	/* Don't reuse or free the state while the thread might still be using it.
+	Once parked, it goes to the pool if there is room and ends otherwise. */
+	vPortEnterCritical();
+	(void)pthread_mutex_lock( &xThreadPoolMutex );
+	while ( pdFALSE == pxThread->xExited )
+	{
+		(void)pthread_cond_wait( &pxThread->hParkCondition, &xThreadPoolMutex );
+	}
+	if ( uxPooledThreads < portTHREAD_POOL_SIZE )
+	{
+		pxThread->pxNextPooled = pxThreadPool;
+		pxThreadPool = pxThread;
+		uxPooledThreads++;
+		pxThread = NULL;
+	}
+	else
+	{
+		pxThread->pxCode = NULL;
+		pxThread->xExited = pdFALSE;
+		(void)pthread_cond_broadcast( &pxThread->hParkCondition );
+	}
+	(void)pthread_mutex_unlock( &xThreadPoolMutex );
+
+	if ( NULL != pxThread )
+	{
+		(void)pthread_join( pxThread->hThread, NULL );
+		prvUnlinkThread( pxThread );
+	}
+	vPortExitCritical();
+
+	if ( NULL != pxThread )
+	{
+		(void)pthread_cond_destroy( &pxThread->hParkCondition );
+#if ( portUSE_CONDVAR_SWITCH == 1 )
+		(void)pthread_cond_destroy( &pxThread->hRunCondition );
+#endif
+#if ( portUSE_HOST_THREAD_STACKS == 1 )
+		(void)munmap( pxThread->pucStack, pxThread->xStackSize );
+#endif
+		prvFreeThreadState( pxThread );
+	}
 }
 /*-----------------------------------------------------------*/
 
 void *prvWaitForStart( void * pvParams )
 {
-xParams * pxParams = ( xParams * )pvParams;
-pdTASK_CODE pvCode = pxParams->pxCode;
-void * pParams = pxParams->pvParams;
-	vPortFree( pvParams );
+xThreadState *pxThread = ( xThreadState * )pvParams;
+sigset_t xTaskSignals;
+
+	pxThisThread = pxThread;
+#if ( portUSE_HOST_THREAD_STACKS == 1 )
+	/* What the C library keeps at the top of the stack isn't the task's. */
+	pxThread->pucStackStart = __builtin_frame_address( 0 );
+#endif
+
+	/* Every task the thread runs starts with the signal mask it was created
+	with. */
+	(void)pthread_sigmask( SIG_SETMASK, NULL, &xTaskSignals );
+
+	do
+	{
+		if ( 0 == sigsetjmp( pxThread->xParkContext, 0 ) )
+		{
+			prvRunTask( pxThread, &xTaskSignals );
+			return (void *)NULL;
+		}
+		/* The task was deleted and left its code with every signal blocked. */
+	} while ( pdTRUE == prvParkThread( pxThread ) );
 
-	pthread_cleanup_push( prvDeleteThread, (void *)pthread_self() );
+	return (void *)NULL;
+}
+/*-----------------------------------------------------------*/
+
+void prvRunTask( xThreadState *pxThread, const sigset_t *pxTaskSignals )
+{
+	(void)pthread_sigmask( SIG_SETMASK, pxTaskSignals, NULL );
 
 	if ( 0 == pthread_mutex_lock( &xSingleThreadMutex ) )
 	{
-		prvSuspendThread( pthread_self() );
+		prvSuspendThread( pxThread );
+	}
+
+	if ( pdTRUE == xHostRealTime )
+	{
+		prvPrefaultStack();
 	}
 
-	pvCode( pParams );
+	pxThread->pxCode( pxThread->pvParams );
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE prvParkThread( xThreadState *pxThread )
+{
+/* Returns pdTRUE when the thread has been handed a new task, pdFALSE when it is
+to end. */
+portBASE_TYPE xReturn;
+#if ( portUSE_HOST_THREAD_STACKS == 1 )
+/* A thread that is likely to be pooled scrubs its stack before it is parked,
+one that is likely to end only if it is reused after all. */
+portBASE_TYPE xScrubbed = ( uxPooledThreads < portTHREAD_POOL_SIZE ) ? pdTRUE : pdFALSE;
+
+	if ( pdTRUE == xScrubbed )
+	{
+		prvScrubStack( pxThread );
+	}
+#endif
 
+	(void)pthread_mutex_lock( &xThreadPoolMutex );
+	pthread_cleanup_push( prvUnlockThreadPoolMutex, NULL );
+	pxThread->xExited = pdTRUE;
+	(void)pthread_cond_broadcast( &pxThread->hParkCondition );
+	while ( pdTRUE == pxThread->xExited )
+	{
+		(void)pthread_cond_wait( &pxThread->hParkCondition, &xThreadPoolMutex );
+	}
+	xReturn = ( NULL != pxThread->pxCode ) ? pdTRUE : pdFALSE;
 	pthread_cleanup_pop( 1 );
-	return (void *)NULL;
+
+#if ( portUSE_HOST_THREAD_STACKS == 1 )
+	if ( ( pdTRUE == xReturn ) && ( pdFALSE == xScrubbed ) )
+	{
+		prvScrubStack( pxThread );
+	}
+#endif
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void prvUnlockThreadPoolMutex( void *pvUnused )
+{
+	(void)pvUnused;
+	(void)pthread_mutex_unlock( &xThreadPoolMutex );
 }
 /*-----------------------------------------------------------*/
 
@@ -540,9 +2086,70 @@ sigset_t xSignals;
 		printf( "SSH: Sw %d\n", sig );
 	}
 
+	/* A task deleted while it was suspended leaves its code from here. */
+	if ( ( NULL != pxThisThread ) && ( pdTRUE == pxThisThread->xDeleted ) )
+	{
+		siglongjmp( pxThisThread->xParkContext, 1 );
+	}
+
 	/* Will resume here when the SIG_RESUME signal is received. */
 	/* Need to set the interrupts based on the task's critical nesting. */
-	if ( uxCriticalNesting == 0 )
+	if ( prvCriticalNesting() == 0 )
+	{
+		vPortEnableInterrupts();
+	}
+	else
+	{
+		vPortDisableInterrupts();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void prvResumeSignalHandler(int sig)
+{
+	/* Yield the Scheduler to ensure that the yielding thread completes. */
+	if ( 0 == pthread_mutex_lock( &xSingleThreadMutex ) )
+	{
+		(void)pthread_mutex_unlock( &xSingleThreadMutex );
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if ( portUSE_CONDVAR_SWITCH == 1 )
+
+void prvSuspendThread( xThreadState *pxThread )
+{
+/* Must be called by the thread itself with xSingleThreadMutex held. The mutex
+is released while the thread waits and once it has been resumed. */
+sigset_t xAllSignals;
+sigset_t xPreviousSignals;
+
+	/* A sleeping thread must not be picked to handle the tick or any other
+	signal, as in the SIG_SUSPEND handler they all go to the running task. */
+	sigfillset( &xAllSignals );
+	(void)pthread_sigmask( SIG_BLOCK, &xAllSignals, &xPreviousSignals );
+
+	pxThread->xRunning = pdFALSE;
+	xSentinel = 1;
+
+	/* The wait is a cancellation point, don't die holding the mutex. */
+	pthread_cleanup_push( prvUnlockSingleThreadMutex, NULL );
+	while ( pdFALSE == pxThread->xRunning )
+	{
+		(void)pthread_cond_wait( &pxThread->hRunCondition, &xSingleThreadMutex );
+	}
+	pthread_cleanup_pop( 1 );
+
+	/* A task deleted while it was suspended leaves its code from here. */
+	if ( pdTRUE == pxThread->xDeleted )
+	{
+		siglongjmp( pxThread->xParkContext, 1 );
+	}
+
+	(void)pthread_sigmask( SIG_SETMASK, &xPreviousSignals, NULL );
+
+	/* Need to set the interrupts based on the task's critical nesting. */
+	if ( prvCriticalNesting() == 0 )
 	{
 		vPortEnableInterrupts();
 	}
@@ -553,7 +2160,24 @@ sigset_t xSignals;
 }
 /*-----------------------------------------------------------*/
 
-void prvSuspendThread( pthread_t xThreadId )
+void prvResumeThread( xThreadState *pxThread )
+{
+	/* Must be called with xSingleThreadMutex held. */
+	pxThread->xRunning = pdTRUE;
+	(void)pthread_cond_signal( &pxThread->hRunCondition );
+}
+/*-----------------------------------------------------------*/
+
+void prvUnlockSingleThreadMutex( void *pvUnused )
+{
+	(void)pvUnused;
+	(void)pthread_mutex_unlock( &xSingleThreadMutex );
+}
+/*-----------------------------------------------------------*/
+
+#else /* portUSE_CONDVAR_SWITCH */
+
+void prvSuspendThread( xThreadState *pxThread )
 {
 portBASE_TYPE xResult = pthread_mutex_lock( &xSuspendResumeThreadMutex );
 	if ( 0 == xResult )
@@ -561,7 +2185,7 @@ portBASE_TYPE xResult = pthread_mutex_lock( &xSuspendResumeThreadMutex );
 		/* Set-up for the Suspend Signal handler? */
 		xSentinel = 0;
 		xResult = pthread_mutex_unlock( &xSuspendResumeThreadMutex );
-		xResult = pthread_kill( xThreadId, SIG_SUSPEND );
+		xResult = pthread_kill( pxThread->hThread, SIG_SUSPEND );
 		while ( ( xSentinel == 0 ) && ( pdTRUE != xServicingTick ) )
 		{
 			sched_yield();
@@ -570,25 +2194,15 @@ portBASE_TYPE xResult = pthread_mutex_lock( &xSuspendResumeThreadMutex );
 }
 /*-----------------------------------------------------------*/
 
-void prvResumeSignalHandler(int sig)
-{
-	/* Yield the Scheduler to ensure that the yielding thread completes. */
-	if ( 0 == pthread_mutex_lock( &xSingleThreadMutex ) )
-	{
-		(void)pthread_mutex_unlock( &xSingleThreadMutex );
-	}
-}
-/*-----------------------------------------------------------*/
-
-void prvResumeThread( pthread_t xThreadId )
+void prvResumeThread( xThreadState *pxThread )
 {
 /** portBASE_TYPE xResult; */
 	if ( 0 == pthread_mutex_lock( &xSuspendResumeThreadMutex ) )
 	{
-		if ( pthread_self() != xThreadId )
+		if ( pthread_self() != pxThread->hThread )
 		{
-			pthread_kill( xThreadId, SIG_RESUME );
-			/** xResult = pthread_kill( xThreadId, SIG_RESUME ); */
+			pthread_kill( pxThread->hThread, SIG_RESUME );
+			/** xResult = pthread_kill( pxThread->hThread, SIG_RESUME ); */
 		}
 		pthread_mutex_unlock( &xSuspendResumeThreadMutex );
 		/** xResult = pthread_mutex_unlock( &xSuspendResumeThreadMutex ); */
@@ -596,28 +2210,25 @@ void prvResumeThread( pthread_t xThreadId )
 }
 /*-----------------------------------------------------------*/
 
+#endif /* portUSE_CONDVAR_SWITCH */
+
 void prvSetupSignalsAndSchedulerPolicy( void )
 {
-/* The following code would allow for configuring the scheduling of this task as a Real-time task.
- * The process would then need to be run with higher privileges for it to take affect.
-int iPolicy;
-int iResult;
-int iSchedulerPriority;
-	iResult = pthread_getschedparam( pthread_self(), &iPolicy, &iSchedulerPriority );
-	iResult = pthread_attr_setschedpolicy( &xThreadAttributes, SCHED_FIFO );
-	iPolicy = SCHED_FIFO;
-	iResult = pthread_setschedparam( pthread_self(), iPolicy, &iSchedulerPriority );		*/
-
-struct sigaction sigsuspendself, sigresume, sigtick;
-portLONG lIndex;
-
-	pxThreads = ( xThreadState *)pvPortMalloc( sizeof( xThreadState ) * MAX_NUMBER_OF_TASKS );
-	for ( lIndex = 0; lIndex < MAX_NUMBER_OF_TASKS; lIndex++ )
-	{
-		pxThreads[ lIndex ].hThread = ( pthread_t )NULL;
-		pxThreads[ lIndex ].hTask = ( xTaskHandle )NULL;
-		pxThreads[ lIndex ].uxCriticalNesting = 0;
-	}
+/* The host scheduling policy is set up by prvSetupHostScheduling() once the
+scheduler starts, see vPortSetHostScheduling(). */
+struct sigaction sigsuspendself, sigresume, sigtick, sigirq;
+pthread_mutexattr_t xMutexAttributes;
+
+	/* Under SCHED_FIFO a thread handing over the processor can be preempted by
+	the thread it resumes while it still holds these. Priority inheritance lets
+	it finish the hand-over instead of waiting behind the thread it woke. */
+	pthread_mutexattr_init( &xMutexAttributes );
+	(void)pthread_mutexattr_setprotocol( &xMutexAttributes, PTHREAD_PRIO_INHERIT );
+	(void)pthread_mutex_init( &xSingleThreadMutex, &xMutexAttributes );
+	(void)pthread_mutex_init( &xSuspendResumeThreadMutex, &xMutexAttributes );
+	(void)pthread_mutex_init( &xTickMutex, &xMutexAttributes );
+	(void)pthread_mutex_init( &xThreadPoolMutex, &xMutexAttributes );
+	pthread_mutexattr_destroy( &xMutexAttributes );
 
 	sigsuspendself.sa_flags = 0;
 	sigsuspendself.sa_handler = prvSuspendSignalHandler;
@@ -631,6 +2242,12 @@ portLONG lIndex;
 	sigtick.sa_handler = vPortSystemTickHandler;
 	sigfillset( &sigtick.sa_mask );
 
+	/* Nesting is up to prvDispatchIrqs(), which lets SIG_IRQ in while a
+	handler that a higher priority line may preempt runs. */
+	sigirq.sa_flags = SA_RESTART;
+	sigirq.sa_handler = prvIrqSignalHandler;
+	sigfillset( &sigirq.sa_mask );
+
 	if ( 0 != sigaction( SIG_SUSPEND, &sigsuspendself, NULL ) )
 	{
 		printf( "Problem installing SIG_SUSPEND_SELF\n" );
@@ -643,138 +2260,80 @@ portLONG lIndex;
 	{
 		printf( "Problem installing SIG_TICK\n" );
 	}
+	if ( 0 != sigaction( SIG_IRQ, &sigirq, NULL ) )
+	{
+		printf( "Problem installing SIG_IRQ\n" );
+	}
 	printf( "Running as PID: %d\n", getpid() );
 }
 /*-----------------------------------------------------------*/
 
-pthread_t prvGetThreadHandle( xTaskHandle hTask )
+void prvLinkThread( xThreadState *pxThread )
 {
-pthread_t hThread = ( pthread_t )NULL;
-portLONG lIndex;
-	for ( lIndex = 0; lIndex < MAX_NUMBER_OF_TASKS; lIndex++ )
+	/* The list is only walked to cancel every thread at the end. */
+	pxThread->pxPrevious = NULL;
+	pxThread->pxNext = pxThreadList;
+	if ( NULL != pxThreadList )
 	{
-		if ( pxThreads[ lIndex ].hTask == hTask )
-		{
-			hThread = pxThreads[ lIndex ].hThread;
-			break;
-		}
+		pxThreadList->pxPrevious = pxThread;
 	}
-	return hThread;
+	pxThreadList = pxThread;
 }
 /*-----------------------------------------------------------*/
 
-portLONG prvGetFreeThreadState( void )
+void prvUnlinkThread( xThreadState *pxThread )
 {
-portLONG lIndex;
-	for ( lIndex = 0; lIndex < MAX_NUMBER_OF_TASKS; lIndex++ )
+	if ( NULL != pxThread->pxPrevious )
 	{
-		if ( pxThreads[ lIndex ].hThread == ( pthread_t )NULL )
-		{
-			break;
-		}
+		pxThread->pxPrevious->pxNext = pxThread->pxNext;
 	}
-
-	if ( MAX_NUMBER_OF_TASKS == lIndex )
+	else
 	{
-		printf( "No more free threads, please increase the maximum.\n" );
-		lIndex = 0;
-		vPortEndScheduler();
+		pxThreadList = pxThread->pxNext;
 	}
 
-	return lIndex;
-}
-/*-----------------------------------------------------------*/
-
-void prvSetTaskCriticalNesting( pthread_t xThreadId, unsigned portBASE_TYPE uxNesting )
-{
-portLONG lIndex;
-	for ( lIndex = 0; lIndex < MAX_NUMBER_OF_TASKS; lIndex++ )
+	if ( NULL != pxThread->pxNext )
 	{
-		if ( pxThreads[ lIndex ].hThread == xThreadId )
-		{
-			pxThreads[ lIndex ].uxCriticalNesting = uxNesting;
-			break;
-		}
+		pxThread->pxNext->pxPrevious = pxThread->pxPrevious;
 	}
 }
 /*-----------------------------------------------------------*/
 
-unsigned portBASE_TYPE prvGetTaskCriticalNesting( pthread_t xThreadId )
+static unsigned long long prvClockNanoseconds( clockid_t xClock )
 {
-unsigned portBASE_TYPE uxNesting = 0;
-portLONG lIndex;
-	for ( lIndex = 0; lIndex < MAX_NUMBER_OF_TASKS; lIndex++ )
-	{
-		if ( pxThreads[ lIndex ].hThread == xThreadId )
-		{
-			uxNesting = pxThreads[ lIndex ].uxCriticalNesting;
-			break;
-		}
-	}
-	return uxNesting;
-}
-/*-----------------------------------------------------------*/
+struct timespec xNow = { 0 };
 
-void prvDeleteThread( void *xThreadId )
-{
-portLONG lIndex;
-	for ( lIndex = 0; lIndex < MAX_NUMBER_OF_TASKS; lIndex++ )
-	{
-		if ( pxThreads[ lIndex ].hThread == ( pthread_t )xThreadId )
-		{
-			pxThreads[ lIndex ].hThread = (pthread_t)NULL;
-			pxThreads[ lIndex ].hTask = (xTaskHandle)NULL;
-			if ( pxThreads[ lIndex ].uxCriticalNesting > 0 )
-			{
-				uxCriticalNesting = 0;
-				vPortEnableInterrupts();
-			}
-			pxThreads[ lIndex ].uxCriticalNesting = 0;
-			break;
-		}
-	}
+	(void)clock_gettime( xClock, &xNow );
+	return ( unsigned long long )xNow.tv_sec * 1000000000ULL + ( unsigned long long )xNow.tv_nsec;
 }
 /*-----------------------------------------------------------*/
 
-void vPortAddTaskHandle( void *pxTaskHandle )
+void vPortFindTicksPerSecond( void )
 {
-portLONG lIndex;
-
-	pxThreads[ lIndexOfLastAddedTask ].hTask = ( xTaskHandle )pxTaskHandle;
-	for ( lIndex = 0; lIndex < MAX_NUMBER_OF_TASKS; lIndex++ )
-	{
-		if ( pxThreads[ lIndex ].hThread == pxThreads[ lIndexOfLastAddedTask ].hThread )
-		{
-			if ( pxThreads[ lIndex ].hTask != pxThreads[ lIndexOfLastAddedTask ].hTask )
-			{
-				pxThreads[ lIndex ].hThread = ( pthread_t )NULL;
-				pxThreads[ lIndex ].hTask = NULL;
-				pxThreads[ lIndex ].uxCriticalNesting = 0;
-			}
-		}
-	}
+	ullRunTimeStart = prvClockNanoseconds( CLOCK_MONOTONIC );
 }
 /*-----------------------------------------------------------*/
 
-void vPortFindTicksPerSecond( void )
+unsigned long long ullPortGetTimerValue( void )
 {
-	/* Needs to be reasonably high for accuracy. */
-	unsigned long ulTicksPerSecond = sysconf(_SC_CLK_TCK);
-	printf( "Timer Resolution for Run TimeStats is %ld ticks per second.\n", ulTicksPerSecond );
+	return prvClockNanoseconds( CLOCK_MONOTONIC ) - ullRunTimeStart;
 }
 /*-----------------------------------------------------------*/
 
-unsigned long ulPortGetTimerValue( void )
+unsigned long long ullPortGetTaskRunTime( void *pvTaskHandle )
 {
-struct tms xTimes;
-	unsigned long ulTotalTime = times( &xTimes );
-	/* Return the application code times.
-	 * The timer only increases when the application code is actually running
-	 * which means that the total execution times should add up to 100%.
-	 */
-	return ( unsigned long ) xTimes.tms_utime;
+xThreadState *pxThread = prvGetThreadState( pvTaskHandle );
+clockid_t xThreadClock;
 
-	/* Should check ulTotalTime for being clock_t max minus 1. */
-	(void)ulTotalTime;
+	/* Each task has its thread to itself, so the thread's CPU clock is exactly
+	 * the time the task spent running, without the time the thread sat waiting
+	 * for the processor or blocked in the host. A thread taken from the pool
+	 * only counts from when it was handed the task.
+	 */
+	if ( 0 != pthread_getcpuclockid( pxThread->hThread, &xThreadClock ) )
+	{
+		return 0;
+	}
+	return prvClockNanoseconds( xThreadClock ) - pxThread->ullCpuTimeBase;
 }
 /*-----------------------------------------------------------*/
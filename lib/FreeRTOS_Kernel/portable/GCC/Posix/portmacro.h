@@ -105,7 +105,9 @@ typedef unsigned long UBaseType_t;
 #define portSTACK_GROWTH				( -1 )
 #define portTICK_PERIOD_MS				( ( TickType_t ) 1000 / configTICK_RATE_HZ )
 #define portTICK_PERIOD_MICROSECONDS		( ( TickType_t ) 1000000 / configTICK_RATE_HZ )
-#define portBYTE_ALIGNMENT				4
+/* Host objects, such as the port's thread state, are allocated from the
+FreeRTOS heap too, so it has to align blocks as malloc() would. */
+#define portBYTE_ALIGNMENT				16
 #define portREMOVE_STATIC_QUALIFIER
 /*-----------------------------------------------------------*/
 
@@ -119,6 +121,62 @@ extern void vPortYield( void );
 #define portYIELD()					vPortYield()
 
 #define portEND_SWITCHING_ISR( xSwitchRequired ) if( xSwitchRequired ) vPortYieldFromISR()
+
+/* Port optimised task selection. uxTopReadyPriority is a bit map of the
+priorities that have ready tasks and the highest of them is found with
+__builtin_clz(). Above 32 priorities the bit map has two levels, bit n of
+uxTopReadyPriority is set while one of priorities 32n to 32n + 31 has a ready
+task and ulPortReadyPriorities[ n ] holds the bits of those priorities. */
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+	#define configUSE_PORT_OPTIMISED_TASK_SELECTION 1
+#endif
+
+#if( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+
+	#define portPRIORITY_GROUPS		( ( configMAX_PRIORITIES + 31 ) / 32 )
+
+	#if( portPRIORITY_GROUPS > 32 )
+		#error configMAX_PRIORITIES can be at most 1024 when configUSE_PORT_OPTIMISED_TASK_SELECTION is 1
+	#endif
+
+	/* Index of the highest bit set in a non-zero 32-bit word. */
+	#define portHIGHEST_BIT( ulBits )	( 31UL - ( UBaseType_t ) __builtin_clz( ( uint32_t ) ( ulBits ) ) )
+
+	#if( portPRIORITY_GROUPS == 1 )
+
+		#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities )	( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+		#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities )	( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+		#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities )	uxTopPriority = portHIGHEST_BIT( uxReadyPriorities )
+
+	#else
+
+		extern uint32_t ulPortReadyPriorities[ portPRIORITY_GROUPS ];
+
+		#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities )											\
+		{																											\
+			ulPortReadyPriorities[ ( uxPriority ) >> 5 ] |= ( 1UL << ( ( uxPriority ) & 31UL ) );					\
+			( uxReadyPriorities ) |= ( 1UL << ( ( uxPriority ) >> 5 ) );											\
+		}
+
+		#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities )											\
+		{																											\
+			ulPortReadyPriorities[ ( uxPriority ) >> 5 ] &= ~( 1UL << ( ( uxPriority ) & 31UL ) );					\
+			if( ulPortReadyPriorities[ ( uxPriority ) >> 5 ] == 0UL )												\
+			{																										\
+				( uxReadyPriorities ) &= ~( 1UL << ( ( uxPriority ) >> 5 ) );										\
+			}																										\
+		}
+
+		#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities )										\
+		{																											\
+		UBaseType_t uxGroup = portHIGHEST_BIT( uxReadyPriorities );													\
+																													\
+			uxTopPriority = ( uxGroup << 5 ) + portHIGHEST_BIT( ulPortReadyPriorities[ uxGroup ] );					\
+		}
+
+	#endif
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
 /*-----------------------------------------------------------*/
 
 
@@ -155,28 +213,189 @@ extern void vPortExitCritical( void );
 extern void vPortForciblyEndThread( void *pxTaskToDelete );
 #define traceTASK_DELETE( pxTaskToDelete )		vPortForciblyEndThread( pxTaskToDelete )
 
-extern void vPortAddTaskHandle( void *pxTaskHandle );
-#define traceTASK_CREATE( pxNewTCB )			vPortAddTaskHandle( pxNewTCB )
+extern void vPortCleanUpTCB( void *pxTCB );
+#define portCLEAN_UP_TCB( pxTCB )				vPortCleanUpTCB( pxTCB )
+
+/* Tasks run on their host thread's stack, so the kernel doesn't allocate one.
+The thread gets portHOST_STACK_SCALE bytes for every byte of the task's stack
+depth, as host code needs more (64-bit pointers, the C library, SDL), but never
+less than portHOST_MINIMAL_STACK_SIZE. Define portUSE_HOST_THREAD_STACKS as 0 to
+create the threads with the host's default stack size instead. */
+#ifndef portUSE_HOST_THREAD_STACKS
+	#define portUSE_HOST_THREAD_STACKS	1
+#endif
+#ifndef portHOST_STACK_SCALE
+	#define portHOST_STACK_SCALE		4
+#endif
+#ifndef portHOST_MINIMAL_STACK_SIZE
+	#define portHOST_MINIMAL_STACK_SIZE	( 256 * 1024 )
+#endif
+
+/* The thread of a deleted task is parked instead of ended, and handed the next
+task created with the same stack size. Up to portTHREAD_POOL_SIZE threads are
+kept, 0 ends every thread with its task. */
+#ifndef portTHREAD_POOL_SIZE
+	#define portTHREAD_POOL_SIZE		16
+#endif
+
+/* The state the port keeps for each task thread is taken from a block pool of
+portTHREAD_STATE_BLOCKS blocks, and from pvPortMalloc() once that is used up. */
+#ifndef portTHREAD_STATE_BLOCKS
+	#define portTHREAD_STATE_BLOCKS		64
+#endif
+
+/* The port maps the thread stacks itself, with a guard page below each so that
+overflowing the host stack faults instead of corrupting memory. Pages a task
+never touched read as zero, so the deepest non-zero byte is its high water mark.
+uxTaskGetStackHighWaterMark() reports it in words of the task's stack depth,
+counting portHOST_STACK_SCALE host bytes as one target byte, and returns 0 when
+the task has used more than that. xPortGetStackBytesUsed() returns the host
+bytes used. */
+#if ( portUSE_HOST_THREAD_STACKS == 1 )
+extern unsigned portBASE_TYPE uxPortGetStackHighWaterMark( void *pxTCB );
+#define portGET_STACK_HIGH_WATER_MARK( pxTCB )	uxPortGetStackHighWaterMark( pxTCB )
+extern size_t xPortGetStackBytesUsed( void *pxTask );
+#endif
+
+/* Task threads are switched by suspending and resuming them with the
+SIG_SUSPEND/SIG_RESUME signals. Define portUSE_CONDVAR_SWITCH as 1 (or configure
+CMake with -DPOSIX_CONDVAR_SWITCH=ON) to instead have every thread sleep on its
+own condition variable and wake only the successor on a switch. */
+#ifndef portUSE_CONDVAR_SWITCH
+	#define portUSE_CONDVAR_SWITCH		0
+#endif
 
 /* Posix Signal definitions that can be changed or read as appropriate. */
 #define SIG_SUSPEND					SIGUSR1
 #define SIG_RESUME					SIGUSR2
 
-/* Enable the following hash defines to make use of the real-time tick where time progresses at real-time. */
+/* The tick thread sleeps until absolute deadlines of TICK_CLOCK and then raises
+SIG_TICK. The real-time tick is used, where time progresses at real-time. */
 #define SIG_TICK					SIGALRM
-#define TIMER_TYPE					ITIMER_REAL
-/* Enable the following hash defines to make use of the process tick where time progresses only when the process is executing.
-#define SIG_TICK					SIGVTALRM
-#define TIMER_TYPE					ITIMER_VIRTUAL		*/
-/* Enable the following hash defines to make use of the profile tick where time progresses when the process or system calls are executing.
-#define SIG_TICK					SIGPROF
-#define TIMER_TYPE					ITIMER_PROF */
-
-/* Make use of times(man 2) to gather run-time statistics on the tasks. */
+#define TICK_CLOCK					CLOCK_MONOTONIC
+/* TICK_CLOCK is also the clock of the tick thread's condition variable, so it
+can only be CLOCK_MONOTONIC or CLOCK_REALTIME. */
+
+/* Ticks that can't be taken when they are raised are kept and replayed, these
+count how often that happened. */
+typedef struct xPORT_TICK_STATS
+{
+	unsigned long ulLateTicks;		/* Periods that had already passed when the tick thread woke up. */
+	unsigned long ulDeferredTicks;	/* Tick signals that found interrupts disabled or the scheduler busy. */
+	unsigned long ulReplayedTicks;	/* Ticks processed in addition to the first by a tick interrupt. */
+	unsigned long ulWakeUps;		/* Times the tick thread woke up to raise ticks. */
+	unsigned long ulMaxWakeLatencyNs;	/* Longest time between a tick being due and the tick thread waking up. */
+	unsigned long long ullWakeLatencyNs;	/* Sum of those times, for the mean. */
+} xPortTickStats;
+
+extern void vPortGetTickStats( xPortTickStats *pxStats );
+extern void vPortPendTicks( unsigned portBASE_TYPE uxTicks );
+
+/* Simulated interrupt controller. Lines 0 to portMAX_IRQS - 1 are given a
+handler and a priority from 1 to portMAX_IRQ_PRIORITY, higher numbers being more
+urgent. vPortRaiseIrq() pends a line from any host thread, signal handlers
+included, and SIG_IRQ runs the handler on the running task's thread, where a
+line preempts the handlers of lower priority lines. Lines at or below
+configMAX_SYSCALL_INTERRUPT_PRIORITY may call the FromISR API and are held off
+by critical sections and while the kernel switches tasks. Lines above it are
+never held off, so they must not call the API. A line raised again before its
+handler ran is handled once, and a switch asked for with portEND_SWITCHING_ISR()
+is made when the outermost handler returns. The tick counts as the lowest
+priority interrupt. */
+#ifndef portMAX_IRQS
+	#define portMAX_IRQS				32
+#endif
+#ifndef portMAX_IRQ_PRIORITY
+	#define portMAX_IRQ_PRIORITY		8
+#endif
+#define SIG_IRQ						( SIGRTMIN + 2 )
+
+typedef void ( *xPortIrqHandler )( void *pvParameter );
+
+/* Kept per line from when its handler was installed. */
+typedef struct xPORT_IRQ_STATS
+{
+	unsigned long ulDispatched;		/* Times the handler ran. */
+	unsigned long ulCoalesced;		/* Raises that found the line still pending. */
+	unsigned long ulNested;			/* Times the handler preempted another one. */
+	unsigned long ulDeferred;		/* Times the line was found held off by a critical section or the kernel. */
+	unsigned long ulMaxLatencyNs;	/* Longest time between a raise and the handler being entered. */
+	unsigned long long ullLatencyNs;	/* Sum of those times, for the mean. */
+	unsigned long ulMaxDurationNs;	/* Longest run of the handler, preempting handlers included. */
+	unsigned long long ullDurationNs;	/* Sum of those times, for the mean. */
+} xPortIrqStats;
+
+extern portBASE_TYPE xPortInstallIrqHandler( unsigned portBASE_TYPE uxIrq, unsigned portBASE_TYPE uxPriority, xPortIrqHandler pxHandler, void *pvParameter );
+extern void vPortEnableIrq( unsigned portBASE_TYPE uxIrq );
+extern void vPortDisableIrq( unsigned portBASE_TYPE uxIrq );
+extern void vPortRaiseIrq( unsigned portBASE_TYPE uxIrq );
+extern portBASE_TYPE xPortIsInsideInterrupt( void );
+extern void vPortGetIrqStats( unsigned portBASE_TYPE uxIrq, xPortIrqStats *pxStats );
+
+#ifdef configASSERT
+	/* Checks that a FromISR function isn't called from above the syscall priority. */
+	extern void vPortValidateInterruptPriority( void );
+	#define portASSERT_IF_INTERRUPT_PRIORITY_INVALID()	vPortValidateInterruptPriority()
+#endif
+
+/* Emulated time can follow the host's clock, run k times faster than it or be
+fast-forwarded, where ticks follow each other as fast as the host can process
+them and idle time is skipped. Call before vTaskStartScheduler(), the
+FREERTOS_TIME_MODE environment variable ("real", "scaled:<k>" or "fast")
+overrides it. */
+typedef enum
+{
+	eRealTime = 0,
+	eScaledTime,
+	eFastForward
+} ePortTimeMode;
+
+extern void vPortSetTimeMode( ePortTimeMode eMode, unsigned long ulScale );
+
+/* The task threads are normally scheduled like any other host thread. In
+real-time mode they run under SCHED_FIFO, the running task at a host priority
+that follows its FreeRTOS priority and the tick thread above all of them, and
+memory is locked with mlockall(). pcCpus pins the emulator to a list of CPUs,
+e.g. "2-3", in either mode (NULL leaves the affinity alone). Call before
+vTaskStartScheduler(), the FREERTOS_HOST_SCHED environment variable ("normal"
+or "fifo", optionally followed by ":<cpus>") overrides it. Without the
+privileges for SCHED_FIFO the port falls back to normal scheduling, which
+ePortGetHostScheduling() then returns. */
+typedef enum
+{
+	eHostNormal = 0,
+	eHostRealTime
+} ePortHostScheduling;
+
+extern void vPortSetHostScheduling( ePortHostScheduling eMode, const char *pcCpus );
+extern ePortHostScheduling ePortGetHostScheduling( void );
+
+/* Lowest SCHED_FIFO priority given to a task thread. */
+#ifndef portHOST_TASK_PRIORITY_BASE
+	#define portHOST_TASK_PRIORITY_BASE		10
+#endif
+
+/* Bytes of its stack a task thread touches before it first runs in real-time
+mode, so that it does not take page faults later. */
+#ifndef portHOST_PREFAULT_STACK_SIZE
+	#define portHOST_PREFAULT_STACK_SIZE	( 64 * 1024 )
+#endif
+
+/* Tickless idle, the tick thread becomes a one-shot timer for the tick that
+unblocks the next task and the idle task's thread sleeps until then. */
+extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )	vPortSuppressTicksAndSleep( xExpectedIdleTime )
+
+/* Run-time statistics count nanoseconds. The total is the monotonic time since
+the scheduler started and each task is charged the CPU time its own thread
+used, so a task's percentage is the share of one host CPU it kept busy. */
 extern void vPortFindTicksPerSecond( void );
-#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()	vPortFindTicksPerSecond()		/* Nothing to do because the timer is already present. */
-extern unsigned long ulPortGetTimerValue( void );
-#define portGET_RUN_TIME_COUNTER_VALUE()			ulPortGetTimerValue()			/* Query the System time stats for this process. */
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()	vPortFindTicksPerSecond()
+extern unsigned long long ullPortGetTimerValue( void );
+#define portGET_RUN_TIME_COUNTER_VALUE()			ullPortGetTimerValue()
+extern unsigned long long ullPortGetTaskRunTime( void *pvTaskHandle );
+#define portGET_TASK_RUN_TIME_COUNTER_VALUE( pxTCB )	ullPortGetTaskRunTime( pxTCB )
+#define portLU_PRINTF_SPECIFIER_REQUIRED
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,790 @@
+/*
+	Copyright (C) 2009 William Davy - william.davy@wittenstein.co.uk
+	Contributed to FreeRTOS.org V5.3.0.
+
+	This file is part of the FreeRTOS.org distribution.
+
+	FreeRTOS.org is free software; you can redistribute it and/or modify it
+	under the terms of the GNU General Public License (version 2) as published
+	by the Free Software Foundation and modified by the FreeRTOS exception.
+
+	FreeRTOS.org is distributed in the hope that it will be useful,	but WITHOUT
+	ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+	FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+	more details.
+
+	You should have received a copy of the GNU General Public License along
+	with FreeRTOS.org; if not, write to the Free Software Foundation, Inc., 59
+	Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+
+	A special exception to the GPL is included to allow you to distribute a
+	combined work that includes FreeRTOS.org without being obliged to provide
+	the source code for any proprietary components.  See the licensing section
+	of http://www.FreeRTOS.org for full details.
+
+
+	***************************************************************************
+	*                                                                         *
+	* Get the FreeRTOS eBook!  See http://www.FreeRTOS.org/Documentation      *
+	*                                                                         *
+	* This is a concise, step by step, 'hands on' guide that describes both   *
+	* general multitasking concepts and FreeRTOS specifics. It presents and   *
+	* explains numerous examples that are written using the FreeRTOS API.     *
+	* Full source code for all the examples is provided in an accompanying    *
+	* .zip file.                                                              *
+	*                                                                         *
+	***************************************************************************
+
+	1 tab == 4 spaces!
+
+	Please ensure to read the configuration and relevant port sections of the
+	online documentation.
+
+	http://www.FreeRTOS.org - Documentation, latest information, license and
+	contact details.
+
+	http://www.SafeRTOS.com - A version that is certified for use in safety
+	critical systems.
+
+	http://www.OpenRTOS.com - Commercial support, development, porting,
+	licensing and training services.
+*/
+
+/*-----------------------------------------------------------
+ * Implementation of functions defined in portable.h for the single threaded
+ * (fiber) Posix port.
+ *
+ * Every task is a ucontext fiber on the host thread that started the
+ * scheduler, running on the stack allocated for it by tasks.c. A task switch
+ * is a swapcontext() rather than a signal round trip between host threads.
+ *
+ * The tick is still a signal. It is handled on the same host thread and
+ * preempts the running task by switching fibers from within the handler.
+ * Disabling interrupts only clears a flag, ticks arriving while it is clear
+ * are counted and processed as soon as interrupts are enabled again.
+ *----------------------------------------------------------*/
+
+#include <pthread.h>
+#include <signal.h>
+#include <errno.h>
+#include <semaphore.h>
+#include <time.h>
+#include <ucontext.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <unistd.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+/*-----------------------------------------------------------*/
+
+/* The fiber of a task. It lives at the top of the task's stack and the
+pointer to it is what tasks.c stores as pxTopOfStack, the first member of the
+TCB, so finding it from a task handle is a single dereference. */
+typedef struct FIBER_STATE
+{
+	ucontext_t xContext;
+	pdTASK_CODE pxCode;
+	void *pvParams;
+	unsigned portBASE_TYPE uxCriticalNesting;
+	void *pvAllocatedStack;		/* Set if the kernel's stack was too small. */
+	portBASE_TYPE xSwitchingFromHandler;	/* Set while a handler on the fiber switches away. */
+	unsigned long long ullRunTime;	/* CPU time used while this fiber ran. */
+} xFiberState;
+
+#define prvGetFiberState( hTask )	( *( xFiberState * volatile * )( hTask ) )
+
+#define portTICK_PERIOD_NANOSECONDS	( 1000000000ULL / configTICK_RATE_HZ )
+/*-----------------------------------------------------------*/
+
+static ucontext_t xSchedulerContext;
+static pthread_t hSchedulerThread;
+static pthread_t hTickThread;
+static pthread_mutex_t xTickMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t xTickCondition;
+static pthread_t hSleepingThread;
+/*-----------------------------------------------------------*/
+
+static volatile portBASE_TYPE xSchedulerStarted = pdFALSE;
+static volatile portBASE_TYPE xInterruptsEnabled = pdTRUE;
+static volatile portBASE_TYPE xPendYield = pdFALSE;
+static volatile unsigned portBASE_TYPE uxCriticalNesting = 0;
+
+/* Ticks raised by the tick thread that have not been processed yet, either
+because the signal is still on its way or because interrupts are disabled. */
+static volatile unsigned portBASE_TYPE uxPendedTickInterrupts = 0;
+static volatile unsigned long ulLateTicks = 0;
+static volatile unsigned long ulDeferredTicks = 0;
+static volatile unsigned long ulReplayedTicks = 0;
+
+/* The tick thread's time line, guarded by xTickMutex. While tickless idle
+sleeps, ullSleepUntilTick is the only tick that is raised. */
+static struct timespec xTickStart;
+static unsigned long long ullTicksRaised = 0;
+static unsigned long long ullSleepUntilTick = 0;
+static volatile portBASE_TYPE xSleeping = pdFALSE;
+
+/* How emulated time relates to the host's, chosen before the scheduler starts.
+In fast-forward mode each tick is raised as soon as the previous one has been
+processed, xTickProcessed is posted by the tick interrupt to say so. */
+static ePortTimeMode eTimeMode = eRealTime;
+static unsigned long ulTimeScale = 1;
+static unsigned long long ullTickPeriodNs = portTICK_PERIOD_NANOSECONDS;
+static sem_t xTickProcessed;
+
+/* Run-time statistics, see ullPortGetTaskRunTime(). */
+static unsigned long long ullRunTimeStart = 0;
+static unsigned long long ullFiberSwitchedInCpuTime = 0;
+/*-----------------------------------------------------------*/
+
+/*
+ * Setup the timer to generate the tick interrupts.
+ */
+static void prvSetupTimerInterrupt( void );
+static void *prvTickThread( void *pvParams );
+static void prvTickToTimespec( unsigned long long ullTick, struct timespec *pxTime );
+static unsigned long long prvTicksElapsed( void );
+static void prvRaiseElapsedTicks( void );
+static void prvReadTimeModeFromEnvironment( void );
+static unsigned long long prvClockNanoseconds( clockid_t xClock );
+static void prvFiberEntry( void );
+static void prvSwitchFiber( void );
+static void prvProcessTicks( void );
+/*-----------------------------------------------------------*/
+
+/*
+ * Exception handlers.
+ */
+void vPortYield( void );
+void vPortSystemTickHandler( int sig );
+/*-----------------------------------------------------------*/
+
+/*
+ * See header file for description.
+ */
+portSTACK_TYPE *pxPortInitialiseStack( portSTACK_TYPE *pxTopOfStack, portSTACK_TYPE *pxEndOfStack, pdTASK_CODE pxCode, void *pvParameters )
+{
+uintptr_t uxStackLow = ( uintptr_t )pxEndOfStack;
+uintptr_t uxFiber = ( ( uintptr_t )pxTopOfStack - sizeof( xFiberState ) ) & ~( ( uintptr_t )portBYTE_ALIGNMENT_MASK );
+void *pvAllocatedStack = NULL;
+xFiberState *pxFiber;
+
+	if ( ( uxFiber < uxStackLow ) || ( ( uxFiber - uxStackLow ) < portFIBER_MINIMAL_STACK_SIZE ) )
+	{
+		/* Too small to call into the C library or take a signal on. */
+		pvAllocatedStack = pvPortMalloc( portFIBER_MINIMAL_STACK_SIZE + sizeof( xFiberState ) + portBYTE_ALIGNMENT );
+		if ( NULL == pvAllocatedStack )
+		{
+			printf( "Fiber stack allocation failed.\n" );
+			abort();
+		}
+
+		uxStackLow = ( uintptr_t )pvAllocatedStack;
+		uxFiber = ( uxStackLow + portFIBER_MINIMAL_STACK_SIZE + portBYTE_ALIGNMENT ) & ~( ( uintptr_t )portBYTE_ALIGNMENT_MASK );
+	}
+
+	pxFiber = ( xFiberState * )uxFiber;
+	pxFiber->pxCode = pxCode;
+	pxFiber->pvParams = pvParameters;
+	pxFiber->uxCriticalNesting = 0;
+	pxFiber->pvAllocatedStack = pvAllocatedStack;
+	pxFiber->xSwitchingFromHandler = pdFALSE;
+	pxFiber->ullRunTime = 0;
+
+	(void)getcontext( &pxFiber->xContext );
+	pxFiber->xContext.uc_stack.ss_sp = ( void * )uxStackLow;
+	pxFiber->xContext.uc_stack.ss_size = uxFiber - uxStackLow;
+	pxFiber->xContext.uc_link = NULL;
+	/* Tasks start with the tick unblocked, whoever happens to create them. */
+	sigemptyset( &pxFiber->xContext.uc_sigmask );
+	makecontext( &pxFiber->xContext, prvFiberEntry, 0 );
+
+	return ( portSTACK_TYPE * )pxFiber;
+}
+/*-----------------------------------------------------------*/
+
+void vPortCleanUpTCB( void *pxTCB )
+{
+void *pvAllocatedStack = prvGetFiberState( pxTCB )->pvAllocatedStack;
+
+	/* The fiber state itself is inside this allocation. */
+	if ( NULL != pvAllocatedStack )
+	{
+		vPortFree( pvAllocatedStack );
+	}
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * See header file for description.
+ */
+portBASE_TYPE xPortStartScheduler( void )
+{
+struct sigaction sigtick;
+xFiberState *pxFirstFiber;
+
+	hSchedulerThread = pthread_self();
+
+	sigtick.sa_flags = 0;
+	sigtick.sa_handler = vPortSystemTickHandler;
+	sigfillset( &sigtick.sa_mask );
+
+	if ( 0 != sigaction( SIG_TICK, &sigtick, NULL ) )
+	{
+		printf( "Problem installing SIG_TICK\n" );
+	}
+	printf( "Running as PID: %d\n", getpid() );
+
+	/* Interrupts are disabled here already, the first task enables them. */
+	xSchedulerStarted = pdTRUE;
+	prvSetupTimerInterrupt();
+
+	pxFirstFiber = prvGetFiberState( xTaskGetCurrentTaskHandle() );
+	uxCriticalNesting = pxFirstFiber->uxCriticalNesting;
+
+	/* Start the first task. Only returns from vPortEndScheduler(). */
+	(void)swapcontext( &xSchedulerContext, &pxFirstFiber->xContext );
+
+	printf( "Cleaning Up, Exiting.\n" );
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+	/* Stop the tick and resume from where the scheduler was started. */
+	(void)pthread_cancel( hTickThread );
+	xSchedulerStarted = pdFALSE;
+	vPortDisableInterrupts();
+	(void)setcontext( &xSchedulerContext );
+}
+/*-----------------------------------------------------------*/
+
+void vPortYieldFromISR( void )
+{
+xFiberState *pxFiber;
+
+	/* Handled as soon as interrupts are enabled again. */
+	xPendYield = pdTRUE;
+
+	/* An interrupt on another host thread has to wake tickless idle itself. */
+	if ( ( pdTRUE == xSleeping ) && ( 0 == pthread_equal( pthread_self(), hSleepingThread ) ) )
+	{
+		(void)pthread_kill( hSleepingThread, SIG_TICK );
+	}
+
+	/* If the signal interrupted a task that had interrupts enabled, switch on
+	the way out of the handler like the tick does. A handler taken on top of
+	one that switched the fiber out, once it is resumed, only pends the yield,
+	so handler frames never pile up on a fiber's stack. */
+	if ( ( pdTRUE == xSchedulerStarted ) && ( 0 != pthread_equal( pthread_self(), hSchedulerThread ) ) )
+	{
+		pxFiber = prvGetFiberState( xTaskGetCurrentTaskHandle() );
+		if ( pdTRUE != pxFiber->xSwitchingFromHandler )
+		{
+			pxFiber->xSwitchingFromHandler = pdTRUE;
+			while ( ( pdTRUE == xPendYield ) && ( pdTRUE == xInterruptsEnabled ) )
+			{
+				vPortDisableInterrupts();
+				vPortEnableInterrupts();
+			}
+			pxFiber->xSwitchingFromHandler = pdFALSE;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+	vPortDisableInterrupts();
+	uxCriticalNesting++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+	/* Check for unmatched exits. */
+	if ( uxCriticalNesting > 0 )
+	{
+		uxCriticalNesting--;
+	}
+
+	/* If we have reached 0 then re-enable the interrupts. */
+	if( uxCriticalNesting == 0 )
+	{
+		vPortEnableInterrupts();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+	vPortDisableInterrupts();
+
+	prvSwitchFiber();
+
+	/* Back on this task, it may have yielded from within a critical section. */
+	if ( uxCriticalNesting == 0 )
+	{
+		vPortEnableInterrupts();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortDisableInterrupts( void )
+{
+	xInterruptsEnabled = pdFALSE;
+	__atomic_signal_fence( __ATOMIC_SEQ_CST );
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnableInterrupts( void )
+{
+	if ( pdTRUE != xSchedulerStarted )
+	{
+		xInterruptsEnabled = pdTRUE;
+		return;
+	}
+
+	do
+	{
+		vPortDisableInterrupts();
+
+		/* Replay the ticks that arrived while interrupts were disabled. */
+		if ( 0 < __atomic_load_n( &uxPendedTickInterrupts, __ATOMIC_SEQ_CST ) )
+		{
+			prvProcessTicks();
+		}
+
+		if ( pdTRUE == xPendYield )
+		{
+			xPendYield = pdFALSE;
+			prvSwitchFiber();
+		}
+
+		__atomic_signal_fence( __ATOMIC_SEQ_CST );
+		xInterruptsEnabled = pdTRUE;
+
+		/* A tick may have been pended just before enabling. */
+	} while ( 0 < __atomic_load_n( &uxPendedTickInterrupts, __ATOMIC_SEQ_CST ) );
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xPortSetInterruptMask( void )
+{
+portBASE_TYPE xReturn = xInterruptsEnabled;
+	vPortDisableInterrupts();
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMask( portBASE_TYPE xMask )
+{
+	if ( pdTRUE == xMask )
+	{
+		vPortEnableInterrupts();
+	}
+	else
+	{
+		vPortDisableInterrupts();
+	}
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Start the thread that generates the tick interrupts at the required
+ * frequency.
+ */
+void prvSetupTimerInterrupt( void )
+{
+pthread_condattr_t xTickConditionAttributes;
+
+	pthread_condattr_init( &xTickConditionAttributes );
+	(void)pthread_condattr_setclock( &xTickConditionAttributes, TICK_CLOCK );
+	(void)pthread_cond_init( &xTickCondition, &xTickConditionAttributes );
+	pthread_condattr_destroy( &xTickConditionAttributes );
+	(void)clock_gettime( TICK_CLOCK, &xTickStart );
+
+	prvReadTimeModeFromEnvironment();
+	ullTickPeriodNs = portTICK_PERIOD_NANOSECONDS / ulTimeScale;
+	(void)sem_init( &xTickProcessed, 0, 0 );
+
+	if ( 0 != pthread_create( &hTickThread, NULL, prvTickThread, NULL ) )
+	{
+		printf( "Tick thread creation failed.\n" );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void *prvTickThread( void *pvParams )
+{
+struct timespec xDeadline;
+unsigned long long ullNextTick;
+unsigned long long ullTicksDue;
+
+	( void )pvParams;
+
+	(void)pthread_mutex_lock( &xTickMutex );
+
+	for ( ;; )
+	{
+		if ( eFastForward == eTimeMode )
+		{
+			/* Raise the next tick once the last one has been taken. */
+			ullTicksRaised++;
+			vPortPendTicks( 1 );
+			(void)pthread_mutex_unlock( &xTickMutex );
+			(void)pthread_kill( hSchedulerThread, SIG_TICK );
+			for ( ;; )
+			{
+				/* Raise a deferred tick again as nothing else might. */
+				(void)clock_gettime( CLOCK_REALTIME, &xDeadline );
+				xDeadline.tv_nsec += 1000000;
+				if ( xDeadline.tv_nsec >= 1000000000 )
+				{
+					xDeadline.tv_sec++;
+					xDeadline.tv_nsec -= 1000000000;
+				}
+				if ( 0 == sem_timedwait( &xTickProcessed, &xDeadline ) )
+				{
+					break;
+				}
+				(void)pthread_kill( hSchedulerThread, SIG_TICK );
+			}
+			(void)pthread_mutex_lock( &xTickMutex );
+			continue;
+		}
+
+		/* Absolute deadlines don't accumulate the error of each wake up. */
+		ullNextTick = ullTicksRaised + 1;
+		if ( ullSleepUntilTick > ullNextTick )
+		{
+			ullNextTick = ullSleepUntilTick;
+		}
+		prvTickToTimespec( ullNextTick, &xDeadline );
+
+		/* Signalled when tickless idle starts or ends, go round again. */
+		if ( ETIMEDOUT != pthread_cond_timedwait( &xTickCondition, &xTickMutex, &xDeadline ) )
+		{
+			continue;
+		}
+
+		/* Raise every period that has elapsed, not just one per wake up. */
+		ullTicksDue = prvTicksElapsed();
+		if ( ullTicksDue <= ullTicksRaised )
+		{
+			continue;
+		}
+		if ( ullTicksDue > ullNextTick )
+		{
+			ulLateTicks += ( unsigned long )( ullTicksDue - ullNextTick );
+		}
+
+		prvRaiseElapsedTicks();
+		(void)pthread_kill( hSchedulerThread, SIG_TICK );
+	}
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+void prvTickToTimespec( unsigned long long ullTick, struct timespec *pxTime )
+{
+unsigned long long ullNs = ullTick * ullTickPeriodNs + xTickStart.tv_nsec;
+
+	pxTime->tv_sec = xTickStart.tv_sec + ( time_t )( ullNs / 1000000000ULL );
+	pxTime->tv_nsec = ( long )( ullNs % 1000000000ULL );
+}
+/*-----------------------------------------------------------*/
+
+unsigned long long prvTicksElapsed( void )
+{
+struct timespec xNow;
+
+	(void)clock_gettime( TICK_CLOCK, &xNow );
+	return ( ( unsigned long long )( xNow.tv_sec - xTickStart.tv_sec ) * 1000000000ULL + xNow.tv_nsec - xTickStart.tv_nsec ) / ullTickPeriodNs;
+}
+/*-----------------------------------------------------------*/
+
+void prvRaiseElapsedTicks( void )
+{
+/* Must be called with xTickMutex held. */
+unsigned long long ullTicksDue = prvTicksElapsed();
+
+	if ( ullTicksDue > ullTicksRaised )
+	{
+		vPortPendTicks( ( unsigned portBASE_TYPE )( ullTicksDue - ullTicksRaised ) );
+		ullTicksRaised = ullTicksDue;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortPendTicks( unsigned portBASE_TYPE uxTicks )
+{
+	(void)__atomic_add_fetch( &uxPendedTickInterrupts, uxTicks, __ATOMIC_SEQ_CST );
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetTickStats( xPortTickStats *pxStats )
+{
+	pxStats->ulLateTicks = ulLateTicks;
+	pxStats->ulDeferredTicks = ulDeferredTicks;
+	pxStats->ulReplayedTicks = ulReplayedTicks;
+}
+/*-----------------------------------------------------------*/
+
+void vPortSetTimeMode( ePortTimeMode eMode, unsigned long ulScale )
+{
+	eTimeMode = eMode;
+	ulTimeScale = ( ( eScaledTime == eMode ) && ( ulScale > 0 ) ) ? ulScale : 1;
+}
+/*-----------------------------------------------------------*/
+
+void prvReadTimeModeFromEnvironment( void )
+{
+/* FREERTOS_TIME_MODE overrides the mode the program chose, so that unchanged
+binaries can be run in virtual time: "real", "scaled:<k>" or "fast". */
+const char *pcMode = getenv( "FREERTOS_TIME_MODE" );
+
+	if ( NULL == pcMode )
+	{
+		/* Keep the program's choice. */
+	}
+	else if ( 0 == strcmp( pcMode, "real" ) )
+	{
+		vPortSetTimeMode( eRealTime, 1 );
+	}
+	else if ( 0 == strncmp( pcMode, "scaled:", 7 ) )
+	{
+		vPortSetTimeMode( eScaledTime, strtoul( pcMode + 7, NULL, 10 ) );
+	}
+	else if ( 0 == strcmp( pcMode, "fast" ) )
+	{
+		vPortSetTimeMode( eFastForward, 1 );
+	}
+	else
+	{
+		printf( "Unknown FREERTOS_TIME_MODE \"%s\", using real-time.\n", pcMode );
+		vPortSetTimeMode( eRealTime, 1 );
+	}
+
+	if ( eScaledTime == eTimeMode )
+	{
+		printf( "Time runs at %lux real-time.\n", ulTimeScale );
+	}
+	else if ( eFastForward == eTimeMode )
+	{
+		printf( "Time is fast-forwarded.\n" );
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+{
+sigset_t xAllSignals;
+sigset_t xPreviousSignals;
+unsigned portBASE_TYPE uxTicks;
+TickType_t xStep;
+
+	if ( eFastForward == eTimeMode )
+	{
+		/* Nothing to wait for, jump over the idle time. The tick that
+		unblocks the task is left to the tick interrupt. */
+		vPortEnterCritical();
+		(void)pthread_mutex_lock( &xTickMutex );
+		if ( ( eStandardSleep == eTaskConfirmSleepModeStatus() ) && ( 0 == __atomic_load_n( &uxPendedTickInterrupts, __ATOMIC_SEQ_CST ) ) )
+		{
+			vTaskStepTick( xExpectedIdleTime - 1 );
+			vPortPendTicks( 1 );
+		}
+		(void)pthread_mutex_unlock( &xTickMutex );
+		vPortExitCritical();
+		return;
+	}
+
+	/* Nothing may be handled between deciding to sleep and sleeping, or its
+	wake up would be missed. sigsuspend() reopens the mask atomically. */
+	sigfillset( &xAllSignals );
+	(void)pthread_sigmask( SIG_BLOCK, &xAllSignals, &xPreviousSignals );
+	vPortEnterCritical();
+
+	(void)pthread_mutex_lock( &xTickMutex );
+	if ( ( eAbortSleep == eTaskConfirmSleepModeStatus() ) || ( 0 < __atomic_load_n( &uxPendedTickInterrupts, __ATOMIC_SEQ_CST ) ) )
+	{
+		(void)pthread_mutex_unlock( &xTickMutex );
+		(void)pthread_sigmask( SIG_SETMASK, &xPreviousSignals, NULL );
+		vPortExitCritical();
+		return;
+	}
+
+	/* Reprogram the tick thread as a one-shot timer for the wake up tick. */
+	ullSleepUntilTick = ullTicksRaised + xExpectedIdleTime;
+	hSleepingThread = pthread_self();
+	xSleeping = pdTRUE;
+	(void)pthread_cond_signal( &xTickCondition );
+	(void)pthread_mutex_unlock( &xTickMutex );
+
+	/* Woken by the wake up tick or by any other signal, e.g. SIGIO. The scheduler thread is the only one that takes them. */
+	(void)sigsuspend( &xPreviousSignals );
+
+	xSleeping = pdFALSE;
+	(void)pthread_mutex_lock( &xTickMutex );
+	prvRaiseElapsedTicks();
+	ullSleepUntilTick = 0;
+	(void)pthread_cond_signal( &xTickCondition );
+	(void)pthread_mutex_unlock( &xTickMutex );
+
+	/* The kernel can be stepped up to, but not onto, the tick that unblocks a
+	task. That last tick is left to the tick interrupt so that it does the
+	unblocking. */
+	uxTicks = __atomic_exchange_n( &uxPendedTickInterrupts, 0, __ATOMIC_SEQ_CST );
+	xStep = ( uxTicks < xExpectedIdleTime ) ? ( TickType_t )uxTicks : xExpectedIdleTime - 1;
+	vTaskStepTick( xStep );
+	vPortPendTicks( uxTicks - xStep );
+
+	(void)pthread_sigmask( SIG_SETMASK, &xPreviousSignals, NULL );
+	vPortExitCritical();
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_TICKLESS_IDLE */
+
+void vPortSystemTickHandler( int sig )
+{
+	if ( 0 == pthread_equal( pthread_self(), hSchedulerThread ) )
+	{
+		/* Landed on a host thread that doesn't run the tasks, e.g. one of
+		SDL's. Pass it on to the one that does. */
+		(void)pthread_kill( hSchedulerThread, sig );
+		return;
+	}
+
+	if ( pdTRUE == xInterruptsEnabled )
+	{
+		vPortDisableInterrupts();
+		prvProcessTicks();
+		/* Interrupts were enabled when this tick arrived. */
+		vPortEnableInterrupts();
+	}
+	else
+	{
+		/* The ticks stay pending until interrupts are enabled again. */
+		ulDeferredTicks++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void prvProcessTicks( void )
+{
+/* Must be called with interrupts disabled. */
+unsigned portBASE_TYPE uxTicks = __atomic_exchange_n( &uxPendedTickInterrupts, 0, __ATOMIC_SEQ_CST );
+portBASE_TYPE xSwitchRequired = pdFALSE;
+
+	if ( uxTicks > 1 )
+	{
+		ulReplayedTicks += uxTicks - 1;
+	}
+	if ( ( uxTicks > 0 ) && ( eFastForward == eTimeMode ) )
+	{
+		(void)sem_post( &xTickProcessed );
+	}
+
+	/* Ticks that arrive while the scheduler is suspended are added to
+	uxPendedTicks by the kernel and replayed by xTaskResumeAll(). */
+	while ( uxTicks > 0 )
+	{
+		if ( pdFALSE != xTaskIncrementTick() )
+		{
+			xSwitchRequired = pdTRUE;
+		}
+		uxTicks--;
+	}
+
+#if ( configUSE_PREEMPTION == 1 )
+	if ( pdFALSE != xSwitchRequired )
+	{
+		prvSwitchFiber();
+	}
+#else
+	( void )xSwitchRequired;
+#endif
+}
+/*-----------------------------------------------------------*/
+
+void prvSwitchFiber( void )
+{
+/* Must be called with interrupts disabled. */
+xFiberState *pxFromFiber = prvGetFiberState( xTaskGetCurrentTaskHandle() );
+xFiberState *pxToFiber;
+
+	vTaskSwitchContext();
+
+	pxToFiber = prvGetFiberState( xTaskGetCurrentTaskHandle() );
+	if ( pxFromFiber != pxToFiber )
+	{
+		/* Remember and switch the critical nesting. */
+		pxFromFiber->uxCriticalNesting = uxCriticalNesting;
+		uxCriticalNesting = pxToFiber->uxCriticalNesting;
+
+		(void)swapcontext( &pxFromFiber->xContext, &pxToFiber->xContext );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void prvFiberEntry( void )
+{
+xFiberState *pxFiber = prvGetFiberState( xTaskGetCurrentTaskHandle() );
+
+	/* A new task always starts outside of any critical section. */
+	vPortEnableInterrupts();
+
+	pxFiber->pxCode( pxFiber->pvParams );
+
+	/* Tasks must not return, clean up if this one did. */
+	vTaskDelete( NULL );
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long long prvClockNanoseconds( clockid_t xClock )
+{
+struct timespec xNow = { 0 };
+
+	(void)clock_gettime( xClock, &xNow );
+	return ( unsigned long long )xNow.tv_sec * 1000000000ULL + ( unsigned long long )xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFindTicksPerSecond( void )
+{
+	ullRunTimeStart = prvClockNanoseconds( CLOCK_MONOTONIC );
+	ullFiberSwitchedInCpuTime = prvClockNanoseconds( CLOCK_THREAD_CPUTIME_ID );
+}
+/*-----------------------------------------------------------*/
+
+unsigned long long ullPortGetTimerValue( void )
+{
+	return prvClockNanoseconds( CLOCK_MONOTONIC ) - ullRunTimeStart;
+}
+/*-----------------------------------------------------------*/
+
+unsigned long long ullPortGetTaskRunTime( void *pvTaskHandle )
+{
+xFiberState *pxFiber = prvGetFiberState( pvTaskHandle );
+unsigned long long ullNow = prvClockNanoseconds( CLOCK_THREAD_CPUTIME_ID );
+
+	/* The kernel asks for the running task just as it is being switched out,
+	so the CPU time since the last switch belongs to it and the next fiber
+	starts counting from now. Every fiber shares the scheduler thread, whose
+	CPU clock this is. */
+	pxFiber->ullRunTime += ullNow - ullFiberSwitchedInCpuTime;
+	ullFiberSwitchedInCpuTime = ullNow;
+
+	return pxFiber->ullRunTime;
+}
+/*-----------------------------------------------------------*/
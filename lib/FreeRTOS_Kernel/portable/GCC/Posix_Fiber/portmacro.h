@@ -0,0 +1,226 @@
+/*
+	FreeRTOS.org V5.2.0 - Copyright (C) 2003-2009 Richard Barry.
+
+	This file is part of the FreeRTOS.org distribution.
+
+	FreeRTOS.org is free software; you can redistribute it and/or modify it
+	under the terms of the GNU General Public License (version 2) as published
+	by the Free Software Foundation and modified by the FreeRTOS exception.
+
+	FreeRTOS.org is distributed in the hope that it will be useful,	but WITHOUT
+	ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+	FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+	more details.
+
+	You should have received a copy of the GNU General Public License along
+	with FreeRTOS.org; if not, write to the Free Software Foundation, Inc., 59
+	Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+
+	A special exception to the GPL is included to allow you to distribute a
+	combined work that includes FreeRTOS.org without being obliged to provide
+	the source code for any proprietary components.  See the licensing section
+	of http://www.FreeRTOS.org for full details.
+
+
+	***************************************************************************
+	*                                                                         *
+	* Get the FreeRTOS eBook!  See http://www.FreeRTOS.org/Documentation      *
+	*                                                                         *
+	* This is a concise, step by step, 'hands on' guide that describes both   *
+	* general multitasking concepts and FreeRTOS specifics. It presents and   *
+	* explains numerous examples that are written using the FreeRTOS API.     *
+	* Full source code for all the examples is provided in an accompanying    *
+	* .zip file.                                                              *
+	*                                                                         *
+	***************************************************************************
+
+	1 tab == 4 spaces!
+
+	Please ensure to read the configuration and relevant port sections of the
+	online documentation.
+
+	http://www.FreeRTOS.org - Documentation, latest information, license and
+	contact details.
+
+	http://www.SafeRTOS.com - A version that is certified for use in safety
+	critical systems.
+
+	http://www.OpenRTOS.com - Commercial support, development, porting,
+	licensing and training services.
+*/
+
+/*
+ * Single host thread variant of the Posix port, every task is a ucontext
+ * fiber running on the stack that tasks.c allocates for it.
+ * FreeRTOS version V9.0.0
+ * */
+
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*-----------------------------------------------------------
+ * Port specific definitions.
+ *
+ * The settings in this file configure FreeRTOS correctly for the
+ * given hardware and compiler.
+ *
+ * These settings should not be altered.
+ *-----------------------------------------------------------
+ */
+
+/* Type definitions. Legacy*/
+#define portCHAR		char
+#define portFLOAT		float
+#define portDOUBLE		double
+#define portLONG		int
+#define portSHORT		short
+#define portSTACK_TYPE uint32_t
+#define portBASE_TYPE   long
+
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#if( configUSE_16_BIT_TICKS == 1 )
+	typedef uint16_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffff
+#else
+	typedef uint32_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffffffffUL
+
+	/* 32-bit tick type on a 32-bit architecture, so reads of the tick count do
+	not need to be guarded with a critical section. */
+	#define portTICK_TYPE_IS_ATOMIC 1
+#endif
+/*-----------------------------------------------------------*/
+
+/* Architecture specifics. */
+#define portSTACK_GROWTH				( -1 )
+#define portTICK_PERIOD_MS				( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portTICK_PERIOD_MICROSECONDS		( ( TickType_t ) 1000000 / configTICK_RATE_HZ )
+#define portREMOVE_STATIC_QUALIFIER
+
+/* The tasks really run on the stacks allocated by tasks.c, so these have to
+be aligned as the host ABI requires and the full pointer width is needed when
+the kernel calculates the top of stack. */
+#define portBYTE_ALIGNMENT				16
+#define portPOINTER_SIZE_TYPE			uintptr_t
+
+/* The port needs to know both ends of the stack to build the task's context. */
+#define portHAS_STACK_OVERFLOW_CHECKING	1
+
+/* Stacks smaller than this (in bytes) are too small to host C library calls
+and signal frames, tasks created with such a stack are given a separately
+allocated one of this size instead. */
+#ifndef portFIBER_MINIMAL_STACK_SIZE
+	#define portFIBER_MINIMAL_STACK_SIZE	( 64 * 1024 )
+#endif
+/*-----------------------------------------------------------*/
+
+
+/* Scheduler utilities. */
+extern void vPortYieldFromISR( void );
+extern void vPortYield( void );
+
+#define portYIELD()					vPortYield()
+
+#define portEND_SWITCHING_ISR( xSwitchRequired ) if( xSwitchRequired ) vPortYieldFromISR()
+/*-----------------------------------------------------------*/
+
+
+/* Critical section management. */
+extern void vPortDisableInterrupts( void );
+extern void vPortEnableInterrupts( void );
+#define portSET_INTERRUPT_MASK()	( vPortDisableInterrupts() )
+#define portCLEAR_INTERRUPT_MASK()	( vPortEnableInterrupts() )
+
+extern BaseType_t xPortSetInterruptMask( void );
+extern void vPortClearInterruptMask( BaseType_t xMask );
+
+#define portSET_INTERRUPT_MASK_FROM_ISR()		xPortSetInterruptMask()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)	vPortClearInterruptMask(x)
+
+
+extern void vPortEnterCritical( void );
+extern void vPortExitCritical( void );
+
+#define portDISABLE_INTERRUPTS()	portSET_INTERRUPT_MASK()
+#define portENABLE_INTERRUPTS()		portCLEAR_INTERRUPT_MASK()
+#define portENTER_CRITICAL()		vPortEnterCritical()
+#define portEXIT_CRITICAL()			vPortExitCritical()
+/*-----------------------------------------------------------*/
+
+/* Task function macros as described on the FreeRTOS.org WEB site. */
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
+
+#define portNOP()
+
+#define portOUTPUT_BYTE( a, b )
+
+/* Frees the stack the port allocated for tasks whose own stack was too small. */
+extern void vPortCleanUpTCB( void *pxTCB );
+#define portCLEAN_UP_TCB( pxTCB )				vPortCleanUpTCB( pxTCB )
+
+/* The tick thread sleeps until absolute deadlines of TICK_CLOCK and then raises
+SIG_TICK. The real-time tick is used, where time progresses at real-time. */
+#define SIG_TICK					SIGALRM
+#define TICK_CLOCK					CLOCK_MONOTONIC
+/* TICK_CLOCK is also the clock of the tick thread's condition variable, so it
+can only be CLOCK_MONOTONIC or CLOCK_REALTIME. */
+
+/* Ticks that can't be taken when they are raised are kept and replayed, these
+count how often that happened. */
+typedef struct xPORT_TICK_STATS
+{
+	unsigned long ulLateTicks;		/* Periods that had already passed when the tick thread woke up. */
+	unsigned long ulDeferredTicks;	/* Tick signals that found interrupts disabled. */
+	unsigned long ulReplayedTicks;	/* Ticks processed in addition to the first by a tick interrupt. */
+} xPortTickStats;
+
+extern void vPortGetTickStats( xPortTickStats *pxStats );
+extern void vPortPendTicks( unsigned portBASE_TYPE uxTicks );
+
+/* Emulated time can follow the host's clock, run k times faster than it or be
+fast-forwarded, where ticks follow each other as fast as the host can process
+them and idle time is skipped. Call before vTaskStartScheduler(), the
+FREERTOS_TIME_MODE environment variable ("real", "scaled:<k>" or "fast")
+overrides it. */
+typedef enum
+{
+	eRealTime = 0,
+	eScaledTime,
+	eFastForward
+} ePortTimeMode;
+
+extern void vPortSetTimeMode( ePortTimeMode eMode, unsigned long ulScale );
+
+/* Tickless idle, the tick thread becomes a one-shot timer for the tick that
+unblocks the next task and the idle task's thread sleeps until then. */
+extern void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime )	vPortSuppressTicksAndSleep( xExpectedIdleTime )
+
+/* Run-time statistics count nanoseconds. The total is the monotonic time since
+the scheduler started and each task is charged the CPU time the scheduler
+thread used while that task's fiber was running. */
+extern void vPortFindTicksPerSecond( void );
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()	vPortFindTicksPerSecond()
+extern unsigned long long ullPortGetTimerValue( void );
+#define portGET_RUN_TIME_COUNTER_VALUE()			ullPortGetTimerValue()
+extern unsigned long long ullPortGetTaskRunTime( void *pvTaskHandle );
+#define portGET_TASK_RUN_TIME_COUNTER_VALUE( pxTCB )	ullPortGetTaskRunTime( pxTCB )
+#define portLU_PRINTF_SPECIFIER_REQUIRED
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTMACRO_H */
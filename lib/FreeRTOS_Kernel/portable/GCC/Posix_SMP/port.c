@@ -0,0 +1,1093 @@
+/*
+	Copyright (C) 2009 William Davy - william.davy@wittenstein.co.uk
+	Contributed to FreeRTOS.org V5.3.0.
+
+	This file is part of the FreeRTOS.org distribution.
+
+	FreeRTOS.org is free software; you can redistribute it and/or modify it
+	under the terms of the GNU General Public License (version 2) as published
+	by the Free Software Foundation and modified by the FreeRTOS exception.
+
+	FreeRTOS.org is distributed in the hope that it will be useful,	but WITHOUT
+	ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+	FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+	more details.
+
+	You should have received a copy of the GNU General Public License along
+	with FreeRTOS.org; if not, write to the Free Software Foundation, Inc., 59
+	Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+
+	A special exception to the GPL is included to allow you to distribute a
+	combined work that includes FreeRTOS.org without being obliged to provide
+	the source code for any proprietary components.  See the licensing section
+	of http://www.FreeRTOS.org for full details.
+
+
+	***************************************************************************
+	*                                                                         *
+	* Get the FreeRTOS eBook!  See http://www.FreeRTOS.org/Documentation      *
+	*                                                                         *
+	* This is a concise, step by step, 'hands on' guide that describes both   *
+	* general multitasking concepts and FreeRTOS specifics. It presents and   *
+	* explains numerous examples that are written using the FreeRTOS API.     *
+	* Full source code for all the examples is provided in an accompanying    *
+	* .zip file.                                                              *
+	*                                                                         *
+	***************************************************************************
+
+	1 tab == 4 spaces!
+
+	Please ensure to read the configuration and relevant port sections of the
+	online documentation.
+
+	http://www.FreeRTOS.org - Documentation, latest information, license and
+	contact details.
+
+	http://www.SafeRTOS.com - A version that is certified for use in safety
+	critical systems.
+
+	http://www.OpenRTOS.com - Commercial support, development, porting,
+	licensing and training services.
+*/
+
+/*-----------------------------------------------------------
+ * Implementation of functions defined in portable.h for the multi core Posix
+ * port.
+ *
+ * Every task has its own host thread, as in the Posix port, but up to
+ * configNUM_CORES of them run at the same time. Each core runs the thread of
+ * the task that tasks.c selected for it, the other task threads wait on their
+ * own condition variable until a core hands itself over to them.
+ *
+ * The kernel data is guarded by a single lock that critical sections, interrupt
+ * masks and scheduler suspension take recursively. A core is asked to select a
+ * new task by setting its yield request and sending SIG_YIELD to the thread it
+ * runs. The request is also checked whenever a task enters the kernel, so a
+ * task that another core has suspended or deleted does not touch the kernel
+ * again before its core has switched away from it.
+ *
+ * The tick is processed by the tick thread itself, which then asks core 0 to
+ * yield where a switch is required; the other cores are asked by the kernel.
+ *----------------------------------------------------------*/
+
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <errno.h>
+#include <semaphore.h>
+#include <time.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stdio.h>
+#include <unistd.h>
+#include <limits.h>
+#include <sys/mman.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if ( configNUM_CORES < 2 )
+	#error The Posix_SMP port needs configNUM_CORES of 2 or more, use the Posix port for a single core
+#endif
+/*-----------------------------------------------------------*/
+
+/* The state of each task's thread. pxPortInitialiseStack() returns it as the
+task's top of stack, which tasks.c stores as the first member of the TCB. */
+typedef struct THREAD_SUSPENSIONS
+{
+	pthread_t hThread;
+	pdTASK_CODE pxCode;
+	void *pvParams;
+	/* The thread sleeps on its own condition variable until a core hands
+	itself over to it, uxCore is the core it is to run as. */
+	pthread_mutex_t hRunMutex;
+	pthread_cond_t hRunCondition;
+	volatile portBASE_TYPE xRunning;
+	volatile UBaseType_t uxCore;
+#if ( portUSE_HOST_THREAD_STACKS == 1 )
+	/* The stack mapped for the thread, guard page included, and where the
+	task's own use of it starts. */
+	unsigned char *pucStack;
+	size_t xStackSize;
+	unsigned char * volatile pucStackStart;
+	uint32_t ulStackDepth;
+#endif
+	struct THREAD_SUSPENSIONS *pxPrevious;
+	struct THREAD_SUSPENSIONS *pxNext;
+} xThreadState;
+
+#define prvGetThreadState( hTask )	( *( xThreadState * volatile * )( hTask ) )
+
+#define portTICK_PERIOD_NANOSECONDS	( 1000000000ULL / configTICK_RATE_HZ )
+
+/* Lock attempts spun before the lock owner is given the host CPU instead. */
+#define portLOCK_SPINS				( 100 )
+/*-----------------------------------------------------------*/
+
+static xThreadState *pxThreadList = NULL;
+static pthread_mutex_t xThreadListMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_once_t hSigSetupThread = PTHREAD_ONCE_INIT;
+static unsigned long long ullRunTimeStart = 0;
+static pthread_t hTickThread;
+static sem_t xSchedulerEnded;
+static volatile portBASE_TYPE xSchedulerEnd = pdFALSE;
+
+/* The thread each core is running, only changed with the kernel lock held. */
+static xThreadState * volatile pxCoreThreads[ configNUM_CORES ] = { NULL };
+
+/* Set when a core has been asked to select a new task, cleared by that core
+when it does so. */
+static volatile portBASE_TYPE xYieldRequested[ configNUM_CORES ] = { pdFALSE };
+
+/* The kernel lock, the owner's lock ID in the upper half and the recursion
+count in the lower. A single word is changed atomically, so the lock can also
+be taken by a signal handler that interrupted its owner. */
+static volatile uint64_t ullKernelLock = 0;
+static volatile uint32_t ulLastLockID = 0;
+
+/* Everything that describes the calling thread. A task keeps its thread, so
+this is also the state of the task it runs. */
+static __thread xThreadState *pxThisThread = NULL;
+static __thread volatile UBaseType_t uxThisCore = 0;
+static __thread volatile unsigned portBASE_TYPE uxCriticalNesting = 0;
+static __thread volatile portBASE_TYPE xInterruptsEnabled = pdTRUE;
+static __thread uint32_t ulThisLockID = 0;
+
+/* Ticks raised by the tick thread that have not been processed yet. */
+static volatile unsigned portBASE_TYPE uxPendingTicks = 0;
+static volatile unsigned long ulLateTicks = 0;
+static volatile unsigned long ulDeferredTicks = 0;
+static volatile unsigned long ulReplayedTicks = 0;
+
+/* The tick thread's time line and how emulated time relates to the host's. */
+static struct timespec xTickStart;
+static unsigned long long ullTicksRaised = 0;
+static ePortTimeMode eTimeMode = eRealTime;
+static unsigned long ulTimeScale = 1;
+static unsigned long long ullTickPeriodNs = portTICK_PERIOD_NANOSECONDS;
+/*-----------------------------------------------------------*/
+
+static uint32_t prvGetLockID( void );
+static portBASE_TYPE prvTryLock( void );
+static void prvLock( void );
+static void prvUnlock( void );
+static void prvEnterKernel( portBASE_TYPE xMayYield );
+static void prvSetupTimerInterrupt( void );
+static void *prvTickThread( void *pvParams );
+static void prvTickToTimespec( unsigned long long ullTick, struct timespec *pxTime );
+static unsigned long long prvTicksElapsed( void );
+static void prvReadTimeModeFromEnvironment( void );
+static unsigned long long prvClockNanoseconds( clockid_t xClock );
+static void prvProcessPendingTicks( void );
+static void *prvWaitForStart( void * pvParams );
+static void prvYieldSignalHandler( int sig );
+static void prvSetupSignals( void );
+static void prvSuspendThread( xThreadState *pxThread );
+static void prvResumeThread( xThreadState *pxThread );
+static void prvUnlockRunMutex( void *pvThread );
+static void prvLinkThread( xThreadState *pxThread );
+static void prvUnlinkThread( xThreadState *pxThread );
+#if ( portUSE_HOST_THREAD_STACKS == 1 )
+static size_t prvHostStackSize( uint32_t ulStackDepth );
+static size_t prvStackBytesUsed( xThreadState *pxThread );
+#endif
+/*-----------------------------------------------------------*/
+
+#if ( portUSE_HOST_THREAD_STACKS == 1 )
+
+size_t prvHostStackSize( uint32_t ulStackDepth )
+{
+size_t xSize = ( size_t )ulStackDepth * sizeof( portSTACK_TYPE ) * portHOST_STACK_SCALE;
+size_t xPageSize = ( size_t )sysconf( _SC_PAGESIZE );
+
+	if ( xSize < portHOST_MINIMAL_STACK_SIZE )
+	{
+		xSize = portHOST_MINIMAL_STACK_SIZE;
+	}
+	if ( xSize < PTHREAD_STACK_MIN )
+	{
+		xSize = PTHREAD_STACK_MIN;
+	}
+	return ( xSize + xPageSize - 1 ) & ~( xPageSize - 1 );
+}
+/*-----------------------------------------------------------*/
+
+size_t prvStackBytesUsed( xThreadState *pxThread )
+{
+/* Pages of the stack that were never touched are not resident, and they read
+as zero when they are (mlockall() without MCL_ONFAULT, or the prefault), so the
+deepest byte the task used is the lowest non-zero one. A zero the task wrote at
+the very bottom isn't seen, which can only make the estimate a little low. */
+size_t xPageSize = ( size_t )sysconf( _SC_PAGESIZE );
+unsigned char *pucBottom = pxThread->pucStack + xPageSize;
+unsigned char *pucStart = pxThread->pucStackStart;
+unsigned char *pucPage;
+unsigned char ucResident[ 64 ];
+size_t xPage = sizeof( ucResident );
+size_t xOffset;
+
+	if ( NULL == pucStart )
+	{
+		/* The thread hasn't started yet. */
+		return 0;
+	}
+
+	for ( pucPage = pucBottom; pucPage < pucStart; pucPage += xPageSize, xPage++ )
+	{
+		/* Residency is asked for a batch of pages at a time, the last batch
+		can go past the task's part of the stack but not past the mapping. */
+		if ( sizeof( ucResident ) == xPage )
+		{
+			xPage = 0;
+			if ( 0 != mincore( pucPage, sizeof( ucResident ) * xPageSize < ( size_t )( pucStart - pucPage ) ? sizeof( ucResident ) * xPageSize : ( size_t )( pucStart - pucPage ), ucResident ) )
+			{
+				memset( ucResident, 1, sizeof( ucResident ) );
+			}
+		}
+		if ( 0 == ( ucResident[ xPage ] & 1 ) )
+		{
+			continue;
+		}
+
+		/* Whole words are compared first, the page is word aligned. */
+		for ( xOffset = 0; ( xOffset < xPageSize ) && ( pucPage + xOffset < pucStart ); xOffset += sizeof( uintptr_t ) )
+		{
+			if ( 0 != *( uintptr_t * )( pucPage + xOffset ) )
+			{
+				while ( 0 == pucPage[ xOffset ] )
+				{
+					xOffset++;
+				}
+				if ( pucPage + xOffset < pucStart )
+				{
+					return ( size_t )( pucStart - ( pucPage + xOffset ) );
+				}
+				return 0;
+			}
+		}
+	}
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetStackBytesUsed( void *pxTask )
+{
+	return prvStackBytesUsed( prvGetThreadState( pxTask ) );
+}
+/*-----------------------------------------------------------*/
+
+unsigned portBASE_TYPE uxPortGetStackHighWaterMark( void *pxTCB )
+{
+xThreadState *pxThread = prvGetThreadState( pxTCB );
+size_t xTargetBytes = sizeof( portSTACK_TYPE ) * portHOST_STACK_SCALE;
+size_t xUsedWords = ( prvStackBytesUsed( pxThread ) + xTargetBytes - 1 ) / xTargetBytes;
+
+	if ( xUsedWords >= pxThread->ulStackDepth )
+	{
+		return 0;
+	}
+	return ( unsigned portBASE_TYPE )( pxThread->ulStackDepth - xUsedWords );
+}
+/*-----------------------------------------------------------*/
+
+#endif /* portUSE_HOST_THREAD_STACKS */
+
+/*
+ * See header file for description.
+ */
+#if ( portUSE_HOST_THREAD_STACKS == 1 )
+portSTACK_TYPE *pxPortInitialiseStack( uint32_t ulStackDepth, pdTASK_CODE pxCode, void *pvParameters )
+#else
+portSTACK_TYPE *pxPortInitialiseStack( portSTACK_TYPE *pxTopOfStack, pdTASK_CODE pxCode, void *pvParameters )
+#endif
+{
+xThreadState *pxThread = pvPortMalloc( sizeof( xThreadState ) );
+pthread_attr_t xThreadAttributes;
+sigset_t xAllSignals;
+sigset_t xPreviousSignals;
+
+	(void)pthread_once( &hSigSetupThread, prvSetupSignals );
+
+#if ( portUSE_HOST_THREAD_STACKS == 1 )
+	/* Mapped here to put a guard page below the stack and to measure its
+	high water mark, as in the Posix port. */
+	pxThread->xStackSize = prvHostStackSize( ulStackDepth ) + ( size_t )sysconf( _SC_PAGESIZE );
+	pxThread->pucStack = mmap( NULL, pxThread->xStackSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_STACK, -1, 0 );
+	if ( MAP_FAILED == pxThread->pucStack )
+	{
+		printf( "Task stack allocation failed.\n" );
+		vPortFree( pxThread );
+		return 0;
+	}
+	(void)mprotect( pxThread->pucStack, ( size_t )sysconf( _SC_PAGESIZE ), PROT_NONE );
+	pxThread->pucStackStart = NULL;
+	pxThread->ulStackDepth = ulStackDepth;
+#endif
+	pxThread->pxCode = pxCode;
+	pxThread->pvParams = pvParameters;
+	pxThread->xRunning = pdFALSE;
+	pxThread->uxCore = 0;
+	(void)pthread_mutex_init( &pxThread->hRunMutex, NULL );
+	(void)pthread_cond_init( &pxThread->hRunCondition, NULL );
+
+	/* The thread starts with every signal blocked, so none is handled by a
+	task thread that no core runs. The threads are joined when the task's TCB
+	is cleaned up. */
+	sigfillset( &xAllSignals );
+	(void)pthread_sigmask( SIG_BLOCK, &xAllSignals, &xPreviousSignals );
+	pthread_attr_init( &xThreadAttributes );
+#if ( portUSE_HOST_THREAD_STACKS == 1 )
+	(void)pthread_attr_setstack( &xThreadAttributes, pxThread->pucStack + sysconf( _SC_PAGESIZE ), prvHostStackSize( ulStackDepth ) );
+#endif
+	if ( 0 != pthread_create( &pxThread->hThread, &xThreadAttributes, prvWaitForStart, (void *)pxThread ) )
+	{
+		printf( "Task thread creation failed.\n" );
+		pthread_attr_destroy( &xThreadAttributes );
+		(void)pthread_sigmask( SIG_SETMASK, &xPreviousSignals, NULL );
+		(void)pthread_cond_destroy( &pxThread->hRunCondition );
+		(void)pthread_mutex_destroy( &pxThread->hRunMutex );
+#if ( portUSE_HOST_THREAD_STACKS == 1 )
+		(void)munmap( pxThread->pucStack, pxThread->xStackSize );
+#endif
+		vPortFree( pxThread );
+		return 0;
+	}
+	pthread_attr_destroy( &xThreadAttributes );
+	(void)pthread_sigmask( SIG_SETMASK, &xPreviousSignals, NULL );
+
+	prvLinkThread( pxThread );
+
+#if ( portUSE_HOST_THREAD_STACKS == 0 )
+	( void )pxTopOfStack;
+#endif
+	return ( portSTACK_TYPE * )pxThread;
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * See header file for description.
+ */
+portBASE_TYPE xPortStartScheduler( void )
+{
+sigset_t xAllSignals;
+xThreadState *pxThread;
+UBaseType_t uxCore;
+
+	/* Signals are handled by the task threads only. */
+	sigfillset( &xAllSignals );
+	(void)pthread_sigmask( SIG_SETMASK, &xAllSignals, NULL );
+	(void)sem_init( &xSchedulerEnded, 0, 0 );
+
+	/* Start the timer that generates the tick ISR. */
+	prvSetupTimerInterrupt();
+
+	/* Start every core on the task that the kernel selected for it. */
+	prvLock();
+	for ( uxCore = 0; uxCore < configNUM_CORES; uxCore++ )
+	{
+		pxThread = prvGetThreadState( xTaskGetCurrentTaskHandleForCore( ( BaseType_t )uxCore ) );
+		pxThread->uxCore = uxCore;
+		pxCoreThreads[ uxCore ] = pxThread;
+	}
+	for ( uxCore = 0; uxCore < configNUM_CORES; uxCore++ )
+	{
+		prvResumeThread( pxCoreThreads[ uxCore ] );
+	}
+	prvUnlock();
+
+	while ( pdTRUE != xSchedulerEnd )
+	{
+		(void)sem_wait( &xSchedulerEnded );
+	}
+
+	printf( "Cleaning Up, Exiting.\n" );
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+xThreadState *pxThread;
+
+	(void)pthread_cancel( hTickThread );
+
+	/* Stop the thread of every other task, the calling one exits below. */
+	(void)pthread_mutex_lock( &xThreadListMutex );
+	for ( pxThread = pxThreadList; NULL != pxThread; pxThread = pxThread->pxNext )
+	{
+		if ( pxThread != pxThisThread )
+		{
+			(void)pthread_cancel( pxThread->hThread );
+		}
+	}
+	(void)pthread_mutex_unlock( &xThreadListMutex );
+
+	/* Signal the scheduler to exit its loop. */
+	xSchedulerEnd = pdTRUE;
+	(void)sem_post( &xSchedulerEnded );
+
+	if ( NULL != pxThisThread )
+	{
+		pthread_exit( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPortGetCoreID( void )
+{
+	return uxThisCore;
+}
+/*-----------------------------------------------------------*/
+
+void vPortYieldCore( UBaseType_t uxCore )
+{
+	/* Called by the kernel with the lock held. The request is also picked up
+	when the core next enters the kernel, should the signal be late. */
+	prvLock();
+	__atomic_store_n( &xYieldRequested[ uxCore ], pdTRUE, __ATOMIC_SEQ_CST );
+	if ( NULL != pxCoreThreads[ uxCore ] )
+	{
+		(void)pthread_kill( pxCoreThreads[ uxCore ]->hThread, SIG_YIELD );
+	}
+	prvUnlock();
+}
+/*-----------------------------------------------------------*/
+
+void vPortYieldFromISR( void )
+{
+	if ( NULL == pxThisThread )
+	{
+		/* Interrupts on threads other than the task threads, the tick thread
+		included, are taken by core 0. */
+		vPortYieldCore( 0 );
+	}
+	else
+	{
+		/* Switches now, or as soon as interrupts are enabled again. */
+		vPortYield();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+xThreadState *pxThread = pxThisThread;
+xThreadState *pxNext;
+UBaseType_t uxCore;
+sigset_t xAllSignals;
+sigset_t xPreviousSignals;
+
+	if ( ( uxCriticalNesting > 0 ) || ( pdFALSE == xInterruptsEnabled ) )
+	{
+		/* Like a pended interrupt, the yield is taken when the critical
+		section is left or interrupts are enabled. */
+		__atomic_store_n( &xYieldRequested[ uxThisCore ], pdTRUE, __ATOMIC_SEQ_CST );
+		return;
+	}
+
+	/* The thread must not handle a signal, e.g. one that takes the kernel
+	lock, while it is handing its core over or waiting to get one back. */
+	sigfillset( &xAllSignals );
+	(void)pthread_sigmask( SIG_BLOCK, &xAllSignals, &xPreviousSignals );
+	xInterruptsEnabled = pdFALSE;
+
+	do
+	{
+		prvLock();
+		uxCore = uxThisCore;
+		__atomic_store_n( &xYieldRequested[ uxCore ], pdFALSE, __ATOMIC_SEQ_CST );
+
+		vTaskSwitchContext();
+		pxNext = prvGetThreadState( xTaskGetCurrentTaskHandleForCore( ( BaseType_t )uxCore ) );
+
+		if ( pxNext != pxThread )
+		{
+			/* Hand the core over. This thread may be selected by another
+			core before it has gone to sleep, the xRunning flag covers that. */
+			pxThread->xRunning = pdFALSE;
+			pxNext->uxCore = uxCore;
+			pxCoreThreads[ uxCore ] = pxNext;
+			prvResumeThread( pxNext );
+			prvUnlock();
+
+			/* Sets uxThisCore to the core this thread is resumed on. */
+			prvSuspendThread( pxThread );
+		}
+		else
+		{
+			prvUnlock();
+		}
+	} while ( pdFALSE != __atomic_load_n( &xYieldRequested[ uxThisCore ], __ATOMIC_SEQ_CST ) );
+
+	xInterruptsEnabled = pdTRUE;
+	(void)pthread_sigmask( SIG_SETMASK, &xPreviousSignals, NULL );
+}
+/*-----------------------------------------------------------*/
+
+void vPortIdleWaitForInterrupt( void )
+{
+sigset_t xAllSignals;
+sigset_t xPreviousSignals;
+
+	/* A yield request that arrives between checking for it and sleeping would
+	be missed, sigsuspend() reopens the mask atomically. */
+	sigfillset( &xAllSignals );
+	(void)pthread_sigmask( SIG_BLOCK, &xAllSignals, &xPreviousSignals );
+
+	if ( pdFALSE == __atomic_load_n( &xYieldRequested[ uxThisCore ], __ATOMIC_SEQ_CST ) )
+	{
+		(void)sigsuspend( &xPreviousSignals );
+	}
+
+	(void)pthread_sigmask( SIG_SETMASK, &xPreviousSignals, NULL );
+
+	/* A request that was raised while the signal was blocked. */
+	if ( pdFALSE != __atomic_load_n( &xYieldRequested[ uxThisCore ], __ATOMIC_SEQ_CST ) )
+	{
+		vPortYield();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+portBASE_TYPE xWasEnabled = xInterruptsEnabled;
+
+	xInterruptsEnabled = pdFALSE;
+
+	/* Only the outermost entry may switch away first. */
+	prvEnterKernel( ( pdFALSE != xWasEnabled ) && ( 0 == uxCriticalNesting ) );
+	uxCriticalNesting++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+	/* Check for unmatched exits. */
+	if ( uxCriticalNesting > 0 )
+	{
+		uxCriticalNesting--;
+		prvUnlock();
+	}
+
+	/* If we have reached 0 then re-enable the interrupts. */
+	if ( uxCriticalNesting == 0 )
+	{
+		xInterruptsEnabled = pdTRUE;
+
+		/* Take a yield that was held off by the critical section. */
+		if ( ( NULL != pxThisThread ) && ( pdFALSE != __atomic_load_n( &xYieldRequested[ uxThisCore ], __ATOMIC_SEQ_CST ) ) )
+		{
+			vPortYield();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetTaskLock( void )
+{
+	prvLock();
+}
+/*-----------------------------------------------------------*/
+
+void vPortReleaseTaskLock( void )
+{
+	prvUnlock();
+}
+/*-----------------------------------------------------------*/
+
+void vPortDisableInterrupts( void )
+{
+	xInterruptsEnabled = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnableInterrupts( void )
+{
+	xInterruptsEnabled = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE xPortSetInterruptMask( void )
+{
+portBASE_TYPE xReturn = xInterruptsEnabled;
+
+	xInterruptsEnabled = pdFALSE;
+	prvLock();
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMask( portBASE_TYPE xMask )
+{
+	prvUnlock();
+	xInterruptsEnabled = xMask;
+
+	if ( ( pdFALSE != xMask ) && ( 0 == uxCriticalNesting ) && ( NULL != pxThisThread ) &&
+		 ( pdFALSE != __atomic_load_n( &xYieldRequested[ uxThisCore ], __ATOMIC_SEQ_CST ) ) )
+	{
+		vPortYield();
+	}
+}
+/*-----------------------------------------------------------*/
+
+uint32_t prvGetLockID( void )
+{
+	if ( 0 == ulThisLockID )
+	{
+		ulThisLockID = __atomic_add_fetch( &ulLastLockID, 1, __ATOMIC_SEQ_CST );
+	}
+
+	return ulThisLockID;
+}
+/*-----------------------------------------------------------*/
+
+portBASE_TYPE prvTryLock( void )
+{
+uint64_t ullID = prvGetLockID();
+uint64_t ullLock = __atomic_load_n( &ullKernelLock, __ATOMIC_ACQUIRE );
+
+	if ( ( ullLock >> 32 ) == ullID )
+	{
+		/* Taken recursively. A signal handler on this thread leaves the count
+		as it found it, so only this thread changes the word now. */
+		__atomic_store_n( &ullKernelLock, ullLock + 1, __ATOMIC_RELAXED );
+		return pdTRUE;
+	}
+
+	if ( ( 0 == ullLock ) && __atomic_compare_exchange_n( &ullKernelLock, &ullLock, ( ullID << 32 ) | 1, pdFALSE, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED ) )
+	{
+		return pdTRUE;
+	}
+
+	return pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void prvLock( void )
+{
+unsigned long ulSpins = 0;
+
+	while ( pdFALSE == prvTryLock() )
+	{
+		/* The owner may not be running on the host at all, so only spin for a
+		short while before letting it have the CPU. */
+		if ( ++ulSpins < portLOCK_SPINS )
+		{
+#if defined( __x86_64__ ) || defined( __i386__ )
+			__builtin_ia32_pause();
+#endif
+		}
+		else
+		{
+			(void)sched_yield();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void prvUnlock( void )
+{
+uint64_t ullLock = __atomic_load_n( &ullKernelLock, __ATOMIC_RELAXED );
+
+	configASSERT( ( ullLock >> 32 ) == prvGetLockID() );
+
+	/* The last release clears the owner as well. */
+	__atomic_store_n( &ullKernelLock, ( 1 == ( ullLock & 0xffffffffULL ) ) ? 0 : ullLock - 1, __ATOMIC_RELEASE );
+}
+/*-----------------------------------------------------------*/
+
+void prvEnterKernel( portBASE_TYPE xMayYield )
+{
+/* Must be called with interrupts disabled. */
+	prvLock();
+
+	/* A task that another core has suspended, deleted or preempted keeps
+	running until its core handles the request, it must not change the kernel
+	in the meantime. Switching is only possible if this is not a nested
+	acquisition, e.g. with the scheduler suspended. */
+	while ( ( pdFALSE != xMayYield ) && ( NULL != pxThisThread ) &&
+			( 1 == ( ullKernelLock & 0xffffffffULL ) ) &&
+			( pdFALSE != __atomic_load_n( &xYieldRequested[ uxThisCore ], __ATOMIC_SEQ_CST ) ) )
+	{
+		prvUnlock();
+		xInterruptsEnabled = pdTRUE;
+		vPortYield();
+		xInterruptsEnabled = pdFALSE;
+		prvLock();
+	}
+}
+/*-----------------------------------------------------------*/
+
+/*
+ * Start the thread that generates the tick interrupts at the required
+ * frequency.
+ */
+void prvSetupTimerInterrupt( void )
+{
+pthread_attr_t xTickThreadAttributes;
+
+	(void)clock_gettime( TICK_CLOCK, &xTickStart );
+
+	prvReadTimeModeFromEnvironment();
+	ullTickPeriodNs = portTICK_PERIOD_NANOSECONDS / ulTimeScale;
+
+	/* The thread inherits the fully blocked signal mask of the caller. */
+	pthread_attr_init( &xTickThreadAttributes );
+	if ( 0 != pthread_create( &hTickThread, &xTickThreadAttributes, prvTickThread, NULL ) )
+	{
+		printf( "Tick thread creation failed.\n" );
+	}
+	pthread_attr_destroy( &xTickThreadAttributes );
+}
+/*-----------------------------------------------------------*/
+
+void *prvTickThread( void *pvParams )
+{
+struct timespec xDeadline;
+unsigned long long ullNextTick;
+unsigned long long ullTicksDue;
+
+	( void )pvParams;
+
+	for ( ;; )
+	{
+		/* Absolute deadlines don't accumulate the error of each wake up. */
+		ullNextTick = ullTicksRaised + 1;
+		prvTickToTimespec( ullNextTick, &xDeadline );
+		if ( 0 != clock_nanosleep( TICK_CLOCK, TIMER_ABSTIME, &xDeadline, NULL ) )
+		{
+			continue;
+		}
+
+		/* Raise every period that has elapsed, not just one per wake up. */
+		ullTicksDue = prvTicksElapsed();
+		if ( ullTicksDue <= ullTicksRaised )
+		{
+			continue;
+		}
+		if ( ullTicksDue > ullNextTick )
+		{
+			ulLateTicks += ( unsigned long )( ullTicksDue - ullNextTick );
+		}
+		vPortPendTicks( ( unsigned portBASE_TYPE )( ullTicksDue - ullTicksRaised ) );
+		ullTicksRaised = ullTicksDue;
+
+		prvProcessPendingTicks();
+	}
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+void prvTickToTimespec( unsigned long long ullTick, struct timespec *pxTime )
+{
+unsigned long long ullNs = ullTick * ullTickPeriodNs + xTickStart.tv_nsec;
+
+	pxTime->tv_sec = xTickStart.tv_sec + ( time_t )( ullNs / 1000000000ULL );
+	pxTime->tv_nsec = ( long )( ullNs % 1000000000ULL );
+}
+/*-----------------------------------------------------------*/
+
+unsigned long long prvTicksElapsed( void )
+{
+struct timespec xNow;
+
+	(void)clock_gettime( TICK_CLOCK, &xNow );
+	return ( ( unsigned long long )( xNow.tv_sec - xTickStart.tv_sec ) * 1000000000ULL + xNow.tv_nsec - xTickStart.tv_nsec ) / ullTickPeriodNs;
+}
+/*-----------------------------------------------------------*/
+
+void vPortPendTicks( unsigned portBASE_TYPE uxTicks )
+{
+	(void)__atomic_add_fetch( &uxPendingTicks, uxTicks, __ATOMIC_SEQ_CST );
+}
+/*-----------------------------------------------------------*/
+
+void vPortGetTickStats( xPortTickStats *pxStats )
+{
+	pxStats->ulLateTicks = ulLateTicks;
+	pxStats->ulDeferredTicks = ulDeferredTicks;
+	pxStats->ulReplayedTicks = ulReplayedTicks;
+}
+/*-----------------------------------------------------------*/
+
+void vPortSetTimeMode( ePortTimeMode eMode, unsigned long ulScale )
+{
+	eTimeMode = eMode;
+	ulTimeScale = ( ( eScaledTime == eMode ) && ( ulScale > 0 ) ) ? ulScale : 1;
+}
+/*-----------------------------------------------------------*/
+
+void prvReadTimeModeFromEnvironment( void )
+{
+/* FREERTOS_TIME_MODE overrides the mode the program chose, so that unchanged
+binaries can be run in scaled time: "real" or "scaled:<k>". */
+const char *pcMode = getenv( "FREERTOS_TIME_MODE" );
+
+	if ( NULL == pcMode )
+	{
+		/* Keep the program's choice. */
+	}
+	else if ( 0 == strcmp( pcMode, "real" ) )
+	{
+		vPortSetTimeMode( eRealTime, 1 );
+	}
+	else if ( 0 == strncmp( pcMode, "scaled:", 7 ) )
+	{
+		vPortSetTimeMode( eScaledTime, strtoul( pcMode + 7, NULL, 10 ) );
+	}
+	else if ( 0 == strcmp( pcMode, "fast" ) )
+	{
+		vPortSetTimeMode( eFastForward, 1 );
+	}
+	else
+	{
+		printf( "Unknown FREERTOS_TIME_MODE \"%s\", using real-time.\n", pcMode );
+		vPortSetTimeMode( eRealTime, 1 );
+	}
+
+	if ( eFastForward == eTimeMode )
+	{
+		printf( "Fast-forward is not supported with more than one core, using real-time.\n" );
+		vPortSetTimeMode( eRealTime, 1 );
+	}
+	else if ( eScaledTime == eTimeMode )
+	{
+		printf( "Time runs at %lux real-time.\n", ulTimeScale );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void prvProcessPendingTicks( void )
+{
+unsigned portBASE_TYPE uxTicks;
+portBASE_TYPE xSwitchRequired = pdFALSE;
+
+	/* The tick waits for whichever core holds the kernel, e.g. with the
+	scheduler suspended. */
+	if ( pdFALSE == prvTryLock() )
+	{
+		ulDeferredTicks++;
+		prvLock();
+	}
+
+	uxTicks = __atomic_exchange_n( &uxPendingTicks, 0, __ATOMIC_SEQ_CST );
+	if ( uxTicks > 1 )
+	{
+		ulReplayedTicks += uxTicks - 1;
+	}
+
+	/* The kernel asks the other cores to yield itself, a switch required on
+	core 0 is returned. */
+	while ( uxTicks > 0 )
+	{
+		if ( pdFALSE != xTaskIncrementTick() )
+		{
+			xSwitchRequired = pdTRUE;
+		}
+		uxTicks--;
+	}
+
+#if ( configUSE_PREEMPTION == 1 )
+	if ( pdFALSE != xSwitchRequired )
+	{
+		vPortYieldCore( 0 );
+	}
+#endif
+
+	prvUnlock();
+}
+/*-----------------------------------------------------------*/
+
+void vPortCleanUpTCB( void *pxTCB )
+{
+xThreadState *pxThread = prvGetThreadState( pxTCB );
+
+	if ( NULL == pxThread )
+	{
+		/* The thread was never created. */
+		return;
+	}
+
+	/* The task is no longer running on any core, so its thread is waiting in
+	prvSuspendThread() or about to. Don't free the state while the thread
+	might still be using it. */
+	(void)pthread_cancel( pxThread->hThread );
+	(void)pthread_join( pxThread->hThread, NULL );
+
+	prvUnlinkThread( pxThread );
+
+	(void)pthread_cond_destroy( &pxThread->hRunCondition );
+	(void)pthread_mutex_destroy( &pxThread->hRunMutex );
+#if ( portUSE_HOST_THREAD_STACKS == 1 )
+	(void)munmap( pxThread->pucStack, pxThread->xStackSize );
+#endif
+	vPortFree( pxThread );
+}
+/*-----------------------------------------------------------*/
+
+void *prvWaitForStart( void * pvParams )
+{
+xThreadState *pxThread = ( xThreadState * )pvParams;
+sigset_t xNoSignals;
+
+#if ( portUSE_HOST_THREAD_STACKS == 1 )
+	/* What the C library keeps at the top of the stack isn't the task's. */
+	pxThread->pucStackStart = __builtin_frame_address( 0 );
+#endif
+	pxThisThread = pxThread;
+	prvSuspendThread( pxThread );
+
+	/* Started by a core, the task runs with interrupts enabled and may handle
+	signals from now on. */
+	uxCriticalNesting = 0;
+	xInterruptsEnabled = pdTRUE;
+	sigemptyset( &xNoSignals );
+	(void)pthread_sigmask( SIG_SETMASK, &xNoSignals, NULL );
+
+	pxThread->pxCode( pxThread->pvParams );
+
+	return (void *)NULL;
+}
+/*-----------------------------------------------------------*/
+
+void prvYieldSignalHandler( int sig )
+{
+	( void )sig;
+
+	/* Another core asked this one to select a new task. With interrupts
+	disabled the request is taken when they are enabled again. */
+	if ( ( NULL != pxThisThread ) && ( pdFALSE != xInterruptsEnabled ) && ( pdTRUE == pxThisThread->xRunning ) &&
+		 ( pdFALSE != __atomic_load_n( &xYieldRequested[ uxThisCore ], __ATOMIC_SEQ_CST ) ) )
+	{
+		vPortYield();
+	}
+}
+/*-----------------------------------------------------------*/
+
+void prvSuspendThread( xThreadState *pxThread )
+{
+/* Must be called by the thread itself with every signal blocked. */
+
+	/* The wait is a cancellation point, don't die holding the mutex. */
+	(void)pthread_mutex_lock( &pxThread->hRunMutex );
+	pthread_cleanup_push( prvUnlockRunMutex, pxThread );
+	while ( pdFALSE == pxThread->xRunning )
+	{
+		(void)pthread_cond_wait( &pxThread->hRunCondition, &pxThread->hRunMutex );
+	}
+	pthread_cleanup_pop( 1 );
+
+	uxThisCore = pxThread->uxCore;
+}
+/*-----------------------------------------------------------*/
+
+void prvResumeThread( xThreadState *pxThread )
+{
+	/* Must be called with the kernel lock held. */
+	(void)pthread_mutex_lock( &pxThread->hRunMutex );
+	pxThread->xRunning = pdTRUE;
+	(void)pthread_cond_signal( &pxThread->hRunCondition );
+	(void)pthread_mutex_unlock( &pxThread->hRunMutex );
+}
+/*-----------------------------------------------------------*/
+
+void prvUnlockRunMutex( void *pvThread )
+{
+	(void)pthread_mutex_unlock( &( ( xThreadState * )pvThread )->hRunMutex );
+}
+/*-----------------------------------------------------------*/
+
+void prvSetupSignals( void )
+{
+struct sigaction sigyield;
+
+	/* Host calls that a task made when the signal arrived are restarted. */
+	sigyield.sa_flags = SA_RESTART;
+	sigyield.sa_handler = prvYieldSignalHandler;
+	sigfillset( &sigyield.sa_mask );
+
+	if ( 0 != sigaction( SIG_YIELD, &sigyield, NULL ) )
+	{
+		printf( "Problem installing SIG_YIELD\n" );
+	}
+	printf( "Running as PID: %d\n", getpid() );
+}
+/*-----------------------------------------------------------*/
+
+void prvLinkThread( xThreadState *pxThread )
+{
+	/* The list is only walked to cancel every thread at the end. */
+	(void)pthread_mutex_lock( &xThreadListMutex );
+	pxThread->pxPrevious = NULL;
+	pxThread->pxNext = pxThreadList;
+	if ( NULL != pxThreadList )
+	{
+		pxThreadList->pxPrevious = pxThread;
+	}
+	pxThreadList = pxThread;
+	(void)pthread_mutex_unlock( &xThreadListMutex );
+}
+/*-----------------------------------------------------------*/
+
+void prvUnlinkThread( xThreadState *pxThread )
+{
+	(void)pthread_mutex_lock( &xThreadListMutex );
+	if ( NULL != pxThread->pxPrevious )
+	{
+		pxThread->pxPrevious->pxNext = pxThread->pxNext;
+	}
+	else
+	{
+		pxThreadList = pxThread->pxNext;
+	}
+
+	if ( NULL != pxThread->pxNext )
+	{
+		pxThread->pxNext->pxPrevious = pxThread->pxPrevious;
+	}
+	(void)pthread_mutex_unlock( &xThreadListMutex );
+}
+/*-----------------------------------------------------------*/
+
+static unsigned long long prvClockNanoseconds( clockid_t xClock )
+{
+struct timespec xNow = { 0 };
+
+	(void)clock_gettime( xClock, &xNow );
+	return ( unsigned long long )xNow.tv_sec * 1000000000ULL + ( unsigned long long )xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFindTicksPerSecond( void )
+{
+	ullRunTimeStart = prvClockNanoseconds( CLOCK_MONOTONIC );
+}
+/*-----------------------------------------------------------*/
+
+unsigned long long ullPortGetTimerValue( void )
+{
+	return prvClockNanoseconds( CLOCK_MONOTONIC ) - ullRunTimeStart;
+}
+/*-----------------------------------------------------------*/
+
+unsigned long long ullPortGetTaskRunTime( void *pvTaskHandle )
+{
+xThreadState *pxThread = prvGetThreadState( pvTaskHandle );
+clockid_t xThreadClock;
+
+	/* Each task owns its thread, so the thread's CPU clock is exactly the time
+	 * the task spent running, on whichever core.
+	 */
+	if ( 0 != pthread_getcpuclockid( pxThread->hThread, &xThreadClock ) )
+	{
+		return 0;
+	}
+	return prvClockNanoseconds( xThreadClock );
+}
+/*-----------------------------------------------------------*/
@@ -0,0 +1,247 @@
+/*
+	FreeRTOS.org V5.2.0 - Copyright (C) 2003-2009 Richard Barry.
+
+	This file is part of the FreeRTOS.org distribution.
+
+	FreeRTOS.org is free software; you can redistribute it and/or modify it
+	under the terms of the GNU General Public License (version 2) as published
+	by the Free Software Foundation and modified by the FreeRTOS exception.
+
+	FreeRTOS.org is distributed in the hope that it will be useful,	but WITHOUT
+	ANY WARRANTY; without even the implied warranty of MERCHANTABILITY or
+	FITNESS FOR A PARTICULAR PURPOSE.  See the GNU General Public License for
+	more details.
+
+	You should have received a copy of the GNU General Public License along
+	with FreeRTOS.org; if not, write to the Free Software Foundation, Inc., 59
+	Temple Place, Suite 330, Boston, MA  02111-1307  USA.
+
+	A special exception to the GPL is included to allow you to distribute a
+	combined work that includes FreeRTOS.org without being obliged to provide
+	the source code for any proprietary components.  See the licensing section
+	of http://www.FreeRTOS.org for full details.
+
+
+	***************************************************************************
+	*                                                                         *
+	* Get the FreeRTOS eBook!  See http://www.FreeRTOS.org/Documentation      *
+	*                                                                         *
+	* This is a concise, step by step, 'hands on' guide that describes both   *
+	* general multitasking concepts and FreeRTOS specifics. It presents and   *
+	* explains numerous examples that are written using the FreeRTOS API.     *
+	* Full source code for all the examples is provided in an accompanying    *
+	* .zip file.                                                              *
+	*                                                                         *
+	***************************************************************************
+
+	1 tab == 4 spaces!
+
+	Please ensure to read the configuration and relevant port sections of the
+	online documentation.
+
+	http://www.FreeRTOS.org - Documentation, latest information, license and
+	contact details.
+
+	http://www.SafeRTOS.com - A version that is certified for use in safety
+	critical systems.
+
+	http://www.OpenRTOS.com - Commercial support, development, porting,
+	licensing and training services.
+*/
+
+/*
+ * Multi core variant of the Posix port, configNUM_CORES task threads run at the
+ * same time and share the kernel through a single recursive lock.
+ * FreeRTOS version V9.0.0
+ * */
+
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#include <stdint.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*-----------------------------------------------------------
+ * Port specific definitions.
+ *
+ * The settings in this file configure FreeRTOS correctly for the
+ * given hardware and compiler.
+ *
+ * These settings should not be altered.
+ *-----------------------------------------------------------
+ */
+
+/* Type definitions. Legacy*/
+#define portCHAR		char
+#define portFLOAT		float
+#define portDOUBLE		double
+#define portLONG		int
+#define portSHORT		short
+#define portSTACK_TYPE uint32_t
+#define portBASE_TYPE   long
+
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+#if( configUSE_16_BIT_TICKS == 1 )
+	typedef uint16_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffff
+#else
+	typedef uint32_t TickType_t;
+	#define portMAX_DELAY ( TickType_t ) 0xffffffffUL
+
+	/* 32-bit tick type on a 32-bit architecture, so reads of the tick count do
+	not need to be guarded with a critical section. */
+	#define portTICK_TYPE_IS_ATOMIC 1
+#endif
+/*-----------------------------------------------------------*/
+
+/* Architecture specifics. */
+#define portSTACK_GROWTH				( -1 )
+#define portTICK_PERIOD_MS				( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portTICK_PERIOD_MICROSECONDS		( ( TickType_t ) 1000000 / configTICK_RATE_HZ )
+/* Host objects, such as the port's thread state, are allocated from the
+FreeRTOS heap too, so it has to align blocks as malloc() would. */
+#define portBYTE_ALIGNMENT				16
+#define portREMOVE_STATIC_QUALIFIER
+/*-----------------------------------------------------------*/
+
+/* Cores. A core is whichever task thread is running the task the kernel selected
+for it, portGET_CORE_ID() is the core of the calling thread. Threads that are
+not task threads, e.g. the tick thread, count as core 0. */
+extern UBaseType_t uxPortGetCoreID( void );
+extern void vPortYieldCore( UBaseType_t uxCore );
+extern void vPortIdleWaitForInterrupt( void );
+
+#define portGET_CORE_ID()				uxPortGetCoreID()
+#define portYIELD_CORE( xCoreID )		vPortYieldCore( ( UBaseType_t ) ( xCoreID ) )
+#define portIDLE_WAIT_FOR_INTERRUPT()	vPortIdleWaitForInterrupt()
+/*-----------------------------------------------------------*/
+
+/* Scheduler utilities. */
+extern void vPortYieldFromISR( void );
+extern void vPortYield( void );
+
+#define portYIELD()					vPortYield()
+
+#define portEND_SWITCHING_ISR( xSwitchRequired ) if( xSwitchRequired ) vPortYieldFromISR()
+/*-----------------------------------------------------------*/
+
+
+/* Critical section management. Interrupts are disabled per core, critical
+sections and interrupt masks also take the kernel lock, which
+portGET_TASK_LOCK() takes on its own while the scheduler is suspended. */
+extern void vPortDisableInterrupts( void );
+extern void vPortEnableInterrupts( void );
+#define portSET_INTERRUPT_MASK()	( vPortDisableInterrupts() )
+#define portCLEAR_INTERRUPT_MASK()	( vPortEnableInterrupts() )
+
+extern BaseType_t xPortSetInterruptMask( void );
+extern void vPortClearInterruptMask( BaseType_t xMask );
+
+#define portSET_INTERRUPT_MASK_FROM_ISR()		xPortSetInterruptMask()
+#define portCLEAR_INTERRUPT_MASK_FROM_ISR(x)	vPortClearInterruptMask(x)
+
+
+extern void vPortEnterCritical( void );
+extern void vPortExitCritical( void );
+extern void vPortGetTaskLock( void );
+extern void vPortReleaseTaskLock( void );
+
+#define portDISABLE_INTERRUPTS()	portSET_INTERRUPT_MASK()
+#define portENABLE_INTERRUPTS()		portCLEAR_INTERRUPT_MASK()
+#define portENTER_CRITICAL()		vPortEnterCritical()
+#define portEXIT_CRITICAL()			vPortExitCritical()
+#define portGET_TASK_LOCK()			vPortGetTaskLock()
+#define portRELEASE_TASK_LOCK()		vPortReleaseTaskLock()
+/*-----------------------------------------------------------*/
+
+/* Task function macros as described on the FreeRTOS.org WEB site. */
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters ) void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters ) void vFunction( void *pvParameters )
+
+#define portNOP()
+
+#define portOUTPUT_BYTE( a, b )
+
+/* A deleted task's thread is cancelled and joined once the kernel frees its TCB,
+which it only does after the task has stopped running on any core. */
+extern void vPortCleanUpTCB( void *pxTCB );
+#define portCLEAN_UP_TCB( pxTCB )				vPortCleanUpTCB( pxTCB )
+
+/* Tasks run on their host thread's stack, sized as in the Posix port. */
+#ifndef portUSE_HOST_THREAD_STACKS
+	#define portUSE_HOST_THREAD_STACKS	1
+#endif
+#ifndef portHOST_STACK_SCALE
+	#define portHOST_STACK_SCALE		4
+#endif
+#ifndef portHOST_MINIMAL_STACK_SIZE
+	#define portHOST_MINIMAL_STACK_SIZE	( 256 * 1024 )
+#endif
+
+/* The stacks have a guard page and their high water mark is measured as in the
+Posix port. */
+#if ( portUSE_HOST_THREAD_STACKS == 1 )
+extern unsigned portBASE_TYPE uxPortGetStackHighWaterMark( void *pxTCB );
+#define portGET_STACK_HIGH_WATER_MARK( pxTCB )	uxPortGetStackHighWaterMark( pxTCB )
+extern size_t xPortGetStackBytesUsed( void *pxTask );
+#endif
+
+/* Posix Signal definitions that can be changed or read as appropriate. A core
+is asked to select a new task by sending SIG_YIELD to its thread. */
+#define SIG_YIELD					SIGUSR1
+
+/* The tick thread sleeps until absolute deadlines of TICK_CLOCK and then
+processes the tick itself, like an interrupt taken by a core of its own. */
+#define TICK_CLOCK					CLOCK_MONOTONIC
+
+/* Ticks that can't be taken when they are raised are kept and replayed, these
+count how often that happened. */
+typedef struct xPORT_TICK_STATS
+{
+	unsigned long ulLateTicks;		/* Periods that had already passed when the tick thread woke up. */
+	unsigned long ulDeferredTicks;	/* Ticks that had to wait for another core to release the kernel. */
+	unsigned long ulReplayedTicks;	/* Ticks processed in addition to the first by a tick interrupt. */
+} xPortTickStats;
+
+extern void vPortGetTickStats( xPortTickStats *pxStats );
+extern void vPortPendTicks( unsigned portBASE_TYPE uxTicks );
+
+/* Emulated time can follow the host's clock or run k times faster than it.
+Fast-forwarding needs every core to be idle at once and is not supported, it
+falls back to real-time. Call before vTaskStartScheduler(), the
+FREERTOS_TIME_MODE environment variable ("real" or "scaled:<k>") overrides
+it. */
+typedef enum
+{
+	eRealTime = 0,
+	eScaledTime,
+	eFastForward
+} ePortTimeMode;
+
+extern void vPortSetTimeMode( ePortTimeMode eMode, unsigned long ulScale );
+
+/* Run-time statistics count nanoseconds. The total is the monotonic time since
+the scheduler started and each task is charged the CPU time its own thread
+used. The cores run in parallel, so the percentages of all tasks add up to as
+much as configNUM_CORES times 100. */
+extern void vPortFindTicksPerSecond( void );
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()	vPortFindTicksPerSecond()
+extern unsigned long long ullPortGetTimerValue( void );
+#define portGET_RUN_TIME_COUNTER_VALUE()			ullPortGetTimerValue()
+extern unsigned long long ullPortGetTaskRunTime( void *pvTaskHandle );
+#define portGET_TASK_RUN_TIME_COUNTER_VALUE( pxTCB )	ullPortGetTaskRunTime( pxTCB )
+#define portLU_PRINTF_SPECIFIER_REQUIRED
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* PORTMACRO_H */
@@ -57,7 +57,8 @@
  * compilers own malloc() and free() implementations.
  *
  * This file can only be used if the linker is configured to to generate
- * a heap memory area.
+ * a heap memory area.  It is only compiled in when configUSE_ARENA_HEAP is 0,
+ * otherwise heap_5.c provides the heap.
  *
  * See heap_2.c and heap_1.c for alternative implementations, and the memory
  * management pages of http://www.FreeRTOS.org for more information.
@@ -75,6 +76,8 @@ task.h is included from an application file. */
 
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
+#if( configUSE_ARENA_HEAP == 0 )
+
 /*-----------------------------------------------------------*/
 
 void *pvPortMalloc( size_t xWantedSize )
@@ -113,5 +116,5 @@ void vPortFree( void *pv )
 	}
 }
 
-
+#endif /* configUSE_ARENA_HEAP */
 
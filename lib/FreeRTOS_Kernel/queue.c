@@ -94,6 +94,17 @@ privileged Vs unprivileged linkage and placement. */
 #define queueUNLOCKED					( ( int8_t ) -1 )
 #define queueLOCKED_UNMODIFIED			( ( int8_t ) 0 )
 
+/* Whether a queue is a member of a queue set. */
+#if ( configUSE_QUEUE_SETS == 1 )
+	#define queueIS_SET_MEMBER( pxQueue )	( ( pxQueue )->pxQueueSetContainer != NULL )
+#else
+	#define queueIS_SET_MEMBER( pxQueue )	( pdFALSE )
+#endif
+
+/* Bits of ucZeroCopy. */
+#define queueSLOT_RESERVED				( ( uint8_t ) 0x01 )
+#define queueITEM_ACQUIRED				( ( uint8_t ) 0x02 )
+
 /* When the Queue_t structure is used to represent a base queue its pcHead and
 pcTail members are used as pointers into the queue storage area.  When the
 Queue_t structure is used to represent a mutex pcHead and pcTail pointers are
@@ -148,6 +159,7 @@ typedef struct QueueDefinition
 
 	volatile int8_t cRxLock;		/*< Stores the number of items received from the queue (removed from the queue) while the queue was locked.  Set to queueUNLOCKED when the queue is not locked. */
 	volatile int8_t cTxLock;		/*< Stores the number of items transmitted to the queue (added to the queue) while the queue was locked.  Set to queueUNLOCKED when the queue is not locked. */
+	uint8_t ucZeroCopy;				/*< queueSLOT_RESERVED while a slot handed out by pvQueueReserve() is being filled, queueITEM_ACQUIRED while an item handed out by pvQueueAcquire() is being read. */
 
 	#if( ( configSUPPORT_STATIC_ALLOCATION == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 		uint8_t ucStaticallyAllocated;	/*< Set to pdTRUE if the memory used by the queue was statically allocated to ensure no attempt is made to free the memory. */
@@ -208,19 +220,44 @@ typedef xQUEUE Queue_t;
 static void prvUnlockQueue( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
 
 /*
- * Uses a critical section to determine if there is any data in a queue.
+ * Uses a critical section to determine if there is any data in a queue that
+ * a receiver can take.
  *
- * @return pdTRUE if the queue contains no items, otherwise pdFALSE.
+ * @return pdTRUE if the queue contains no items, or its next item is acquired,
+ * otherwise pdFALSE.
  */
 static BaseType_t prvIsQueueEmpty( const Queue_t *pxQueue ) PRIVILEGED_FUNCTION;
 
 /*
- * Uses a critical section to determine if there is any space in a queue.
+ * Uses a critical section to determine if there is any space in a queue that
+ * a sender can use.
  *
- * @return pdTRUE if there is no space, otherwise pdFALSE;
+ * @return pdTRUE if there is no space, or a slot is reserved, otherwise
+ * pdFALSE;
  */
 static BaseType_t prvIsQueueFull( const Queue_t *pxQueue ) PRIVILEGED_FUNCTION;
 
+/*
+ * Determines whether an item can be sent to a queue at xCopyPosition.  While
+ * a slot is reserved there is no room at all, not even to overwrite, as only
+ * the holder of the reservation may write to the queue.  While an item is
+ * acquired there is no room at the front of the queue, as a send to the front
+ * would write next to, or over, the item still being read.  Called from a
+ * critical section.
+ *
+ * @return pdTRUE if the item can be sent, otherwise pdFALSE.
+ */
+static BaseType_t prvHasRoomFor( const Queue_t *pxQueue, const BaseType_t xCopyPosition ) PRIVILEGED_FUNCTION;
+
+/*
+ * The number of items that can be sent to the back of a queue, and the number
+ * that can be received from it.  A reserved slot leaves no space to other
+ * senders until it is committed, and an acquired item leaves nothing to other
+ * receivers until it is released.  Called from a critical section.
+ */
+static UBaseType_t prvSpacesFree( const Queue_t *pxQueue ) PRIVILEGED_FUNCTION;
+static UBaseType_t prvItemsReady( const Queue_t *pxQueue ) PRIVILEGED_FUNCTION;
+
 /*
  * Copies an item into the queue, either at the front of the queue or the
  * back of the queue.
@@ -232,6 +269,56 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvIte
  */
 static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer ) PRIVILEGED_FUNCTION;
 
+/*
+ * Copies uxItems items to the back of a queue, or out of the front of a
+ * queue, with at most two memcpy() calls each, and updates the number of
+ * items waiting.  The caller has checked there is room, or enough items.
+ */
+static void prvCopyItemsToQueue( Queue_t * const pxQueue, const int8_t *pcItems, const UBaseType_t uxItems ) PRIVILEGED_FUNCTION;
+static void prvCopyItemsFromQueue( Queue_t * const pxQueue, int8_t *pcBuffer, const UBaseType_t uxItems ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock at most one task waiting to receive, or to send, for each of the
+ * uxItems items added to or removed from a queue.  Called from a critical
+ * section with the queue unlocked, or locked if it is a member of a queue set,
+ * as then only the set is posted to.
+ *
+ * @return pdTRUE if a task with a priority above the running task was
+ * unblocked, otherwise pdFALSE.
+ */
+static BaseType_t prvUnblockReceivers( Queue_t * const pxQueue, UBaseType_t uxItems ) PRIVILEGED_FUNCTION;
+static BaseType_t prvUnblockSenders( Queue_t * const pxQueue, UBaseType_t uxItems ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblock at most uxTasks of the tasks waiting on one of a queue's event
+ * lists, without posting to a queue set.  Called from a critical section with
+ * the queue unlocked.
+ *
+ * @return pdTRUE if a task with a priority above the running task was
+ * unblocked, otherwise pdFALSE.
+ */
+static BaseType_t prvUnblockTasks( List_t * const pxEventList, UBaseType_t uxTasks ) PRIVILEGED_FUNCTION;
+
+/*
+ * Adds the number of items sent or received by an ISR while the queue was
+ * locked to one of its lock counts.  Each count unblocks at most one task when
+ * the queue is unlocked, so the count saturates rather than overflow.
+ * xQueueSendMultipleFromISR() does not count the items it sends to a member of
+ * a queue set, as the set needs an entry for each of them.
+ */
+static int8_t prvAddToLockCount( const int8_t cLock, const UBaseType_t uxItems ) PRIVILEGED_FUNCTION;
+
+/*
+ * Counts the slot reserved by pvQueueReserve() as an item and moves the write
+ * position past it.  Called from a critical section.
+ */
+static void prvCommitReservedSlot( Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
+/*
+ * The item that the next receive from a queue takes.
+ */
+static int8_t *prvNextReadPosition( const Queue_t * const pxQueue ) PRIVILEGED_FUNCTION;
+
 #if ( configUSE_QUEUE_SETS == 1 )
 	/*
 	 * Checks to see if a queue is a member of a queue set, and if so, notifies
@@ -290,6 +377,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 		pxQueue->u.pcReadFrom = pxQueue->pcHead + ( ( pxQueue->uxLength - ( UBaseType_t ) 1U ) * pxQueue->uxItemSize );
 		pxQueue->cRxLock = queueUNLOCKED;
 		pxQueue->cTxLock = queueUNLOCKED;
+		pxQueue->ucZeroCopy = 0;
 
 		if( xNewQueue == pdFALSE )
 		{
@@ -722,7 +810,7 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 
 BaseType_t xQueueGenericSend( QueueHandle_t xQueue, const void * const pvItemToQueue, TickType_t xTicksToWait, const BaseType_t xCopyPosition )
 {
-BaseType_t xEntryTimeSet = pdFALSE, xYieldRequired;
+BaseType_t xEntryTimeSet = pdFALSE, xYieldRequired, xHasRoom;
 TimeOut_t xTimeOut;
 Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 
@@ -747,7 +835,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 			highest priority task wanting to access the queue.  If the head item
 			in the queue is to be overwritten then it does not matter if the
 			queue is full. */
-			if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+			if( prvHasRoomFor( pxQueue, xCopyPosition ) != pdFALSE )
 			{
 				traceQUEUE_SEND( pxQueue );
 				xYieldRequired = prvCopyDataToQueue( pxQueue, pvItemToQueue, xCopyPosition );
@@ -876,7 +964,15 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 		/* Update the timeout state to see if it has expired yet. */
 		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
 		{
-			if( prvIsQueueFull( pxQueue ) != pdFALSE )
+			/* A send to the front can be held up by an acquired item rather
+			than by the queue being full, vQueueRelease() unblocks it. */
+			taskENTER_CRITICAL();
+			{
+				xHasRoom = prvHasRoomFor( pxQueue, xCopyPosition );
+			}
+			taskEXIT_CRITICAL();
+
+			if( xHasRoom == pdFALSE )
 			{
 				traceBLOCKING_ON_QUEUE_SEND( pxQueue );
 				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
@@ -951,7 +1047,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 	post). */
 	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
 	{
-		if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+		if( prvHasRoomFor( pxQueue, xCopyPosition ) != pdFALSE )
 		{
 			const int8_t cTxLock = pxQueue->cTxLock;
 
@@ -1260,8 +1356,9 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 			const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
 			/* Is there data in the queue now?  To be running the calling task
-			must be the highest priority task wanting to access the queue. */
-			if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+			must be the highest priority task wanting to access the queue.  An
+			acquired item cannot be received or peeked until it is released. */
+			if( prvItemsReady( pxQueue ) > ( UBaseType_t ) 0 )
 			{
 				/* Remember the read position in case the queue is only being
 				peeked. */
@@ -1461,7 +1558,7 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 		const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
 		/* Cannot block in an ISR, so check there is data available. */
-		if( uxMessagesWaiting > ( UBaseType_t ) 0 )
+		if( prvItemsReady( pxQueue ) > ( UBaseType_t ) 0 )
 		{
 			const int8_t cRxLock = pxQueue->cRxLock;
 
@@ -1522,148 +1619,868 @@ Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,  void * const pvBuffer )
+size_t xQueueSendMultiple( QueueHandle_t xQueue, const void * const pvItems, size_t xItemCount, TickType_t xTicksToWait )
 {
-BaseType_t xReturn;
-UBaseType_t uxSavedInterruptStatus;
-int8_t *pcOriginalReadPosition;
+BaseType_t xEntryTimeSet = pdFALSE;
+TimeOut_t xTimeOut;
+size_t xItemsSent = 0;
+UBaseType_t uxItems;
 Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 
 	configASSERT( pxQueue );
-	configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
-	configASSERT( pxQueue->uxItemSize != 0 ); /* Can't peek a semaphore. */
-
-	/* RTOS ports that support interrupt nesting have the concept of a maximum
-	system call (or maximum API call) interrupt priority.  Interrupts that are
-	above the maximum system call priority are kept permanently enabled, even
-	when the RTOS kernel is in a critical section, but cannot make any calls to
-	FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
-	then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-	failure if a FreeRTOS API function is called from an interrupt that has been
-	assigned a priority above the configured maximum system call priority.
-	Only FreeRTOS functions that end in FromISR can be called from interrupts
-	that have been assigned a priority at or (logically) below the maximum
-	system call	interrupt priority.  FreeRTOS maintains a separate interrupt
-	safe API to ensure interrupt entry is as fast and as simple as possible.
-	More information (albeit Cortex-M specific) is provided on the following
-	link: http://www.freertos.org/RTOS-Cortex-M3-M4.html */
-	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+	configASSERT( !( ( pvItems == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+	configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
 
-	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	/* Like xQueueGenericSend(), except that each pass copies as many of the
+	remaining items as there is room for, in a single critical section, and
+	the task only blocks while the queue is full. */
+	for( ;; )
 	{
-		/* Cannot block in an ISR, so check there is data available. */
-		if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+		taskENTER_CRITICAL();
 		{
-			traceQUEUE_PEEK_FROM_ISR( pxQueue );
+			uxItems = prvSpacesFree( pxQueue );
+			if( ( size_t ) uxItems > ( xItemCount - xItemsSent ) )
+			{
+				uxItems = ( UBaseType_t ) ( xItemCount - xItemsSent );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 
-			/* Remember the read position so it can be reset as nothing is
-			actually being removed from the queue. */
-			pcOriginalReadPosition = pxQueue->u.pcReadFrom;
-			prvCopyDataFromQueue( pxQueue, pvBuffer );
-			pxQueue->u.pcReadFrom = pcOriginalReadPosition;
+			if( uxItems > ( UBaseType_t ) 0 )
+			{
+				traceQUEUE_SEND( pxQueue );
+				prvCopyItemsToQueue( pxQueue, ( ( const int8_t * ) pvItems ) + ( xItemsSent * pxQueue->uxItemSize ), uxItems );
+				xItemsSent += uxItems;
 
-			xReturn = pdPASS;
-		}
-		else
-		{
-			xReturn = pdFAIL;
-			traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue );
+				if( prvUnblockReceivers( pxQueue, uxItems ) != pdFALSE )
+				{
+					/* The yield is held off until the critical section is
+					exited. */
+					queueYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( xItemsSent == xItemCount )
+			{
+				taskEXIT_CRITICAL();
+				return xItemsSent;
+			}
+			else if( xTicksToWait == ( TickType_t ) 0 )
+			{
+				/* The queue is full and no block time is specified (or the
+				block time has expired) so leave now. */
+				taskEXIT_CRITICAL();
+				traceQUEUE_SEND_FAILED( pxQueue );
+				return xItemsSent;
+			}
+			else if( xEntryTimeSet == pdFALSE )
+			{
+				vTaskSetTimeOutState( &xTimeOut );
+				xEntryTimeSet = pdTRUE;
+			}
+			else
+			{
+				/* Entry time was already set. */
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
-	}
-	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		taskEXIT_CRITICAL();
 
-	return xReturn;
-}
-/*-----------------------------------------------------------*/
+		vTaskSuspendAll();
+		prvLockQueue( pxQueue );
 
-UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
-{
-UBaseType_t uxReturn;
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			if( prvIsQueueFull( pxQueue ) != pdFALSE )
+			{
+				traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+				prvUnlockQueue( pxQueue );
 
-	configASSERT( xQueue );
+				if( xTaskResumeAll() == pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+			}
+			else
+			{
+				/* Try again. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+			}
+		}
+		else
+		{
+			/* The timeout has expired. */
+			prvUnlockQueue( pxQueue );
+			( void ) xTaskResumeAll();
 
-	taskENTER_CRITICAL();
-	{
-		uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
+			traceQUEUE_SEND_FAILED( pxQueue );
+			return xItemsSent;
+		}
 	}
-	taskEXIT_CRITICAL();
-
-	return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+}
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
+size_t xQueueSendMultipleFromISR( QueueHandle_t xQueue, const void * const pvItems, size_t xItemCount, BaseType_t * const pxHigherPriorityTaskWoken )
 {
-UBaseType_t uxReturn;
-Queue_t *pxQueue;
+UBaseType_t uxSavedInterruptStatus;
+UBaseType_t uxItems;
+Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 
-	pxQueue = ( Queue_t * ) xQueue;
 	configASSERT( pxQueue );
+	configASSERT( !( ( pvItems == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+	configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
 
-	taskENTER_CRITICAL();
-	{
-		uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
-	}
-	taskEXIT_CRITICAL();
+	/* See the comment in xQueueGenericSendFromISR(). */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-	return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
-/*-----------------------------------------------------------*/
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		uxItems = prvSpacesFree( pxQueue );
+		if( ( size_t ) uxItems > xItemCount )
+		{
+			uxItems = ( UBaseType_t ) xItemCount;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
 
-UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
-{
-UBaseType_t uxReturn;
+		if( uxItems > ( UBaseType_t ) 0 )
+		{
+			const int8_t cTxLock = pxQueue->cTxLock;
 
-	configASSERT( xQueue );
+			traceQUEUE_SEND_FROM_ISR( pxQueue );
+			prvCopyItemsToQueue( pxQueue, ( const int8_t * ) pvItems, uxItems );
 
-	uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
+			/* The event list is not altered if the queue is locked.  This will
+			be done when the queue is unlocked later.  A queue set needs an
+			entry for every item, which a batch can have more of than the lock
+			count holds, so a member of a set posts them to the set straight
+			away.  That only uses the set's own event lists and lock. */
+			if( ( cTxLock == queueUNLOCKED ) || ( queueIS_SET_MEMBER( pxQueue ) != pdFALSE ) )
+			{
+				if( ( prvUnblockReceivers( pxQueue, uxItems ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+				{
+					*pxHigherPriorityTaskWoken = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				pxQueue->cTxLock = prvAddToLockCount( cTxLock, uxItems );
+			}
+		}
+		else
+		{
+			traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
 
-	return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+	return ( size_t ) uxItems;
+}
 /*-----------------------------------------------------------*/
 
-void vQueueDelete( QueueHandle_t xQueue )
+size_t xQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, size_t xMaxItems, TickType_t xTicksToWait )
 {
+BaseType_t xEntryTimeSet = pdFALSE;
+TimeOut_t xTimeOut;
+UBaseType_t uxItems;
 Queue_t * const pxQueue = ( Queue_t * ) xQueue;
 
 	configASSERT( pxQueue );
-	traceQUEUE_DELETE( pxQueue );
-
-	#if ( configQUEUE_REGISTRY_SIZE > 0 )
+	configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+	configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
 	{
-		vQueueUnregisterQueue( pxQueue );
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
 	}
 	#endif
 
-	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
-	{
-		/* The queue can only have been allocated dynamically - free it
-		again. */
-		vPortFree( pxQueue );
-	}
-	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+	/* Like xQueueGenericReceive(), except that it takes every item waiting,
+	up to xMaxItems, in a single critical section and returns as soon as there
+	is at least one. */
+	for( ;; )
 	{
-		/* The queue could have been allocated statically or dynamically, so
-		check before attempting to free the memory. */
-		if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
-		{
-			vPortFree( pxQueue );
-		}
-		else
+		taskENTER_CRITICAL();
 		{
-			mtCOVERAGE_TEST_MARKER();
-		}
-	}
-	#else
-	{
-		/* The queue must have been statically allocated, so is not going to be
-		deleted.  Avoid compiler warnings about the unused parameter. */
-		( void ) pxQueue;
-	}
-	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
-}
-/*-----------------------------------------------------------*/
-
+			uxItems = prvItemsReady( pxQueue );
+			if( ( size_t ) uxItems > xMaxItems )
+			{
+				uxItems = ( UBaseType_t ) xMaxItems;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( uxItems > ( UBaseType_t ) 0 )
+			{
+				traceQUEUE_RECEIVE( pxQueue );
+				prvCopyItemsFromQueue( pxQueue, ( int8_t * ) pvBuffer, uxItems );
+
+				if( prvUnblockSenders( pxQueue, uxItems ) != pdFALSE )
+				{
+					queueYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				taskEXIT_CRITICAL();
+				return ( size_t ) uxItems;
+			}
+			else if( ( xTicksToWait == ( TickType_t ) 0 ) || ( xMaxItems == ( size_t ) 0 ) )
+			{
+				/* The queue was empty and no block time is specified (or
+				the block time has expired) so leave now. */
+				taskEXIT_CRITICAL();
+				traceQUEUE_RECEIVE_FAILED( pxQueue );
+				return 0;
+			}
+			else if( xEntryTimeSet == pdFALSE )
+			{
+				vTaskSetTimeOutState( &xTimeOut );
+				xEntryTimeSet = pdTRUE;
+			}
+			else
+			{
+				/* Entry time was already set. */
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		vTaskSuspendAll();
+		prvLockQueue( pxQueue );
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+			{
+				traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+				prvUnlockQueue( pxQueue );
+
+				if( xTaskResumeAll() == pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* Try again. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+			}
+		}
+		else
+		{
+			prvUnlockQueue( pxQueue );
+			( void ) xTaskResumeAll();
+
+			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+			{
+				traceQUEUE_RECEIVE_FAILED( pxQueue );
+				return 0;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue, void * const pvBuffer, size_t xMaxItems, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+UBaseType_t uxSavedInterruptStatus;
+UBaseType_t uxItems;
+Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+	configASSERT( pxQueue->uxQueueType != queueQUEUE_IS_MUTEX );
+
+	/* See the comment in xQueueReceiveFromISR(). */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		uxItems = prvItemsReady( pxQueue );
+		if( ( size_t ) uxItems > xMaxItems )
+		{
+			uxItems = ( UBaseType_t ) xMaxItems;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( uxItems > ( UBaseType_t ) 0 )
+		{
+			const int8_t cRxLock = pxQueue->cRxLock;
+
+			traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+			prvCopyItemsFromQueue( pxQueue, ( int8_t * ) pvBuffer, uxItems );
+
+			/* If the queue is locked the event list will not be modified.
+			Instead update the lock count so the task that unlocks the queue
+			will know that an ISR has removed data while the queue was
+			locked. */
+			if( cRxLock == queueUNLOCKED )
+			{
+				if( ( prvUnblockSenders( pxQueue, uxItems ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+				{
+					*pxHigherPriorityTaskWoken = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				pxQueue->cRxLock = prvAddToLockCount( cRxLock, uxItems );
+			}
+		}
+		else
+		{
+			traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return ( size_t ) uxItems;
+}
+/*-----------------------------------------------------------*/
+
+void *pvQueueReserve( QueueHandle_t xQueue, TickType_t xTicksToWait )
+{
+BaseType_t xEntryTimeSet = pdFALSE;
+TimeOut_t xTimeOut;
+void *pvSlot;
+Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	/* Waits for space exactly as xQueueGenericSend() does, but hands out the
+	slot at pcWriteTo instead of copying into it.  The slot is not counted as
+	an item until vQueueCommit(), so receivers cannot see it, and only the
+	holder of the reservation writes to the queue until then. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			if( prvSpacesFree( pxQueue ) > ( UBaseType_t ) 0 )
+			{
+				pxQueue->ucZeroCopy |= queueSLOT_RESERVED;
+				pvSlot = ( void * ) pxQueue->pcWriteTo;
+
+				taskEXIT_CRITICAL();
+				return pvSlot;
+			}
+			else
+			{
+				if( xTicksToWait == ( TickType_t ) 0 )
+				{
+					taskEXIT_CRITICAL();
+					traceQUEUE_SEND_FAILED( pxQueue );
+					return NULL;
+				}
+				else if( xEntryTimeSet == pdFALSE )
+				{
+					vTaskSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+				}
+				else
+				{
+					/* Entry time was already set. */
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		vTaskSuspendAll();
+		prvLockQueue( pxQueue );
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			if( prvIsQueueFull( pxQueue ) != pdFALSE )
+			{
+				traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+				prvUnlockQueue( pxQueue );
+
+				if( xTaskResumeAll() == pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+			}
+			else
+			{
+				/* Try again. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+			}
+		}
+		else
+		{
+			/* The timeout has expired. */
+			prvUnlockQueue( pxQueue );
+			( void ) xTaskResumeAll();
+
+			traceQUEUE_SEND_FAILED( pxQueue );
+			return NULL;
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vQueueCommit( QueueHandle_t xQueue )
+{
+BaseType_t xYieldRequired;
+Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+	configASSERT( pxQueue );
+
+	taskENTER_CRITICAL();
+	{
+		traceQUEUE_SEND( pxQueue );
+		prvCommitReservedSlot( pxQueue );
+
+		/* If there was a task waiting for data to arrive on the queue then
+		unblock it now, as xQueueGenericSend() does.  Tasks waiting to send
+		found no room while the slot was reserved, so there can be one for
+		every free slot. */
+		xYieldRequired = prvUnblockReceivers( pxQueue, 1 );
+		if( prvUnblockSenders( pxQueue, prvSpacesFree( pxQueue ) ) != pdFALSE )
+		{
+			xYieldRequired = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xYieldRequired != pdFALSE )
+		{
+			queueYIELD_IF_USING_PREEMPTION();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void *pvQueueReserveFromISR( QueueHandle_t xQueue )
+{
+UBaseType_t uxSavedInterruptStatus;
+void *pvSlot = NULL;
+Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+
+	/* See the comment in xQueueGenericSendFromISR(). */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		if( prvSpacesFree( pxQueue ) > ( UBaseType_t ) 0 )
+		{
+			pxQueue->ucZeroCopy |= queueSLOT_RESERVED;
+			pvSlot = ( void * ) pxQueue->pcWriteTo;
+		}
+		else
+		{
+			traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return pvSlot;
+}
+/*-----------------------------------------------------------*/
+
+void vQueueCommitFromISR( QueueHandle_t xQueue, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+UBaseType_t uxSavedInterruptStatus;
+Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+	configASSERT( pxQueue );
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		const int8_t cTxLock = pxQueue->cTxLock;
+		const int8_t cRxLock = pxQueue->cRxLock;
+
+		traceQUEUE_SEND_FROM_ISR( pxQueue );
+		prvCommitReservedSlot( pxQueue );
+
+		/* The event list is not altered if the queue is locked.  This will
+		be done when the queue is unlocked later. */
+		if( cTxLock == queueUNLOCKED )
+		{
+			if( ( prvUnblockReceivers( pxQueue, 1 ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+			{
+				*pxHigherPriorityTaskWoken = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			pxQueue->cTxLock = prvAddToLockCount( cTxLock, 1 );
+		}
+
+		/* Tasks waiting to send found no room while the slot was reserved, as
+		in vQueueCommit(). */
+		if( cRxLock == queueUNLOCKED )
+		{
+			if( ( prvUnblockSenders( pxQueue, prvSpacesFree( pxQueue ) ) != pdFALSE ) && ( pxHigherPriorityTaskWoken != NULL ) )
+			{
+				*pxHigherPriorityTaskWoken = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			pxQueue->cRxLock = prvAddToLockCount( cRxLock, prvSpacesFree( pxQueue ) );
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+}
+/*-----------------------------------------------------------*/
+
+void *pvQueueAcquire( QueueHandle_t xQueue, TickType_t xTicksToWait )
+{
+BaseType_t xEntryTimeSet = pdFALSE;
+TimeOut_t xTimeOut;
+void *pvItem;
+Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	/* Waits for an item exactly as xQueueGenericReceive() does, but hands out
+	the item in place instead of copying it out.  It stays counted, so senders
+	cannot overwrite it, until vQueueRelease(). */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			if( prvItemsReady( pxQueue ) > ( UBaseType_t ) 0 )
+			{
+				pxQueue->ucZeroCopy |= queueITEM_ACQUIRED;
+				pvItem = ( void * ) prvNextReadPosition( pxQueue );
+
+				taskEXIT_CRITICAL();
+				return pvItem;
+			}
+			else
+			{
+				if( xTicksToWait == ( TickType_t ) 0 )
+				{
+					taskEXIT_CRITICAL();
+					traceQUEUE_RECEIVE_FAILED( pxQueue );
+					return NULL;
+				}
+				else if( xEntryTimeSet == pdFALSE )
+				{
+					vTaskSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+				}
+				else
+				{
+					/* Entry time was already set. */
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		vTaskSuspendAll();
+		prvLockQueue( pxQueue );
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+			{
+				traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+				prvUnlockQueue( pxQueue );
+
+				if( xTaskResumeAll() == pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* Try again. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+			}
+		}
+		else
+		{
+			prvUnlockQueue( pxQueue );
+			( void ) xTaskResumeAll();
+
+			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+			{
+				traceQUEUE_RECEIVE_FAILED( pxQueue );
+				return NULL;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vQueueRelease( QueueHandle_t xQueue )
+{
+BaseType_t xYieldRequired;
+Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+	configASSERT( pxQueue );
+
+	taskENTER_CRITICAL();
+	{
+		configASSERT( ( pxQueue->ucZeroCopy & queueITEM_ACQUIRED ) != 0 );
+		pxQueue->ucZeroCopy &= ( uint8_t ) ~queueITEM_ACQUIRED;
+
+		traceQUEUE_RECEIVE( pxQueue );
+		pxQueue->u.pcReadFrom = prvNextReadPosition( pxQueue );
+		pxQueue->uxMessagesWaiting--;
+
+		/* There is now space, unblock tasks waiting to send as
+		xQueueGenericReceive() does.  Sends to the front may have been held up
+		by the acquired item while the queue had space, so there can be a
+		waiting task for every free slot.  Likewise tasks waiting to receive
+		found the queue empty while the item was acquired, so there can be one
+		for every item left.  Those items are already in the queue set, if
+		the queue is in one. */
+		xYieldRequired = prvUnblockSenders( pxQueue, prvSpacesFree( pxQueue ) );
+		if( prvUnblockTasks( &( pxQueue->xTasksWaitingToReceive ), prvItemsReady( pxQueue ) ) != pdFALSE )
+		{
+			xYieldRequired = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( xYieldRequired != pdFALSE )
+		{
+			queueYIELD_IF_USING_PREEMPTION();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,  void * const pvBuffer )
+{
+BaseType_t xReturn;
+UBaseType_t uxSavedInterruptStatus;
+int8_t *pcOriginalReadPosition;
+Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+	configASSERT( pxQueue->uxItemSize != 0 ); /* Can't peek a semaphore. */
+
+	/* RTOS ports that support interrupt nesting have the concept of a maximum
+	system call (or maximum API call) interrupt priority.  Interrupts that are
+	above the maximum system call priority are kept permanently enabled, even
+	when the RTOS kernel is in a critical section, but cannot make any calls to
+	FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
+	then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+	failure if a FreeRTOS API function is called from an interrupt that has been
+	assigned a priority above the configured maximum system call priority.
+	Only FreeRTOS functions that end in FromISR can be called from interrupts
+	that have been assigned a priority at or (logically) below the maximum
+	system call	interrupt priority.  FreeRTOS maintains a separate interrupt
+	safe API to ensure interrupt entry is as fast and as simple as possible.
+	More information (albeit Cortex-M specific) is provided on the following
+	link: http://www.freertos.org/RTOS-Cortex-M3-M4.html */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	{
+		/* Cannot block in an ISR, so check there is data available. */
+		if( prvItemsReady( pxQueue ) > ( UBaseType_t ) 0 )
+		{
+			traceQUEUE_PEEK_FROM_ISR( pxQueue );
+
+			/* Remember the read position so it can be reset as nothing is
+			actually being removed from the queue. */
+			pcOriginalReadPosition = pxQueue->u.pcReadFrom;
+			prvCopyDataFromQueue( pxQueue, pvBuffer );
+			pxQueue->u.pcReadFrom = pcOriginalReadPosition;
+
+			xReturn = pdPASS;
+		}
+		else
+		{
+			xReturn = pdFAIL;
+			traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue );
+		}
+	}
+	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
+{
+UBaseType_t uxReturn;
+
+	configASSERT( xQueue );
+
+	taskENTER_CRITICAL();
+	{
+		uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
+	}
+	taskEXIT_CRITICAL();
+
+	return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
+{
+UBaseType_t uxReturn;
+Queue_t *pxQueue;
+
+	pxQueue = ( Queue_t * ) xQueue;
+	configASSERT( pxQueue );
+
+	taskENTER_CRITICAL();
+	{
+		uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+	}
+	taskEXIT_CRITICAL();
+
+	return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaitingFromISR( const QueueHandle_t xQueue )
+{
+UBaseType_t uxReturn;
+
+	configASSERT( xQueue );
+
+	uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
+
+	return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+void vQueueDelete( QueueHandle_t xQueue )
+{
+Queue_t * const pxQueue = ( Queue_t * ) xQueue;
+
+	configASSERT( pxQueue );
+	traceQUEUE_DELETE( pxQueue );
+
+	#if ( configQUEUE_REGISTRY_SIZE > 0 )
+	{
+		vQueueUnregisterQueue( pxQueue );
+	}
+	#endif
+
+	#if( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 0 ) )
+	{
+		/* The queue can only have been allocated dynamically - free it
+		again. */
+		vPortFree( pxQueue );
+	}
+	#elif( ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) && ( configSUPPORT_STATIC_ALLOCATION == 1 ) )
+	{
+		/* The queue could have been allocated statically or dynamically, so
+		check before attempting to free the memory. */
+		if( pxQueue->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+		{
+			vPortFree( pxQueue );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#else
+	{
+		/* The queue must have been statically allocated, so is not going to be
+		deleted.  Avoid compiler warnings about the unused parameter. */
+		( void ) pxQueue;
+	}
+	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
 #if ( configUSE_TRACE_FACILITY == 1 )
 
 	UBaseType_t uxQueueGetQueueNumber( QueueHandle_t xQueue )
@@ -1701,6 +2518,11 @@ UBaseType_t uxMessagesWaiting;
 
 	/* This function is called from a critical section. */
 
+	/* Nothing else may write to a queue while a slot is reserved, and nothing
+	may be written at the front while an item is acquired. */
+	configASSERT( ( pxQueue->ucZeroCopy & queueSLOT_RESERVED ) == 0 );
+	configASSERT( ( xPosition == queueSEND_TO_BACK ) || ( ( pxQueue->ucZeroCopy & queueITEM_ACQUIRED ) == 0 ) );
+
 	uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
 	if( pxQueue->uxItemSize == ( UBaseType_t ) 0 )
@@ -1775,6 +2597,9 @@ UBaseType_t uxMessagesWaiting;
 
 static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer )
 {
+	/* Nothing else may read from a queue while an item is acquired. */
+	configASSERT( ( pxQueue->ucZeroCopy & queueITEM_ACQUIRED ) == 0 );
+
 	if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
 	{
 		pxQueue->u.pcReadFrom += pxQueue->uxItemSize;
@@ -1791,6 +2616,209 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer
 }
 /*-----------------------------------------------------------*/
 
+static void prvCopyItemsToQueue( Queue_t * const pxQueue, const int8_t *pcItems, const UBaseType_t uxItems )
+{
+	/* This function is called from a critical section. */
+	configASSERT( ( pxQueue->ucZeroCopy & queueSLOT_RESERVED ) == 0 );
+
+	if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
+	{
+	const size_t xBytes = ( size_t ) uxItems * ( size_t ) pxQueue->uxItemSize;
+	const size_t xBytesToEnd = ( size_t ) ( pxQueue->pcTail - pxQueue->pcWriteTo ); /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+
+		if( xBytes < xBytesToEnd )
+		{
+			( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) pcItems, xBytes );
+			pxQueue->pcWriteTo += xBytes;
+		}
+		else
+		{
+			/* The items wrap around the end of the storage area. */
+			( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) pcItems, xBytesToEnd );
+			( void ) memcpy( ( void * ) pxQueue->pcHead, ( const void * ) ( pcItems + xBytesToEnd ), xBytes - xBytesToEnd );
+			pxQueue->pcWriteTo = pxQueue->pcHead + ( xBytes - xBytesToEnd );
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxQueue->uxMessagesWaiting += uxItems;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyItemsFromQueue( Queue_t * const pxQueue, int8_t *pcBuffer, const UBaseType_t uxItems )
+{
+	/* This function is called from a critical section. */
+	configASSERT( ( pxQueue->ucZeroCopy & queueITEM_ACQUIRED ) == 0 );
+
+	if( pxQueue->uxItemSize != ( UBaseType_t ) 0 )
+	{
+	const size_t xBytes = ( size_t ) uxItems * ( size_t ) pxQueue->uxItemSize;
+	const size_t xStorageSize = ( size_t ) ( pxQueue->pcTail - pxQueue->pcHead ); /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+	size_t xFirst, xBytesToEnd;
+
+		/* pcReadFrom points to the last item that was read, the first item to
+		read now is the one after it. */
+		xFirst = ( size_t ) ( pxQueue->u.pcReadFrom - pxQueue->pcHead ) + ( size_t ) pxQueue->uxItemSize; /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+		if( xFirst >= xStorageSize )
+		{
+			xFirst = 0;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		xBytesToEnd = xStorageSize - xFirst;
+		if( xBytes <= xBytesToEnd )
+		{
+			( void ) memcpy( ( void * ) pcBuffer, ( const void * ) ( pxQueue->pcHead + xFirst ), xBytes );
+		}
+		else
+		{
+			/* The items wrap around the end of the storage area. */
+			( void ) memcpy( ( void * ) pcBuffer, ( const void * ) ( pxQueue->pcHead + xFirst ), xBytesToEnd );
+			( void ) memcpy( ( void * ) ( pcBuffer + xBytesToEnd ), ( const void * ) pxQueue->pcHead, xBytes - xBytesToEnd );
+		}
+
+		/* Leave pcReadFrom pointing to the last item read. */
+		xFirst += xBytes - ( size_t ) pxQueue->uxItemSize;
+		if( xFirst >= xStorageSize )
+		{
+			xFirst -= xStorageSize;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+		pxQueue->u.pcReadFrom = pxQueue->pcHead + xFirst;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxQueue->uxMessagesWaiting -= uxItems;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockReceivers( Queue_t * const pxQueue, UBaseType_t uxItems )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	#if ( configUSE_QUEUE_SETS == 1 )
+	{
+		if( pxQueue->pxQueueSetContainer != NULL )
+		{
+			/* The queue set holds one entry per item. */
+			while( uxItems > ( UBaseType_t ) 0 )
+			{
+				if( prvNotifyQueueSetContainer( pxQueue, queueSEND_TO_BACK ) != pdFALSE )
+				{
+					xHigherPriorityTaskWoken = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+				uxItems--;
+			}
+
+			return xHigherPriorityTaskWoken;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_QUEUE_SETS */
+
+	return prvUnblockTasks( &( pxQueue->xTasksWaitingToReceive ), uxItems );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockSenders( Queue_t * const pxQueue, UBaseType_t uxItems )
+{
+	return prvUnblockTasks( &( pxQueue->xTasksWaitingToSend ), uxItems );
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockTasks( List_t * const pxEventList, UBaseType_t uxTasks )
+{
+BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	while( ( uxTasks > ( UBaseType_t ) 0 ) && ( listLIST_IS_EMPTY( pxEventList ) == pdFALSE ) )
+	{
+		if( xTaskRemoveFromEventList( pxEventList ) != pdFALSE )
+		{
+			xHigherPriorityTaskWoken = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+		uxTasks--;
+	}
+
+	return xHigherPriorityTaskWoken;
+}
+/*-----------------------------------------------------------*/
+
+static int8_t prvAddToLockCount( const int8_t cLock, const UBaseType_t uxItems )
+{
+const UBaseType_t uxMaxLock = ( UBaseType_t ) 127;
+
+	if( uxItems >= ( uxMaxLock - ( UBaseType_t ) cLock ) )
+	{
+		return ( int8_t ) uxMaxLock;
+	}
+	else
+	{
+		return ( int8_t ) ( cLock + ( int8_t ) uxItems );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvCommitReservedSlot( Queue_t * const pxQueue )
+{
+	/* This function is called from a critical section. */
+
+	configASSERT( ( pxQueue->ucZeroCopy & queueSLOT_RESERVED ) != 0 );
+	pxQueue->ucZeroCopy &= ( uint8_t ) ~queueSLOT_RESERVED;
+
+	pxQueue->pcWriteTo += pxQueue->uxItemSize;
+	if( pxQueue->pcWriteTo >= pxQueue->pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+	{
+		pxQueue->pcWriteTo = pxQueue->pcHead;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxQueue->uxMessagesWaiting++;
+}
+/*-----------------------------------------------------------*/
+
+static int8_t *prvNextReadPosition( const Queue_t * const pxQueue )
+{
+int8_t *pcNext = pxQueue->u.pcReadFrom + pxQueue->uxItemSize;
+
+	if( pcNext >= pxQueue->pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
+	{
+		pcNext = pxQueue->pcHead;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pcNext;
+}
+/*-----------------------------------------------------------*/
+
 static void prvUnlockQueue( Queue_t * const pxQueue )
 {
 	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
@@ -1917,7 +2945,7 @@ BaseType_t xReturn;
 
 	taskENTER_CRITICAL();
 	{
-		if( pxQueue->uxMessagesWaiting == ( UBaseType_t )  0 )
+		if( prvItemsReady( pxQueue ) == ( UBaseType_t )  0 )
 		{
 			xReturn = pdTRUE;
 		}
@@ -1950,13 +2978,72 @@ BaseType_t xReturn;
 } /*lint !e818 xQueue could not be pointer to const because it is a typedef. */
 /*-----------------------------------------------------------*/
 
+static BaseType_t prvHasRoomFor( const Queue_t *pxQueue, const BaseType_t xCopyPosition )
+{
+BaseType_t xReturn;
+
+	if( ( pxQueue->ucZeroCopy & queueSLOT_RESERVED ) != 0 )
+	{
+		xReturn = pdFALSE;
+	}
+	else if( ( xCopyPosition != queueSEND_TO_BACK ) && ( ( pxQueue->ucZeroCopy & queueITEM_ACQUIRED ) != 0 ) )
+	{
+		xReturn = pdFALSE;
+	}
+	else if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
+	{
+		xReturn = pdTRUE;
+	}
+	else
+	{
+		xReturn = pdFALSE;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvSpacesFree( const Queue_t *pxQueue )
+{
+UBaseType_t uxReturn;
+
+	if( ( pxQueue->ucZeroCopy & queueSLOT_RESERVED ) != 0 )
+	{
+		uxReturn = ( UBaseType_t ) 0;
+	}
+	else
+	{
+		uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+	}
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
+static UBaseType_t prvItemsReady( const Queue_t *pxQueue )
+{
+UBaseType_t uxReturn;
+
+	if( ( pxQueue->ucZeroCopy & queueITEM_ACQUIRED ) != 0 )
+	{
+		uxReturn = ( UBaseType_t ) 0;
+	}
+	else
+	{
+		uxReturn = pxQueue->uxMessagesWaiting;
+	}
+
+	return uxReturn;
+}
+/*-----------------------------------------------------------*/
+
 static BaseType_t prvIsQueueFull( const Queue_t *pxQueue )
 {
 BaseType_t xReturn;
 
 	taskENTER_CRITICAL();
 	{
-		if( pxQueue->uxMessagesWaiting == pxQueue->uxLength )
+		if( prvSpacesFree( pxQueue ) == ( UBaseType_t ) 0 )
 		{
 			xReturn = pdTRUE;
 		}
@@ -234,21 +234,84 @@ a statically allocated stack and a dynamically allocated TCB. */
 
 /*-----------------------------------------------------------*/
 
-/* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
-count overflows. */
-#define taskSWITCH_DELAYED_LISTS()																	\
-{																									\
-	List_t *pxTemp;																					\
+#if ( configNUM_CORES > 1 )
+
+	/* xTaskRunState holds the core a task is running on, or
+	taskTASK_NOT_RUNNING. */
+	#define taskTASK_NOT_RUNNING			( ( BaseType_t ) -1 )
+	#define taskTASK_IS_RUNNING( pxTCB )	( ( pxTCB )->xTaskRunState != taskTASK_NOT_RUNNING )
+
+	/* A task that has just been made ready may preempt the task running on
+	any core it is allowed on.  The core with the lowest priority task is asked
+	to yield, the macro evaluates to pdTRUE if that is the calling core. */
+	#define taskYIELD_REQUIRED_FOR( pxTCB, xYieldEqualPriority ) prvYieldForTask( ( pxTCB ), ( xYieldEqualPriority ) )
+
+#else
+
+	#define taskTASK_IS_RUNNING( pxTCB )	( ( pxTCB ) == pxCurrentTCB )
+
+	/* A task that has just been made ready preempts the running task if its
+	priority is higher, or, where xYieldEqualPriority is set, the same. */
+	#define taskYIELD_REQUIRED_FOR( pxTCB, xYieldEqualPriority )			\
+	( ( ( xYieldEqualPriority ) != pdFALSE ) ?								\
+		( ( pxTCB )->uxPriority >= pxCurrentTCB->uxPriority ) :			\
+		( ( pxTCB )->uxPriority > pxCurrentTCB->uxPriority ) )
+
+#endif /* configNUM_CORES */
+
+/*-----------------------------------------------------------*/
+
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+	/* The tasks in pxOverflowDelayedTaskList are moved into the timing wheel
+	when the tick count overflows. */
+	#define taskSWITCH_DELAYED_LISTS()																\
+	{																								\
+		ListItem_t *pxItem;																			\
+		TickType_t xDueTime;																		\
 																									\
-	/* The delayed tasks list should be empty when the lists are switched. */						\
-	configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );										\
+		/* The timing wheel should be empty when the tick count overflows. */						\
+		configASSERT( ( pxWheelGetNextSlot( &xDelayedTaskWheel, &xDueTime ) == NULL ) );			\
+		( void ) xDueTime;																			\
 																									\
-	pxTemp = pxDelayedTaskList;																		\
-	pxDelayedTaskList = pxOverflowDelayedTaskList;													\
-	pxOverflowDelayedTaskList = pxTemp;																\
-	xNumOfOverflows++;																				\
-	prvResetNextTaskUnblockTime();																	\
-}
+		listWHEEL_SET_TIME( &xDelayedTaskWheel, ( TickType_t ) 0U );								\
+		while( listLIST_IS_EMPTY( pxOverflowDelayedTaskList ) == pdFALSE )							\
+		{																							\
+			pxItem = listGET_HEAD_ENTRY( pxOverflowDelayedTaskList );								\
+			( void ) uxListRemove( pxItem );														\
+			vWheelInsert( &xDelayedTaskWheel, pxItem );												\
+		}																							\
+		xNumOfOverflows++;																			\
+		prvResetNextTaskUnblockTime();																\
+	}
+
+	/* Tasks are only moved out of the overflow list when the tick count
+	overflows, so the order in which they are held does not matter. */
+	#define taskINSERT_IN_DELAYED_LIST( pxListItem )			vWheelInsert( &xDelayedTaskWheel, ( pxListItem ) )
+	#define taskINSERT_IN_OVERFLOW_DELAYED_LIST( pxListItem )	vListInsertEnd( pxOverflowDelayedTaskList, ( pxListItem ) )
+
+#else
+
+	/* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the
+	tick count overflows. */
+	#define taskSWITCH_DELAYED_LISTS()																\
+	{																								\
+		List_t *pxTemp;																				\
+																									\
+		/* The delayed tasks list should be empty when the lists are switched. */					\
+		configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );									\
+																									\
+		pxTemp = pxDelayedTaskList;																	\
+		pxDelayedTaskList = pxOverflowDelayedTaskList;												\
+		pxOverflowDelayedTaskList = pxTemp;															\
+		xNumOfOverflows++;																			\
+		prvResetNextTaskUnblockTime();																\
+	}
+
+	#define taskINSERT_IN_DELAYED_LIST( pxListItem )			vListInsert( pxDelayedTaskList, ( pxListItem ) )
+	#define taskINSERT_IN_OVERFLOW_DELAYED_LIST( pxListItem )	vListInsert( pxOverflowDelayedTaskList, ( pxListItem ) )
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
 
 /*-----------------------------------------------------------*/
 
@@ -331,7 +394,7 @@ typedef struct tskTaskControlBlock
 	#endif
 
 	#if( configGENERATE_RUN_TIME_STATS == 1 )
-		uint32_t		ulRunTimeCounter;	/*< Stores the amount of time the task has spent in the Running state. */
+		configRUN_TIME_COUNTER_TYPE	ulRunTimeCounter;	/*< Stores the amount of time the task has spent in the Running state. */
 	#endif
 
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
@@ -360,6 +423,11 @@ typedef struct tskTaskControlBlock
 		uint8_t ucDelayAborted;
 	#endif
 
+	#if ( configNUM_CORES > 1 )
+		volatile BaseType_t	xTaskRunState;		/*< The core the task is running on, or taskTASK_NOT_RUNNING. */
+		UBaseType_t			uxCoreAffinityMask;	/*< Bit n is set if the task may run on core n. */
+	#endif
+
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -369,14 +437,31 @@ typedef tskTCB TCB_t;
 /*lint -e956 A manual analysis and inspection has been used to determine which
 static variables must be declared volatile. */
 
-PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+#if ( configNUM_CORES > 1 )
+
+	/* Each core runs a task of its own.  pxCurrentTCB, and the other per core
+	variables below, refer to the calling core's copy. */
+	PRIVILEGED_DATA TCB_t * volatile pxCurrentTCBs[ configNUM_CORES ] = { NULL };
+	#define pxCurrentTCB	pxCurrentTCBs[ portGET_CORE_ID() ]
+
+#else
+
+	PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+
+#endif
 
 /* Lists for ready and blocked tasks. --------------------*/
 PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ];/*< Prioritised ready tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList1;						/*< Delayed tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList2;						/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
-PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;				/*< Points to the delayed task list currently being used. */
-PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+	PRIVILEGED_DATA static TimingWheel_t xDelayedTaskWheel;				/*< Delayed tasks, by the tick at which they unblock (see list.h). */
+	PRIVILEGED_DATA static List_t xOverflowDelayedTaskList;				/*< Delayed tasks whose unblock time has overflowed the current tick count. */
+	PRIVILEGED_DATA static List_t * const pxOverflowDelayedTaskList = &xOverflowDelayedTaskList;
+#else
+	PRIVILEGED_DATA static List_t xDelayedTaskList1;					/*< Delayed tasks. */
+	PRIVILEGED_DATA static List_t xDelayedTaskList2;					/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
+	PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;			/*< Points to the delayed task list currently being used. */
+	PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;	/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+#endif /* configUSE_DELAYED_TASK_WHEEL */
 PRIVILEGED_DATA static List_t xPendingReadyList;						/*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
 #if( INCLUDE_vTaskDelete == 1 )
@@ -398,11 +483,24 @@ PRIVILEGED_DATA static volatile TickType_t xTickCount 				= ( TickType_t ) 0U;
 PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority 		= tskIDLE_PRIORITY;
 PRIVILEGED_DATA static volatile BaseType_t xSchedulerRunning 		= pdFALSE;
 PRIVILEGED_DATA static volatile UBaseType_t uxPendedTicks 			= ( UBaseType_t ) 0U;
+#if ( configNUM_CORES == 1 )
 PRIVILEGED_DATA static volatile BaseType_t xYieldPending 			= pdFALSE;
+#endif
 PRIVILEGED_DATA static volatile BaseType_t xNumOfOverflows 			= ( BaseType_t ) 0;
 PRIVILEGED_DATA static UBaseType_t uxTaskNumber 					= ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime		= ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
+#if ( configNUM_CORES == 1 )
 PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle					= NULL;			/*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
+#endif
+
+#if ( configNUM_CORES > 1 )
+
+	PRIVILEGED_DATA static volatile BaseType_t xYieldPendings[ configNUM_CORES ] = { pdFALSE };
+	PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandles[ configNUM_CORES ] = { NULL };	/*< Every core has an idle task of its own. */
+	#define xYieldPending		xYieldPendings[ portGET_CORE_ID() ]
+	#define xIdleTaskHandle		xIdleTaskHandles[ portGET_CORE_ID() ]
+
+#endif
 
 /* Context switches are held pending while the scheduler is suspended.  Also,
 interrupts must not manipulate the xStateListItem of a TCB, or any of the
@@ -416,8 +514,13 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
 
-	PRIVILEGED_DATA static uint32_t ulTaskSwitchedInTime = 0UL;	/*< Holds the value of a timer/counter the last time a task was switched in. */
-	PRIVILEGED_DATA static uint32_t ulTotalRunTime = 0UL;		/*< Holds the total amount of execution time as defined by the run time counter clock. */
+	#if ( configNUM_CORES > 1 )
+		PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTimes[ configNUM_CORES ] = { 0UL };	/*< The switch in time of each core's running task. */
+		#define ulTaskSwitchedInTime	ulTaskSwitchedInTimes[ portGET_CORE_ID() ]
+	#else
+		PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime = 0UL;	/*< Holds the value of a timer/counter the last time a task was switched in. */
+	#endif
+	PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTotalRunTime = 0UL;		/*< Holds the total amount of execution time as defined by the run time counter clock. */
 
 #endif
 
@@ -523,7 +626,7 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseT
  * This function determines the 'high water mark' of the task stack by
  * determining how much of the stack remains at the original preset value.
  */
-#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
+#if ( ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) ) && ( portUSE_HOST_THREAD_STACKS == 0 ) )
 
 	static uint16_t prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte ) PRIVILEGED_FUNCTION;
 
@@ -546,10 +649,19 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseT
 
 /*
  * Set xNextTaskUnblockTime to the time at which the next Blocked state task
- * will exit the Blocked state.
+ * will exit the Blocked state.  With configUSE_DELAYED_TASK_WHEEL it may
+ * instead be the earlier time at which the tasks of a slot of the timing wheel
+ * are moved down a level.
  */
 static void prvResetNextTaskUnblockTime( void );
 
+/*
+ * Called from xTaskIncrementTick() for a task whose unblock time has been
+ * reached.  Removes the task from the delayed and event lists and places it in
+ * a ready list.  Returns pdTRUE if the task should preempt the running task.
+ */
+static BaseType_t prvUnblockDelayedTask( TCB_t * const pxTCB ) PRIVILEGED_FUNCTION;
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
 
 	/*
@@ -579,6 +691,36 @@ static void prvInitialiseNewTask( 	TaskFunction_t pxTaskCode,
  */
 static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 
+#if ( configNUM_CORES > 1 )
+
+	/*
+	 * Selects the task core xCoreID is to run next: the highest priority ready
+	 * task that is not already running on another core and that is allowed to
+	 * run on this one.
+	 */
+	static void prvSelectHighestPriorityTask( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Asks the core running the lowest priority task that pxTCB, which has
+	 * just been made ready, may preempt to yield.  Returns pdTRUE if that is
+	 * the calling core.
+	 */
+	static BaseType_t prvYieldForTask( const TCB_t *pxTCB, BaseType_t xYieldEqualPriority ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Asks core xCoreID to select a new task.  Returns pdTRUE if xCoreID is the
+	 * calling core, which must then yield itself.
+	 */
+	static BaseType_t prvYieldCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Returns pdTRUE if a ready task of the same priority as the task running
+	 * on core xCoreID is waiting to run there.
+	 */
+	static BaseType_t prvTimeSliceDue( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+#endif /* configNUM_CORES */
+
 /*-----------------------------------------------------------*/
 
 #if( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -686,7 +828,18 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 		/* If the stack grows down then allocate the stack then the TCB so the stack
 		does not grow into the TCB.  Likewise if the stack grows up then allocate
 		the TCB then the stack. */
-		#if( portSTACK_GROWTH > 0 )
+		#if( portUSE_HOST_THREAD_STACKS == 1 )
+		{
+			/* The port runs the task on a stack of the host's, only the TCB
+			is needed. */
+			pxNewTCB = ( TCB_t * ) pvPortMalloc( sizeof( TCB_t ) );
+
+			if( pxNewTCB != NULL )
+			{
+				pxNewTCB->pxStack = NULL;
+			}
+		}
+		#elif( portSTACK_GROWTH > 0 )
 		{
 			/* Allocate space for the TCB.  Where the memory comes from depends on
 			the implementation of the port malloc function and whether or not static
@@ -773,7 +926,9 @@ static void prvInitialiseNewTask( 	TaskFunction_t pxTaskCode,
 									TCB_t *pxNewTCB,
 									const MemoryRegion_t * const xRegions ) /*lint !e971 Unqualified char types are allowed for strings and single characters only. */
 {
-StackType_t *pxTopOfStack;
+#if( portUSE_HOST_THREAD_STACKS == 0 )
+	StackType_t *pxTopOfStack;
+#endif
 UBaseType_t x;
 
 	#if( portUSING_MPU_WRAPPERS == 1 )
@@ -790,6 +945,10 @@ UBaseType_t x;
 		uxPriority &= ~portPRIVILEGE_BIT;
 	#endif /* portUSING_MPU_WRAPPERS == 1 */
 
+	/* There is no stack to prepare when the port runs the task on a stack of
+	the host's. */
+	#if( portUSE_HOST_THREAD_STACKS == 0 )
+
 	/* Avoid dependency on memset() if it is not required. */
 	#if( ( configCHECK_FOR_STACK_OVERFLOW > 1 ) || ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
 	{
@@ -823,6 +982,8 @@ UBaseType_t x;
 	}
 	#endif /* portSTACK_GROWTH */
 
+	#endif /* portUSE_HOST_THREAD_STACKS */
+
 	/* Store the task name in the TCB. */
 	for( x = ( UBaseType_t ) 0; x < ( UBaseType_t ) configMAX_TASK_NAME_LEN; x++ )
 	{
@@ -933,17 +1094,61 @@ UBaseType_t x;
 	}
 	#endif
 
+	#if ( configNUM_CORES > 1 )
+	{
+		pxNewTCB->xTaskRunState = taskTASK_NOT_RUNNING;
+		pxNewTCB->uxCoreAffinityMask = tskNO_AFFINITY;
+	}
+	#endif
+
 	/* Initialize the TCB stack to look as if the task was already running,
 	but had been interrupted by the scheduler.  The return address is set
 	to the start of the task function. Once the stack has been initialised
 	the	top of stack variable is updated. */
-	#if( portUSING_MPU_WRAPPERS == 1 )
+	#if( portUSE_HOST_THREAD_STACKS == 1 )
+	{
+		/* The port creates the stack, only its size is passed on. */
+		pxNewTCB->pxTopOfStack = pxPortInitialiseStack( ulStackDepth, pxTaskCode, pvParameters );
+	}
+	#elif( portUSING_MPU_WRAPPERS == 1 )
 	{
-		pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxTaskCode, pvParameters, xRunPrivileged );
+		#if( portHAS_STACK_OVERFLOW_CHECKING == 1 )
+		{
+			#if( portSTACK_GROWTH < 0 )
+			{
+				pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxNewTCB->pxStack, pxTaskCode, pvParameters, xRunPrivileged );
+			}
+			#else /* portSTACK_GROWTH */
+			{
+				pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxNewTCB->pxEndOfStack, pxTaskCode, pvParameters, xRunPrivileged );
+			}
+			#endif /* portSTACK_GROWTH */
+		}
+		#else /* portHAS_STACK_OVERFLOW_CHECKING */
+		{
+			pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxTaskCode, pvParameters, xRunPrivileged );
+		}
+		#endif /* portHAS_STACK_OVERFLOW_CHECKING */
 	}
 	#else /* portUSING_MPU_WRAPPERS */
 	{
-		pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxTaskCode, pvParameters );
+		#if( portHAS_STACK_OVERFLOW_CHECKING == 1 )
+		{
+			#if( portSTACK_GROWTH < 0 )
+			{
+				pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxNewTCB->pxStack, pxTaskCode, pvParameters );
+			}
+			#else /* portSTACK_GROWTH */
+			{
+				pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxNewTCB->pxEndOfStack, pxTaskCode, pvParameters );
+			}
+			#endif /* portSTACK_GROWTH */
+		}
+		#else /* portHAS_STACK_OVERFLOW_CHECKING */
+		{
+			pxNewTCB->pxTopOfStack = pxPortInitialiseStack( pxTopOfStack, pxTaskCode, pvParameters );
+		}
+		#endif /* portHAS_STACK_OVERFLOW_CHECKING */
 	}
 	#endif /* portUSING_MPU_WRAPPERS */
 
@@ -967,6 +1172,21 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 	taskENTER_CRITICAL();
 	{
 		uxCurrentNumberOfTasks++;
+
+		#if ( configNUM_CORES > 1 )
+		{
+			/* The task each core starts with is selected when the scheduler
+			is started. */
+			if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
+			{
+				prvInitialiseTaskLists();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#else
 		if( pxCurrentTCB == NULL )
 		{
 			/* There are no other tasks, or all the other tasks are in
@@ -1006,6 +1226,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
+		#endif /* configNUM_CORES */
 
 		uxTaskNumber++;
 
@@ -1020,26 +1241,49 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		prvAddTaskToReadyList( pxNewTCB );
 
 		portSETUP_TCB( pxNewTCB );
+
+		#if ( configNUM_CORES > 1 )
+		{
+			/* The tasks running on the other cores can only be looked at
+			while the kernel is locked.  The yield itself is held pending until
+			the critical section is left. */
+			if( xSchedulerRunning != pdFALSE )
+			{
+				if( taskYIELD_REQUIRED_FOR( pxNewTCB, pdFALSE ) != pdFALSE )
+				{
+					taskYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		#endif /* configNUM_CORES */
 	}
 	taskEXIT_CRITICAL();
 
-	if( xSchedulerRunning != pdFALSE )
+	#if ( configNUM_CORES == 1 )
 	{
-		/* If the created task is of a higher priority than the current task
-		then it should run now. */
-		if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+		if( xSchedulerRunning != pdFALSE )
 		{
-			taskYIELD_IF_USING_PREEMPTION();
+			/* If the created task is of a higher priority than the current task
+			then it should run now. */
+			if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+			{
+				taskYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
 	}
-	else
-	{
-		mtCOVERAGE_TEST_MARKER();
-	}
+	#endif /* configNUM_CORES */
 }
 /*-----------------------------------------------------------*/
 
@@ -1081,7 +1325,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			not return. */
 			uxTaskNumber++;
 
-			if( pxTCB == pxCurrentTCB )
+			if( taskTASK_IS_RUNNING( pxTCB ) )
 			{
 				/* A task is deleting itself.  This cannot complete within the
 				task itself, as a context switch to another task is required.
@@ -1090,6 +1334,22 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				the scheduler for the TCB and stack of the deleted task. */
 				vListInsertEnd( &xTasksWaitingTermination, &( pxTCB->xStateListItem ) );
 
+				#if ( configNUM_CORES > 1 )
+				{
+					/* A task running on another core is deleted the same way,
+					its memory is only freed once that core has switched away
+					from it. */
+					if( pxTCB->xTaskRunState != ( BaseType_t ) portGET_CORE_ID() )
+					{
+						( void ) prvYieldCore( pxTCB->xTaskRunState );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configNUM_CORES */
+
 				/* Increment the ucTasksDeleted variable so the idle task knows
 				there is a task that has been deleted and that it should therefore
 				check the xTasksWaitingTermination list. */
@@ -1274,9 +1534,10 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 
 		configASSERT( pxTCB );
 
-		if( pxTCB == pxCurrentTCB )
+		if( taskTASK_IS_RUNNING( pxTCB ) )
 		{
-			/* The task calling this function is querying its own state. */
+			/* The task calling this function is querying its own state, or
+			the task is running on another core. */
 			eReturn = eRunning;
 		}
 		else
@@ -1287,7 +1548,11 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			}
 			taskEXIT_CRITICAL();
 
-			if( ( pxStateList == pxDelayedTaskList ) || ( pxStateList == pxOverflowDelayedTaskList ) )
+			#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+				if( ( listWHEEL_CONTAINS_LIST( &xDelayedTaskWheel, pxStateList ) != pdFALSE ) || ( pxStateList == pxOverflowDelayedTaskList ) )
+			#else
+				if( ( pxStateList == pxDelayedTaskList ) || ( pxStateList == pxOverflowDelayedTaskList ) )
+			#endif
 			{
 				/* The task being queried is referenced from one of the Blocked
 				lists. */
@@ -1439,6 +1704,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			{
 				/* The priority change may have readied a task of higher
 				priority than the calling task. */
+				#if ( configNUM_CORES == 1 )
 				if( uxNewPriority > uxCurrentBasePriority )
 				{
 					if( pxTCB != pxCurrentTCB )
@@ -1475,6 +1741,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					require a yield as the running task must be above the
 					new priority of the task being modified. */
 				}
+				#endif /* configNUM_CORES */
 
 				/* Remember the ready list the task might be referenced from
 				before its uxPriority member is changed so the
@@ -1541,6 +1808,33 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					mtCOVERAGE_TEST_MARKER();
 				}
 
+				#if ( configNUM_CORES > 1 )
+				{
+					if( taskTASK_IS_RUNNING( pxTCB ) )
+					{
+						/* Lowering the priority of a running task may let a
+						ready task take its core. */
+						if( uxNewPriority < uxCurrentBasePriority )
+						{
+							xYieldRequired = prvYieldCore( pxTCB->xTaskRunState );
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+					{
+						/* A ready task may now preempt one of the cores. */
+						xYieldRequired = taskYIELD_REQUIRED_FOR( pxTCB, pdTRUE );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				#endif /* configNUM_CORES */
+
 				if( xYieldRequired != pdFALSE )
 				{
 					taskYIELD_IF_USING_PREEMPTION();
@@ -1597,6 +1891,21 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			}
 
 			vListInsertEnd( &xSuspendedTaskList, &( pxTCB->xStateListItem ) );
+
+			#if ( configNUM_CORES > 1 )
+			{
+				/* A task running on another core keeps running until that
+				core has switched away from it. */
+				if( ( taskTASK_IS_RUNNING( pxTCB ) ) && ( pxTCB->xTaskRunState != ( BaseType_t ) portGET_CORE_ID() ) )
+				{
+					( void ) prvYieldCore( pxTCB->xTaskRunState );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configNUM_CORES */
 		}
 		taskEXIT_CRITICAL();
 
@@ -1722,7 +2031,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					prvAddTaskToReadyList( pxTCB );
 
 					/* We may have just resumed a higher priority task. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					if( taskYIELD_REQUIRED_FOR( pxTCB, pdTRUE ) != pdFALSE )
 					{
 						/* This yield may not cause the task just resumed to run,
 						but will leave the lists in the correct state for the
@@ -1790,7 +2099,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				{
 					/* Ready lists can be accessed so move the task from the
 					suspended list to the ready list directly. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					if( taskYIELD_REQUIRED_FOR( pxTCB, pdTRUE ) != pdFALSE )
 					{
 						xYieldRequired = pdTRUE;
 					}
@@ -1854,6 +2163,41 @@ BaseType_t xReturn;
 			xReturn = pdFAIL;
 		}
 	}
+	#elif ( configNUM_CORES > 1 )
+	{
+	BaseType_t xCoreID;
+	char cIdleName[ 7 ] = "IDLE";
+
+		/* Every core has an idle task of its own that only runs on that
+		core, so a core always has a task to run.  The tasks are named IDLE,
+		IDLE1, IDLE2... */
+		xReturn = pdPASS;
+		for( xCoreID = 0; ( xCoreID < ( BaseType_t ) configNUM_CORES ) && ( xReturn == pdPASS ); xCoreID++ )
+		{
+			if( xCoreID >= 10 )
+			{
+				cIdleName[ 4 ] = ( char ) ( '0' + ( xCoreID / 10 ) );
+				cIdleName[ 5 ] = ( char ) ( '0' + ( xCoreID % 10 ) );
+				cIdleName[ 6 ] = '\0';
+			}
+			else if( xCoreID > 0 )
+			{
+				cIdleName[ 4 ] = ( char ) ( '0' + xCoreID );
+				cIdleName[ 5 ] = '\0';
+			}
+
+			xReturn = xTaskCreate(	prvIdleTask,
+									cIdleName, configMINIMAL_STACK_SIZE,
+									( void * ) NULL,
+									( tskIDLE_PRIORITY | portPRIVILEGE_BIT ),
+									&xIdleTaskHandles[ xCoreID ] ); /*lint !e961 MISRA exception, justified as it is not a redundant explicit cast to all supported compilers. */
+
+			if( xReturn == pdPASS )
+			{
+				( ( TCB_t * ) xIdleTaskHandles[ xCoreID ] )->uxCoreAffinityMask = ( UBaseType_t ) 1 << xCoreID;
+			}
+		}
+	}
 	#else
 	{
 		/* The Idle task is being created using dynamically allocated RAM. */
@@ -1899,6 +2243,19 @@ BaseType_t xReturn;
 		xSchedulerRunning = pdTRUE;
 		xTickCount = ( TickType_t ) 0U;
 
+		#if ( configNUM_CORES > 1 )
+		{
+		BaseType_t xCoreID;
+
+			/* Select the task each core starts with.  The port starts every
+			core on the task in pxCurrentTCBs[]. */
+			for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUM_CORES; xCoreID++ )
+			{
+				prvSelectHighestPriorityTask( xCoreID );
+			}
+		}
+		#endif /* configNUM_CORES */
+
 		/* If configGENERATE_RUN_TIME_STATS is defined then the following
 		macro must be defined to configure the timer/counter used to generate
 		the run time counter time base. */
@@ -1943,11 +2300,26 @@ void vTaskEndScheduler( void )
 
 void vTaskSuspendAll( void )
 {
-	/* A critical section is not required as the variable is of type
-	BaseType_t.  Please read Richard Barry's reply in the following link to a
-	post in the FreeRTOS support forum before reporting this as a bug! -
-	http://goo.gl/wu4acr */
-	++uxSchedulerSuspended;
+	#if ( configNUM_CORES > 1 )
+	{
+		/* The other cores are kept out of the kernel for as long as the
+		scheduler is suspended.  The lock is taken within a critical section
+		so the calling task cannot be switched out between taking it and
+		incrementing uxSchedulerSuspended. */
+		taskENTER_CRITICAL();
+		portGET_TASK_LOCK();
+		++uxSchedulerSuspended;
+		taskEXIT_CRITICAL();
+	}
+	#else
+	{
+		/* A critical section is not required as the variable is of type
+		BaseType_t.  Please read Richard Barry's reply in the following link to a
+		post in the FreeRTOS support forum before reporting this as a bug! -
+		http://goo.gl/wu4acr */
+		++uxSchedulerSuspended;
+	}
+	#endif /* configNUM_CORES */
 }
 /*----------------------------------------------------------*/
 
@@ -1971,14 +2343,17 @@ void vTaskSuspendAll( void )
 		}
 		#else
 		{
-			const UBaseType_t uxLeastSignificantBit = ( UBaseType_t ) 0x01;
+		UBaseType_t uxTopPriority;
 
 			/* When port optimised task selection is used the uxTopReadyPriority
-			variable is used as a bit map.  If bits other than the least
-			significant bit are set then there are tasks that have a priority
-			above the idle priority that are in the Ready state.  This takes
-			care of the case where the co-operative scheduler is in use. */
-			if( uxTopReadyPriority > uxLeastSignificantBit )
+			variable is used as a bit map, which the port may spread over more
+			than one level, so the port is asked for the highest priority that
+			has a task in the Ready state.  The idle task is running, so there
+			is always one.  This takes care of the case where the co-operative
+			scheduler is in use. */
+			portGET_HIGHEST_PRIORITY( uxTopPriority, uxTopReadyPriority );
+
+			if( uxTopPriority > tskIDLE_PRIORITY )
 			{
 				uxHigherPriorityReadyTasks = pdTRUE;
 			}
@@ -2032,6 +2407,14 @@ BaseType_t xAlreadyYielded = pdFALSE;
 	{
 		--uxSchedulerSuspended;
 
+		#if ( configNUM_CORES > 1 )
+		{
+			/* The critical section keeps the kernel locked until the pending
+			ready list has been processed. */
+			portRELEASE_TASK_LOCK();
+		}
+		#endif /* configNUM_CORES */
+
 		if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
 		{
 			if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
@@ -2047,7 +2430,7 @@ BaseType_t xAlreadyYielded = pdFALSE;
 
 					/* If the moved task has a priority higher than the current
 					task then a yield must be performed. */
-					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+					if( taskYIELD_REQUIRED_FOR( pxTCB, pdTRUE ) != pdFALSE )
 					{
 						xYieldPending = pdTRUE;
 					}
@@ -2278,10 +2661,23 @@ TCB_t *pxTCB;
 			} while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
 			/* Search the delayed lists. */
-			if( pxTCB == NULL )
+			#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+			{
+			UBaseType_t uxSlot;
+
+				for( uxSlot = 0U; ( uxSlot < ( listWHEEL_LEVELS * listWHEEL_SLOTS ) ) && ( pxTCB == NULL ); uxSlot++ )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( &( xDelayedTaskWheel.xSlots[ uxSlot / listWHEEL_SLOTS ][ uxSlot % listWHEEL_SLOTS ] ), pcNameToQuery );
+				}
+			}
+			#else
 			{
-				pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+				if( pxTCB == NULL )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+				}
 			}
+			#endif /* configUSE_DELAYED_TASK_WHEEL */
 
 			if( pxTCB == NULL )
 			{
@@ -2318,7 +2714,7 @@ TCB_t *pxTCB;
 
 #if ( configUSE_TRACE_FACILITY == 1 )
 
-	UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, uint32_t * const pulTotalRunTime )
+	UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime )
 	{
 	UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES;
 
@@ -2338,7 +2734,20 @@ TCB_t *pxTCB;
 
 				/* Fill in an TaskStatus_t structure with information on each
 				task in the Blocked state. */
-				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
+				#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+				{
+				UBaseType_t uxSlot;
+
+					for( uxSlot = 0U; uxSlot < ( listWHEEL_LEVELS * listWHEEL_SLOTS ); uxSlot++ )
+					{
+						uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xDelayedTaskWheel.xSlots[ uxSlot / listWHEEL_SLOTS ][ uxSlot % listWHEEL_SLOTS ] ), eBlocked );
+					}
+				}
+				#else
+				{
+					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
+				}
+				#endif /* configUSE_DELAYED_TASK_WHEEL */
 				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
 
 				#if( INCLUDE_vTaskDelete == 1 )
@@ -2470,7 +2879,7 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 					/* Preemption is on, but a context switch should only be
 					performed if the unblocked task has a priority that is
 					equal to or higher than the currently executing task. */
-					if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+					if( taskYIELD_REQUIRED_FOR( pxTCB, pdFALSE ) != pdFALSE )
 					{
 						/* Pend the yield to be performed when the scheduler
 						is unsuspended. */
@@ -2525,75 +2934,109 @@ BaseType_t xSwitchRequired = pdFALSE;
 			mtCOVERAGE_TEST_MARKER();
 		}
 
-		/* See if this tick has made a timeout expire.  Tasks are stored in
-		the	queue in the order of their wake time - meaning once one task
-		has been found whose block time has not expired there is no need to
-		look any further down the list. */
-		if( xConstTickCount >= xNextTaskUnblockTime )
+		#if( configUSE_DELAYED_TASK_WHEEL == 1 )
 		{
-			for( ;; )
+		List_t *pxSlot;
+
+			/* See if this tick has made a timeout expire, or has reached a
+			slot of the timing wheel whose tasks are to be moved down a level.
+			The first slot is always the one that is due next. */
+			if( xConstTickCount >= xNextTaskUnblockTime )
 			{
-				if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
-				{
-					/* The delayed list is empty.  Set xNextTaskUnblockTime
-					to the maximum possible value so it is extremely
-					unlikely that the
-					if( xTickCount >= xNextTaskUnblockTime ) test will pass
-					next time through. */
-					xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-					break;
-				}
-				else
+				for( ;; )
 				{
-					/* The delayed list is not empty, get the value of the
-					item at the head of the delayed list.  This is the time
-					at which the task at the head of the delayed list must
-					be removed from the Blocked state. */
-					pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList );
-					xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
-
-					if( xConstTickCount < xItemValue )
+					pxSlot = pxWheelGetNextSlot( &xDelayedTaskWheel, &xItemValue );
+
+					if( pxSlot == NULL )
+					{
+						/* The wheel is empty. */
+						xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+						break;
+					}
+					else if( xConstTickCount < xItemValue )
 					{
-						/* It is not time to unblock this item yet, but the
-						item value is the time at which the task at the head
-						of the blocked list must be removed from the Blocked
-						state -	so record the item value in
-						xNextTaskUnblockTime. */
+						/* The first slot is not due yet. */
 						xNextTaskUnblockTime = xItemValue;
 						break;
 					}
 					else
 					{
-						mtCOVERAGE_TEST_MARKER();
-					}
+						/* Every task in a level 0 slot unblocks on the same
+						tick.  The tasks of a slot above level 0 are moved
+						down, and the loop looks at the wheel again. */
+						pxSlot = pxWheelAdvance( &xDelayedTaskWheel, pxSlot, xItemValue );
 
-					/* It is time to remove the item from the Blocked state. */
-					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-
-					/* Is the task waiting on an event also?  If so remove
-					it from the event list. */
-					if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+						if( pxSlot != NULL )
+						{
+							while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+							{
+								pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot );
+
+								if( prvUnblockDelayedTask( pxTCB ) != pdFALSE )
+								{
+									xSwitchRequired = pdTRUE;
+								}
+								else
+								{
+									mtCOVERAGE_TEST_MARKER();
+								}
+							}
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+				}
+			}
+		}
+		#else /* configUSE_DELAYED_TASK_WHEEL */
+		{
+			/* See if this tick has made a timeout expire.  Tasks are stored in
+			the	queue in the order of their wake time - meaning once one task
+			has been found whose block time has not expired there is no need
+			to look any further down the list. */
+			if( xConstTickCount >= xNextTaskUnblockTime )
+			{
+				for( ;; )
+				{
+					if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
 					{
-						( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+						/* The delayed list is empty.  Set xNextTaskUnblockTime
+						to the maximum possible value so it is extremely
+						unlikely that the
+						if( xTickCount >= xNextTaskUnblockTime ) test will pass
+						next time through. */
+						xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+						break;
 					}
 					else
 					{
-						mtCOVERAGE_TEST_MARKER();
-					}
-
-					/* Place the unblocked task into the appropriate ready
-					list. */
-					prvAddTaskToReadyList( pxTCB );
+						/* The delayed list is not empty, get the value of the
+						item at the head of the delayed list.  This is the time
+						at which the task at the head of the delayed list must
+						be removed from the Blocked state. */
+						pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList );
+						xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+
+						if( xConstTickCount < xItemValue )
+						{
+							/* It is not time to unblock this item yet, but the
+							item value is the time at which the task at the head
+							of the blocked list must be removed from the Blocked
+							state -	so record the item value in
+							xNextTaskUnblockTime. */
+							xNextTaskUnblockTime = xItemValue;
+							break;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
 
-					/* A task being unblocked cannot cause an immediate
-					context switch if preemption is turned off. */
-					#if (  configUSE_PREEMPTION == 1 )
-					{
-						/* Preemption is on, but a context switch should
-						only be performed if the unblocked task has a
-						priority that is equal to or higher than the
-						currently executing task. */
-						if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+						/* It is time to remove the item from the Blocked
+						state. */
+						if( prvUnblockDelayedTask( pxTCB ) != pdFALSE )
 						{
 							xSwitchRequired = pdTRUE;
 						}
@@ -2602,24 +3045,53 @@ BaseType_t xSwitchRequired = pdFALSE;
 							mtCOVERAGE_TEST_MARKER();
 						}
 					}
-					#endif /* configUSE_PREEMPTION */
 				}
 			}
 		}
+		#endif /* configUSE_DELAYED_TASK_WHEEL */
 
 		/* Tasks of equal priority to the currently running task will share
 		processing time (time slice) if preemption is on, and the application
 		writer has not explicitly turned time slicing off. */
 		#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
 		{
-			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+			#if ( configNUM_CORES > 1 )
 			{
-				xSwitchRequired = pdTRUE;
+			BaseType_t xCoreID;
+
+				/* The ready lists also hold the tasks running on the other
+				cores, so every core is checked on its own. */
+				for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUM_CORES; xCoreID++ )
+				{
+					if( prvTimeSliceDue( xCoreID ) != pdFALSE )
+					{
+						if( prvYieldCore( xCoreID ) != pdFALSE )
+						{
+							xSwitchRequired = pdTRUE;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
 			}
-			else
+			#else
 			{
-				mtCOVERAGE_TEST_MARKER();
+				if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
+				{
+					xSwitchRequired = pdTRUE;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
+			#endif /* configNUM_CORES */
 		}
 		#endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
 
@@ -2653,14 +3125,42 @@ BaseType_t xSwitchRequired = pdFALSE;
 
 	#if ( configUSE_PREEMPTION == 1 )
 	{
-		if( xYieldPending != pdFALSE )
+		#if ( configNUM_CORES > 1 )
 		{
-			xSwitchRequired = pdTRUE;
+		BaseType_t xCoreID;
+
+			/* Ask again any core whose yield is still pending. */
+			for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUM_CORES; xCoreID++ )
+			{
+				if( xYieldPendings[ xCoreID ] != pdFALSE )
+				{
+					if( prvYieldCore( xCoreID ) != pdFALSE )
+					{
+						xSwitchRequired = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
 		}
-		else
+		#else
 		{
-			mtCOVERAGE_TEST_MARKER();
+			if( xYieldPending != pdFALSE )
+			{
+				xSwitchRequired = pdTRUE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
+		#endif /* configNUM_CORES */
 	}
 	#endif /* configUSE_PREEMPTION */
 
@@ -2779,21 +3279,32 @@ void vTaskSwitchContext( void )
 					ulTotalRunTime = portGET_RUN_TIME_COUNTER_VALUE();
 				#endif
 
-				/* Add the amount of time the task has been running to the
-				accumulated time so far.  The time the task started running was
-				stored in ulTaskSwitchedInTime.  Note that there is no overflow
-				protection here so count values are only valid until the timer
-				overflows.  The guard against negative values is to protect
-				against suspect run time stat counter implementations - which
-				are provided by the application, not the kernel. */
-				if( ulTotalRunTime > ulTaskSwitchedInTime )
+				#ifdef portGET_TASK_RUN_TIME_COUNTER_VALUE
 				{
-					pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
+					/* The port keeps track of the time each task actually
+					spent executing, e.g. from a per thread CPU clock, rather
+					than the time between it being switched in and out. */
+					pxCurrentTCB->ulRunTimeCounter = portGET_TASK_RUN_TIME_COUNTER_VALUE( pxCurrentTCB );
 				}
-				else
+				#else
 				{
-					mtCOVERAGE_TEST_MARKER();
+					/* Add the amount of time the task has been running to the
+					accumulated time so far.  The time the task started running was
+					stored in ulTaskSwitchedInTime.  Note that there is no overflow
+					protection here so count values are only valid until the timer
+					overflows.  The guard against negative values is to protect
+					against suspect run time stat counter implementations - which
+					are provided by the application, not the kernel. */
+					if( ulTotalRunTime > ulTaskSwitchedInTime )
+					{
+						pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 				}
+				#endif /* portGET_TASK_RUN_TIME_COUNTER_VALUE */
 				ulTaskSwitchedInTime = ulTotalRunTime;
 		}
 		#endif /* configGENERATE_RUN_TIME_STATS */
@@ -2803,7 +3314,15 @@ void vTaskSwitchContext( void )
 
 		/* Select a new task to run using either the generic C or port
 		optimised asm code. */
-		taskSELECT_HIGHEST_PRIORITY_TASK();
+		#if ( configNUM_CORES > 1 )
+		{
+			prvSelectHighestPriorityTask( ( BaseType_t ) portGET_CORE_ID() );
+		}
+		#else
+		{
+			taskSELECT_HIGHEST_PRIORITY_TASK();
+		}
+		#endif /* configNUM_CORES */
 		traceTASK_SWITCHED_IN();
 
 		#if ( configUSE_NEWLIB_REENTRANT == 1 )
@@ -2817,6 +3336,181 @@ void vTaskSwitchContext( void )
 }
 /*-----------------------------------------------------------*/
 
+#if ( configNUM_CORES > 1 )
+
+	static void prvSelectHighestPriorityTask( BaseType_t xCoreID )
+	{
+	TCB_t * const pxPreviousTCB = pxCurrentTCBs[ xCoreID ];
+	TCB_t *pxTCB = NULL;
+	const UBaseType_t uxCoreBit = ( UBaseType_t ) 1 << xCoreID;
+	UBaseType_t uxPriority;
+
+		/* Lower uxTopReadyPriority past any lists that have been emptied. */
+		while( ( listLIST_IS_EMPTY( &( pxReadyTasksLists[ uxTopReadyPriority ] ) ) != pdFALSE ) && ( uxTopReadyPriority > tskIDLE_PRIORITY ) )
+		{
+			--uxTopReadyPriority;
+		}
+
+		/* The ready lists also hold the tasks running on the other cores.
+		Each list is walked from the item after its index, as
+		listGET_OWNER_OF_NEXT_ENTRY() does, so tasks of equal priority take
+		turns, and the first task free to run on this core is taken.  The task
+		this core was running is still a candidate. */
+		for( uxPriority = uxTopReadyPriority; pxTCB == NULL; uxPriority-- )
+		{
+		List_t * const pxList = &( pxReadyTasksLists[ uxPriority ] );
+		ListItem_t *pxItem = pxList->pxIndex;
+		UBaseType_t uxRemaining = listCURRENT_LIST_LENGTH( pxList );
+		TCB_t *pxCandidate;
+
+			while( uxRemaining > ( UBaseType_t ) 0U )
+			{
+				pxItem = pxItem->pxNext;
+
+				if( pxItem != ( ListItem_t * ) &( pxList->xListEnd ) )
+				{
+					uxRemaining--;
+					pxCandidate = ( TCB_t * ) listGET_LIST_ITEM_OWNER( pxItem );
+
+					if( ( ( pxCandidate->xTaskRunState == taskTASK_NOT_RUNNING ) || ( pxCandidate == pxPreviousTCB ) ) &&
+						( ( pxCandidate->uxCoreAffinityMask & uxCoreBit ) != 0U ) )
+					{
+						pxList->pxIndex = pxItem;
+						pxTCB = pxCandidate;
+						break;
+					}
+				}
+			}
+
+			if( uxPriority == tskIDLE_PRIORITY )
+			{
+				break;
+			}
+		}
+
+		/* Every core has an idle task that only runs on that core, so there is
+		always a task to select once the scheduler has been started. */
+		configASSERT( pxTCB );
+
+		if( pxTCB != pxPreviousTCB )
+		{
+			if( pxPreviousTCB != NULL )
+			{
+				pxPreviousTCB->xTaskRunState = taskTASK_NOT_RUNNING;
+			}
+
+			pxTCB->xTaskRunState = xCoreID;
+			pxCurrentTCBs[ xCoreID ] = pxTCB;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvYieldCore( BaseType_t xCoreID )
+	{
+	BaseType_t xReturn;
+
+		xYieldPendings[ xCoreID ] = pdTRUE;
+
+		if( xCoreID == ( BaseType_t ) portGET_CORE_ID() )
+		{
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			portYIELD_CORE( xCoreID );
+			xReturn = pdFALSE;
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvYieldForTask( const TCB_t *pxTCB, BaseType_t xYieldEqualPriority )
+	{
+	BaseType_t xReturn = pdFALSE;
+	BaseType_t xCoreID = ( BaseType_t ) portGET_CORE_ID();
+	BaseType_t xLowestCoreID = taskTASK_NOT_RUNNING;
+	UBaseType_t uxLowestPriority = pxTCB->uxPriority;
+	UBaseType_t uxCount;
+	const TCB_t *pxRunningTCB;
+
+		if( xYieldEqualPriority != pdFALSE )
+		{
+			uxLowestPriority++;
+		}
+
+		/* A task that is running already has a core.  Otherwise look for the
+		core running the lowest priority task that pxTCB may preempt, starting
+		with the calling core as that one can switch without being asked.
+		Cores that have been asked to yield already are skipped, they are about
+		to select the highest priority ready task anyway. */
+		if( taskTASK_IS_RUNNING( pxTCB ) == pdFALSE )
+		{
+			for( uxCount = 0U; uxCount < ( UBaseType_t ) configNUM_CORES; uxCount++ )
+			{
+				pxRunningTCB = pxCurrentTCBs[ xCoreID ];
+
+				if( ( pxRunningTCB != NULL ) &&
+					( xYieldPendings[ xCoreID ] == pdFALSE ) &&
+					( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1 << xCoreID ) ) != 0U ) &&
+					( pxRunningTCB->uxPriority < uxLowestPriority ) )
+				{
+					uxLowestPriority = pxRunningTCB->uxPriority;
+					xLowestCoreID = xCoreID;
+				}
+
+				xCoreID = ( xCoreID + 1 ) % ( BaseType_t ) configNUM_CORES;
+			}
+
+			if( xLowestCoreID != taskTASK_NOT_RUNNING )
+			{
+				xReturn = prvYieldCore( xLowestCoreID );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvTimeSliceDue( BaseType_t xCoreID )
+	{
+	BaseType_t xReturn = pdFALSE;
+	const TCB_t * const pxRunningTCB = pxCurrentTCBs[ xCoreID ];
+	const UBaseType_t uxCoreBit = ( UBaseType_t ) 1 << xCoreID;
+	const List_t *pxList;
+	const ListItem_t *pxItem;
+	const TCB_t *pxTCB;
+
+		if( ( pxRunningTCB != NULL ) && ( xYieldPendings[ xCoreID ] == pdFALSE ) )
+		{
+			pxList = &( pxReadyTasksLists[ pxRunningTCB->uxPriority ] );
+
+			for( pxItem = listGET_HEAD_ENTRY( pxList ); pxItem != listGET_END_MARKER( pxList ); pxItem = listGET_NEXT( pxItem ) )
+			{
+				pxTCB = ( const TCB_t * ) listGET_LIST_ITEM_OWNER( pxItem );
+
+				if( ( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING ) && ( ( pxTCB->uxCoreAffinityMask & uxCoreBit ) != 0U ) )
+				{
+					xReturn = pdTRUE;
+					break;
+				}
+			}
+		}
+
+		return xReturn;
+	}
+
+#endif /* configNUM_CORES */
+/*-----------------------------------------------------------*/
+
 void vTaskPlaceOnEventList( List_t * const pxEventList, const TickType_t xTicksToWait )
 {
 	configASSERT( pxEventList );
@@ -2925,7 +3619,7 @@ BaseType_t xReturn;
 		vListInsertEnd( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
 	}
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	if( taskYIELD_REQUIRED_FOR( pxUnblockedTCB, pdFALSE ) != pdFALSE )
 	{
 		/* Return true if the task removed from the event list has a higher
 		priority than the calling task.  This allows the calling task to know if
@@ -2983,7 +3677,7 @@ BaseType_t xReturn;
 	( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
 	prvAddTaskToReadyList( pxUnblockedTCB );
 
-	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
+	if( taskYIELD_REQUIRED_FOR( pxUnblockedTCB, pdFALSE ) != pdFALSE )
 	{
 		/* Return true if the task removed from the event list has
 		a higher priority than the calling task.  This allows
@@ -3161,9 +3855,10 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 
 			A critical region is not required here as we are just reading from
 			the list, and an occasional incorrect value will not matter.  If
-			the ready list at the idle priority contains more than one task
-			then a task other than the idle task is ready to execute. */
-			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) 1 )
+			the ready list at the idle priority contains more tasks than
+			there are idle tasks (one per core) then a task other than an
+			idle task is ready to execute. */
+			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) configNUM_CORES )
 			{
 				taskYIELD();
 			}
@@ -3231,6 +3926,21 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 			}
 		}
 		#endif /* configUSE_TICKLESS_IDLE */
+
+		#if ( configNUM_CORES > 1 )
+		{
+			/* There is nothing for this core to do until a task is readied
+			for it, so let the port wait for the next interrupt rather than
+			spin.  A task deleted while running on another core has to be
+			cleaned up first. */
+			#if ( INCLUDE_vTaskDelete == 1 )
+				if( uxDeletedTasksWaitingCleanUp == ( UBaseType_t ) 0U )
+			#endif
+			{
+				portIDLE_WAIT_FOR_INTERRUPT();
+			}
+		}
+		#endif /* configNUM_CORES */
 	}
 }
 /*-----------------------------------------------------------*/
@@ -3339,8 +4049,17 @@ UBaseType_t uxPriority;
 		vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
 	}
 
-	vListInitialise( &xDelayedTaskList1 );
-	vListInitialise( &xDelayedTaskList2 );
+	#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+	{
+		vWheelInitialise( &xDelayedTaskWheel );
+		vListInitialise( &xOverflowDelayedTaskList );
+	}
+	#else
+	{
+		vListInitialise( &xDelayedTaskList1 );
+		vListInitialise( &xDelayedTaskList2 );
+	}
+	#endif /* configUSE_DELAYED_TASK_WHEEL */
 	vListInitialise( &xPendingReadyList );
 
 	#if ( INCLUDE_vTaskDelete == 1 )
@@ -3355,10 +4074,14 @@ UBaseType_t uxPriority;
 	}
 	#endif /* INCLUDE_vTaskSuspend */
 
-	/* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-	using list2. */
-	pxDelayedTaskList = &xDelayedTaskList1;
-	pxOverflowDelayedTaskList = &xDelayedTaskList2;
+	#if( configUSE_DELAYED_TASK_WHEEL == 0 )
+	{
+		/* Start with pxDelayedTaskList using list1 and the
+		pxOverflowDelayedTaskList using list2. */
+		pxDelayedTaskList = &xDelayedTaskList1;
+		pxOverflowDelayedTaskList = &xDelayedTaskList2;
+	}
+	#endif /* configUSE_DELAYED_TASK_WHEEL */
 }
 /*-----------------------------------------------------------*/
 
@@ -3387,13 +4110,51 @@ static void prvCheckTasksWaitingTermination( void )
 
 				taskENTER_CRITICAL();
 				{
-					pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) );
-					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-					--uxCurrentNumberOfTasks;
-					--uxDeletedTasksWaitingCleanUp;
+					#if ( configNUM_CORES > 1 )
+					{
+						/* The idle task of another core may have emptied the
+						list since it was checked.  A task deleted while
+						running on another core can only be freed once that
+						core has switched away from it. */
+						if( listLIST_IS_EMPTY( &xTasksWaitingTermination ) != pdFALSE )
+						{
+							pxTCB = NULL;
+						}
+						else
+						{
+							pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) );
+						}
+
+						if( ( pxTCB != NULL ) && taskTASK_IS_RUNNING( pxTCB ) )
+						{
+							pxTCB = NULL;
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					#else
+					{
+						pxTCB = ( TCB_t * ) listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) );
+					}
+					#endif /* configNUM_CORES */
+
+					if( pxTCB != NULL )
+					{
+						( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+						--uxCurrentNumberOfTasks;
+						--uxDeletedTasksWaitingCleanUp;
+					}
 				}
 				taskEXIT_CRITICAL();
 
+				if( pxTCB == NULL )
+				{
+					/* Try again on the next pass of the idle task. */
+					break;
+				}
+
 				prvDeleteTCB( pxTCB );
 			}
 			else
@@ -3476,7 +4237,13 @@ static void prvCheckTasksWaitingTermination( void )
 		parameter is provided to allow it to be skipped. */
 		if( xGetFreeStackSpace != pdFALSE )
 		{
-			#if ( portSTACK_GROWTH > 0 )
+			#if ( portUSE_HOST_THREAD_STACKS == 1 )
+			{
+				/* The task runs on a stack created by the port, only the
+				port can measure it. */
+				pxTaskStatus->usStackHighWaterMark = ( uint16_t ) portGET_STACK_HIGH_WATER_MARK( pxTCB );
+			}
+			#elif ( portSTACK_GROWTH > 0 )
 			{
 				pxTaskStatus->usStackHighWaterMark = prvTaskCheckFreeStackSpace( ( uint8_t * ) pxTCB->pxEndOfStack );
 			}
@@ -3528,7 +4295,7 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* configUSE_TRACE_FACILITY */
 /*-----------------------------------------------------------*/
 
-#if ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) )
+#if ( ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) ) && ( portUSE_HOST_THREAD_STACKS == 0 ) )
 
 	static uint16_t prvTaskCheckFreeStackSpace( const uint8_t * pucStackByte )
 	{
@@ -3545,7 +4312,7 @@ static void prvCheckTasksWaitingTermination( void )
 		return ( uint16_t ) ulCount;
 	}
 
-#endif /* ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) ) */
+#endif /* ( ( ( configUSE_TRACE_FACILITY == 1 ) || ( INCLUDE_uxTaskGetStackHighWaterMark == 1 ) ) && ( portUSE_HOST_THREAD_STACKS == 0 ) ) */
 /*-----------------------------------------------------------*/
 
 #if ( INCLUDE_uxTaskGetStackHighWaterMark == 1 )
@@ -3553,23 +4320,34 @@ static void prvCheckTasksWaitingTermination( void )
 	UBaseType_t uxTaskGetStackHighWaterMark( TaskHandle_t xTask )
 	{
 	TCB_t *pxTCB;
-	uint8_t *pucEndOfStack;
 	UBaseType_t uxReturn;
 
 		pxTCB = prvGetTCBFromHandle( xTask );
 
-		#if portSTACK_GROWTH < 0
+		#if ( portUSE_HOST_THREAD_STACKS == 1 )
 		{
-			pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+			/* The task runs on a stack created by the port, only the port can
+			measure it. */
+			uxReturn = ( UBaseType_t ) portGET_STACK_HIGH_WATER_MARK( pxTCB );
 		}
 		#else
 		{
-			pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+		uint8_t *pucEndOfStack;
+
+			#if portSTACK_GROWTH < 0
+			{
+				pucEndOfStack = ( uint8_t * ) pxTCB->pxStack;
+			}
+			#else
+			{
+				pucEndOfStack = ( uint8_t * ) pxTCB->pxEndOfStack;
+			}
+			#endif
+
+			uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
 		}
 		#endif
 
-		uxReturn = ( UBaseType_t ) prvTaskCheckFreeStackSpace( pucEndOfStack );
-
 		return uxReturn;
 	}
 
@@ -3632,6 +4410,68 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
+static BaseType_t prvUnblockDelayedTask( TCB_t * const pxTCB )
+{
+BaseType_t xSwitchRequired = pdFALSE;
+
+	( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+	/* Is the task waiting on an event also?  If so remove it from the event
+	list. */
+	if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+	{
+		( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Place the unblocked task into the appropriate ready list. */
+	prvAddTaskToReadyList( pxTCB );
+
+	/* A task being unblocked cannot cause an immediate context switch if
+	preemption is turned off. */
+	#if (  configUSE_PREEMPTION == 1 )
+	{
+		/* Preemption is on, but a context switch should only be performed if
+		the unblocked task has a priority that is equal to or higher than the
+		currently executing task. */
+		if( taskYIELD_REQUIRED_FOR( pxTCB, pdTRUE ) != pdFALSE )
+		{
+			xSwitchRequired = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_PREEMPTION */
+
+	return xSwitchRequired;
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_DELAYED_TASK_WHEEL == 1 )
+
+static void prvResetNextTaskUnblockTime( void )
+{
+TickType_t xDueTime;
+
+	/* The first slot of the timing wheel is due when its tasks unblock or,
+	above level 0, when they are moved down a level. */
+	if( pxWheelGetNextSlot( &xDelayedTaskWheel, &xDueTime ) == NULL )
+	{
+		xNextTaskUnblockTime = portMAX_DELAY;
+	}
+	else
+	{
+		xNextTaskUnblockTime = xDueTime;
+	}
+}
+
+#else /* configUSE_DELAYED_TASK_WHEEL */
+
 static void prvResetNextTaskUnblockTime( void )
 {
 TCB_t *pxTCB;
@@ -3654,6 +4494,8 @@ TCB_t *pxTCB;
 		xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) );
 	}
 }
+
+#endif /* configUSE_DELAYED_TASK_WHEEL */
 /*-----------------------------------------------------------*/
 
 #if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
@@ -3662,10 +4504,26 @@ TCB_t *pxTCB;
 	{
 	TaskHandle_t xReturn;
 
-		/* A critical section is not required as this is not called from
-		an interrupt and the current TCB will always be the same for any
-		individual execution thread. */
-		xReturn = pxCurrentTCB;
+		#if ( configNUM_CORES > 1 )
+		{
+		UBaseType_t uxSavedInterruptStatus;
+
+			/* The calling task could be moved to another core between reading
+			the core ID and reading that core's current TCB. */
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+			{
+				xReturn = pxCurrentTCB;
+			}
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		}
+		#else
+		{
+			/* A critical section is not required as this is not called from
+			an interrupt and the current TCB will always be the same for any
+			individual execution thread. */
+			xReturn = pxCurrentTCB;
+		}
+		#endif /* configNUM_CORES */
 
 		return xReturn;
 	}
@@ -3673,6 +4531,100 @@ TCB_t *pxTCB;
 #endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+#if ( configNUM_CORES > 1 )
+
+	TaskHandle_t xTaskGetCurrentTaskHandleForCore( BaseType_t xCoreID )
+	{
+	TaskHandle_t xReturn = NULL;
+
+		if( ( xCoreID >= 0 ) && ( xCoreID < ( BaseType_t ) configNUM_CORES ) )
+		{
+			xReturn = pxCurrentTCBs[ xCoreID ];
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vTaskCoreAffinitySet( const TaskHandle_t xTask, UBaseType_t uxCoreAffinityMask )
+	{
+	TCB_t *pxTCB;
+	BaseType_t xYieldRequired = pdFALSE;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			configASSERT( pxTCB );
+
+			pxTCB->uxCoreAffinityMask = uxCoreAffinityMask;
+
+			if( xSchedulerRunning != pdFALSE )
+			{
+				if( taskTASK_IS_RUNNING( pxTCB ) )
+				{
+					/* Move the task off a core it may no longer run on. */
+					if( ( uxCoreAffinityMask & ( ( UBaseType_t ) 1 << pxTCB->xTaskRunState ) ) == 0U )
+					{
+						xYieldRequired = prvYieldCore( pxTCB->xTaskRunState );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+				{
+					/* The task may now be able to preempt a core it could
+					not run on before. */
+					xYieldRequired = taskYIELD_REQUIRED_FOR( pxTCB, pdFALSE );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				if( xYieldRequired != pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+	/*-----------------------------------------------------------*/
+
+	UBaseType_t vTaskCoreAffinityGet( const TaskHandle_t xTask )
+	{
+	const TCB_t *pxTCB;
+	UBaseType_t uxReturn;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			configASSERT( pxTCB );
+
+			uxReturn = pxTCB->uxCoreAffinityMask;
+		}
+		taskEXIT_CRITICAL();
+
+		return uxReturn;
+	}
+
+#endif /* configNUM_CORES */
+/*-----------------------------------------------------------*/
+
 #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
 
 	BaseType_t xTaskGetSchedulerState( void )
@@ -3685,6 +4637,13 @@ TCB_t *pxTCB;
 		}
 		else
 		{
+			/* Only the core that suspended the scheduler can see it suspended,
+			any other core waits in the critical section until it is resumed
+			again. */
+			#if ( configNUM_CORES > 1 )
+				taskENTER_CRITICAL();
+			#endif
+
 			if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
 			{
 				xReturn = taskSCHEDULER_RUNNING;
@@ -3693,6 +4652,10 @@ TCB_t *pxTCB;
 			{
 				xReturn = taskSCHEDULER_SUSPENDED;
 			}
+
+			#if ( configNUM_CORES > 1 )
+				taskEXIT_CRITICAL();
+			#endif
 		}
 
 		return xReturn;
@@ -3744,6 +4707,15 @@ TCB_t *pxTCB;
 					/* Inherit the priority before being moved into the new list. */
 					pxTCB->uxPriority = pxCurrentTCB->uxPriority;
 					prvAddTaskToReadyList( pxTCB );
+
+					#if ( configNUM_CORES > 1 )
+					{
+						/* The mutex holder may now preempt another core.  The
+						calling task is about to block, so a yield of this
+						core happens anyway. */
+						( void ) prvYieldForTask( pxTCB, pdFALSE );
+					}
+					#endif /* configNUM_CORES */
 				}
 				else
 				{
@@ -4038,7 +5010,7 @@ TCB_t *pxTCB;
 	{
 	TaskStatus_t *pxTaskStatusArray;
 	volatile UBaseType_t uxArraySize, x;
-	uint32_t ulTotalTime, ulStatsAsPercentage;
+	configRUN_TIME_COUNTER_TYPE ulTotalTime, ulStatsAsPercentage;
 
 		#if( configUSE_TRACE_FACILITY != 1 )
 		{
@@ -4111,7 +5083,7 @@ TCB_t *pxTCB;
 					{
 						#ifdef portLU_PRINTF_SPECIFIER_REQUIRED
 						{
-							sprintf( pcWriteBuffer, "\t%lu\t\t%lu%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter, ulStatsAsPercentage );
+							sprintf( pcWriteBuffer, "\t%lu\t\t%lu%%\r\n", ( unsigned long ) pxTaskStatusArray[ x ].ulRunTimeCounter, ( unsigned long ) ulStatsAsPercentage );
 						}
 						#else
 						{
@@ -4127,7 +5099,7 @@ TCB_t *pxTCB;
 						consumed less than 1% of the total run time. */
 						#ifdef portLU_PRINTF_SPECIFIER_REQUIRED
 						{
-							sprintf( pcWriteBuffer, "\t%lu\t\t<1%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter );
+							sprintf( pcWriteBuffer, "\t%lu\t\t<1%%\r\n", ( unsigned long ) pxTaskStatusArray[ x ].ulRunTimeCounter );
 						}
 						#else
 						{
@@ -4420,7 +5392,7 @@ TickType_t uxReturn;
 				}
 				#endif
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskYIELD_REQUIRED_FOR( pxTCB, pdFALSE ) != pdFALSE )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -4538,7 +5510,7 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskYIELD_REQUIRED_FOR( pxTCB, pdFALSE ) != pdFALSE )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -4628,7 +5600,7 @@ TickType_t uxReturn;
 					vListInsertEnd( &( xPendingReadyList ), &( pxTCB->xEventListItem ) );
 				}
 
-				if( pxTCB->uxPriority > pxCurrentTCB->uxPriority )
+				if( taskYIELD_REQUIRED_FOR( pxTCB, pdFALSE ) != pdFALSE )
 				{
 					/* The notified task has a priority above the currently
 					executing task so a yield is required. */
@@ -4739,13 +5711,13 @@ const TickType_t xConstTickCount = xTickCount;
 			{
 				/* Wake time has overflowed.  Place this item in the overflow
 				list. */
-				vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+				taskINSERT_IN_OVERFLOW_DELAYED_LIST( &( pxCurrentTCB->xStateListItem ) );
 			}
 			else
 			{
 				/* The wake time has not overflowed, so the current block list
 				is used. */
-				vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+				taskINSERT_IN_DELAYED_LIST( &( pxCurrentTCB->xStateListItem ) );
 
 				/* If the task entering the blocked state was placed at the
 				head of the list of blocked tasks then xNextTaskUnblockTime
@@ -4774,12 +5746,12 @@ const TickType_t xConstTickCount = xTickCount;
 		if( xTimeToWake < xConstTickCount )
 		{
 			/* Wake time has overflowed.  Place this item in the overflow list. */
-			vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+			taskINSERT_IN_OVERFLOW_DELAYED_LIST( &( pxCurrentTCB->xStateListItem ) );
 		}
 		else
 		{
 			/* The wake time has not overflowed, so the current block list is used. */
-			vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+			taskINSERT_IN_DELAYED_LIST( &( pxCurrentTCB->xStateListItem ) );
 
 			/* If the task entering the blocked state was placed at the head of the
 			list of blocked tasks then xNextTaskUnblockTime needs to be updated
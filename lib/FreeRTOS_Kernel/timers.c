@@ -161,13 +161,29 @@ typedef struct tmrTimerQueueMessage
 /*lint -e956 A manual analysis and inspection has been used to determine which
 static variables must be declared volatile. */
 
-/* The list in which active timers are stored.  Timers are referenced in expire
-time order, with the nearest expiry time at the front of the list.  Only the
-timer service task is allowed to access these lists. */
-PRIVILEGED_DATA static List_t xActiveTimerList1;
-PRIVILEGED_DATA static List_t xActiveTimerList2;
-PRIVILEGED_DATA static List_t *pxCurrentTimerList;
-PRIVILEGED_DATA static List_t *pxOverflowTimerList;
+#if( configUSE_TIMER_WHEEL == 1 )
+
+	/* Active timers are stored in a timing wheel (see list.h), so starting,
+	stopping and resetting a timer takes the same time however many timers are
+	active.  The timers in a level 0 slot all expire on the same tick.  As
+	with the sorted lists, timers whose expiry time has overflowed are held in
+	a list of their own until the tick count overflows too.  Only the timer
+	service task is allowed to access the wheel and the list. */
+	PRIVILEGED_DATA static TimingWheel_t xActiveTimerWheel;
+	PRIVILEGED_DATA static List_t xOverflowTimerList;
+	PRIVILEGED_DATA static List_t * const pxOverflowTimerList = &xOverflowTimerList;
+
+#else
+
+	/* The list in which active timers are stored.  Timers are referenced in
+	expire time order, with the nearest expiry time at the front of the list.
+	Only the timer service task is allowed to access these lists. */
+	PRIVILEGED_DATA static List_t xActiveTimerList1;
+	PRIVILEGED_DATA static List_t xActiveTimerList2;
+	PRIVILEGED_DATA static List_t *pxCurrentTimerList;
+	PRIVILEGED_DATA static List_t *pxOverflowTimerList;
+
+#endif /* configUSE_TIMER_WHEEL */
 
 /* A queue that is used to send commands to the timer service task. */
 PRIVILEGED_DATA static QueueHandle_t xTimerQueue = NULL;
@@ -207,17 +223,26 @@ static void prvTimerTask( void *pvParameters ) PRIVILEGED_FUNCTION;
 static void prvProcessReceivedCommands( void ) PRIVILEGED_FUNCTION;
 
 /*
- * Insert the timer into either xActiveTimerList1, or xActiveTimerList2,
- * depending on if the expire time causes a timer counter overflow.
+ * Insert the timer into either the current timer list (or the timing wheel),
+ * or the overflow timer list, depending on if the expire time causes a timer
+ * counter overflow.
  */
 static BaseType_t prvInsertTimerInActiveList( Timer_t * const pxTimer, const TickType_t xNextExpiryTime, const TickType_t xTimeNow, const TickType_t xCommandTime ) PRIVILEGED_FUNCTION;
 
 /*
- * An active timer has reached its expire time.  Reload the timer if it is an
- * auto reload timer, then call its callback.
+ * The first active timer has reached its expire time.  With the timing wheel
+ * this is every timer in the first slot of the wheel, or, if that slot is above
+ * level 0, the time at which its timers are moved down a level.
  */
 static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
 
+/*
+ * An active timer has reached its expire time.  Remove it from the active
+ * timers, reload the timer if it is an auto reload timer, then call its
+ * callback.
+ */
+static void prvExpireTimer( Timer_t * const pxTimer, const TickType_t xNextExpireTime, const TickType_t xTimeNow ) PRIVILEGED_FUNCTION;
+
 /*
  * The tick count has overflowed.  Switch the timer lists after ensuring the
  * current timer list does not still reference some timers.
@@ -497,11 +522,47 @@ Timer_t *pxTimer = ( Timer_t * ) xTimer;
 
 static void prvProcessExpiredTimer( const TickType_t xNextExpireTime, const TickType_t xTimeNow )
 {
+#if( configUSE_TIMER_WHEEL == 1 )
+{
+List_t *pxSlot;
+TickType_t xDueTime;
+
+	/* A check has already been performed to ensure the wheel is not empty,
+	and no command has been processed since. */
+	pxSlot = pxWheelGetNextSlot( &xActiveTimerWheel, &xDueTime );
+	configASSERT( ( pxSlot != NULL ) && ( xDueTime == xNextExpireTime ) );
+	( void ) xDueTime;
+
+	pxSlot = pxWheelAdvance( &xActiveTimerWheel, pxSlot, xNextExpireTime );
+
+	if( pxSlot != NULL )
+	{
+		/* Every timer in a level 0 slot expires on the same tick.  Reloaded
+		timers expire on a later tick, so are not put back in this slot. */
+		while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+		{
+			prvExpireTimer( ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot ), xNextExpireTime, xTimeNow );
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+}
+#else
+{
+	/* A check has already been performed to ensure the list is not empty. */
+	prvExpireTimer( ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList ), xNextExpireTime, xTimeNow );
+}
+#endif /* configUSE_TIMER_WHEEL */
+}
+/*-----------------------------------------------------------*/
+
+static void prvExpireTimer( Timer_t * const pxTimer, const TickType_t xNextExpireTime, const TickType_t xTimeNow )
+{
 BaseType_t xResult;
-Timer_t * const pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxCurrentTimerList );
 
-	/* Remove the timer from the list of active timers.  A check has already
-	been performed to ensure the list is not empty. */
+	/* Remove the timer from the list of active timers. */
 	( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
 	traceTIMER_EXPIRED( pxTimer );
 
@@ -642,16 +703,32 @@ TickType_t xNextExpireTime;
 	this task to unblock when the tick count overflows, at which point the
 	timer lists will be switched and the next expiry time can be
 	re-assessed.  */
-	*pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
-	if( *pxListWasEmpty == pdFALSE )
+	#if( configUSE_TIMER_WHEEL == 1 )
 	{
-		xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+		/* The first slot of the timing wheel is due when its timers expire
+		or, above level 0, when they are moved down a level, so the task also
+		unblocks once for every slot of a higher level that holds timers. */
+		*pxListWasEmpty = ( pxWheelGetNextSlot( &xActiveTimerWheel, &xNextExpireTime ) == NULL ) ? pdTRUE : pdFALSE;
 	}
-	else
+	#else
+	{
+		*pxListWasEmpty = listLIST_IS_EMPTY( pxCurrentTimerList );
+		if( *pxListWasEmpty == pdFALSE )
+		{
+			xNextExpireTime = listGET_ITEM_VALUE_OF_HEAD_ENTRY( pxCurrentTimerList );
+		}
+	}
+	#endif /* configUSE_TIMER_WHEEL */
+
+	if( *pxListWasEmpty != pdFALSE )
 	{
 		/* Ensure the task unblocks when the tick count rolls over. */
 		xNextExpireTime = ( TickType_t ) 0U;
 	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
 
 	return xNextExpireTime;
 }
@@ -699,7 +776,17 @@ BaseType_t xProcessTimerNow = pdFALSE;
 		}
 		else
 		{
-			vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+			#if( configUSE_TIMER_WHEEL == 1 )
+			{
+				/* The order does not matter, the timers are only moved into
+				the wheel when the tick count overflows. */
+				vListInsertEnd( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+			}
+			#else
+			{
+				vListInsert( pxOverflowTimerList, &( pxTimer->xTimerListItem ) );
+			}
+			#endif /* configUSE_TIMER_WHEEL */
 		}
 	}
 	else
@@ -713,7 +800,15 @@ BaseType_t xProcessTimerNow = pdFALSE;
 		}
 		else
 		{
-			vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+			#if( configUSE_TIMER_WHEEL == 1 )
+			{
+				vWheelInsert( &xActiveTimerWheel, &( pxTimer->xTimerListItem ) );
+			}
+			#else
+			{
+				vListInsert( pxCurrentTimerList, &( pxTimer->xTimerListItem ) );
+			}
+			#endif /* configUSE_TIMER_WHEEL */
 		}
 	}
 
@@ -868,6 +963,78 @@ TickType_t xTimeNow;
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TIMER_WHEEL == 1 )
+
+static void prvSwitchTimerLists( void )
+{
+TickType_t xNextExpireTime, xReloadTime;
+List_t *pxSlot;
+Timer_t *pxTimer;
+BaseType_t xResult;
+
+	/* The tick count has overflowed.  Any timers still in the timing wheel
+	must have expired, so the wheel is advanced slot by slot to the end of the
+	tick range and they are processed, as they are with the sorted lists. */
+	while( ( pxSlot = pxWheelGetNextSlot( &xActiveTimerWheel, &xNextExpireTime ) ) != NULL )
+	{
+		pxSlot = pxWheelAdvance( &xActiveTimerWheel, pxSlot, xNextExpireTime );
+
+		if( pxSlot != NULL )
+		{
+			while( listLIST_IS_EMPTY( pxSlot ) == pdFALSE )
+			{
+				pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxSlot );
+				( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+				traceTIMER_EXPIRED( pxTimer );
+
+				pxTimer->pxCallbackFunction( ( TimerHandle_t ) pxTimer );
+
+				if( pxTimer->uxAutoReload == ( UBaseType_t ) pdTRUE )
+				{
+					/* If the reload value does not overflow the timer goes back
+					in the wheel and is processed again within this loop.
+					Otherwise a command is sent to restart it after the switch. */
+					xReloadTime = ( xNextExpireTime + pxTimer->xTimerPeriodInTicks );
+					if( xReloadTime > xNextExpireTime )
+					{
+						listSET_LIST_ITEM_VALUE( &( pxTimer->xTimerListItem ), xReloadTime );
+						listSET_LIST_ITEM_OWNER( &( pxTimer->xTimerListItem ), pxTimer );
+						vWheelInsert( &xActiveTimerWheel, &( pxTimer->xTimerListItem ) );
+					}
+					else
+					{
+						xResult = xTimerGenericCommand( pxTimer, tmrCOMMAND_START_DONT_TRACE, xNextExpireTime, NULL, tmrNO_DELAY );
+						configASSERT( xResult );
+						( void ) xResult;
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	/* The wheel is empty.  Start it again from the new tick range and move
+	the timers whose expiry time had overflowed into it. */
+	listWHEEL_SET_TIME( &xActiveTimerWheel, ( TickType_t ) 0U );
+
+	while( listLIST_IS_EMPTY( pxOverflowTimerList ) == pdFALSE )
+	{
+		pxTimer = ( Timer_t * ) listGET_OWNER_OF_HEAD_ENTRY( pxOverflowTimerList );
+		( void ) uxListRemove( &( pxTimer->xTimerListItem ) );
+		vWheelInsert( &xActiveTimerWheel, &( pxTimer->xTimerListItem ) );
+	}
+}
+/*-----------------------------------------------------------*/
+
+#else /* configUSE_TIMER_WHEEL */
+
 static void prvSwitchTimerLists( void )
 {
 TickType_t xNextExpireTime, xReloadTime;
@@ -927,6 +1094,8 @@ BaseType_t xResult;
 }
 /*-----------------------------------------------------------*/
 
+#endif /* configUSE_TIMER_WHEEL */
+
 static void prvCheckForValidListAndQueue( void )
 {
 	/* Check that the list from which active timers are referenced, and the
@@ -936,10 +1105,19 @@ static void prvCheckForValidListAndQueue( void )
 	{
 		if( xTimerQueue == NULL )
 		{
-			vListInitialise( &xActiveTimerList1 );
-			vListInitialise( &xActiveTimerList2 );
-			pxCurrentTimerList = &xActiveTimerList1;
-			pxOverflowTimerList = &xActiveTimerList2;
+			#if( configUSE_TIMER_WHEEL == 1 )
+			{
+				vWheelInitialise( &xActiveTimerWheel );
+				vListInitialise( &xOverflowTimerList );
+			}
+			#else
+			{
+				vListInitialise( &xActiveTimerList1 );
+				vListInitialise( &xActiveTimerList2 );
+				pxCurrentTimerList = &xActiveTimerList1;
+				pxOverflowTimerList = &xActiveTimerList2;
+			}
+			#endif /* configUSE_TIMER_WHEEL */
 
 			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
 			{
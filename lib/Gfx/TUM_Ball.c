@@ -24,6 +24,11 @@
 #include <math.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
+
+#include "FreeRTOS.h"
+#include "pool.h"
+#include "task.h"
 
 #include "TUM_Ball.h"
 #include "TUM_Draw.h"
@@ -37,11 +42,39 @@ typedef struct walls {
 
 walls_t walls = { 0 };
 
+/*
+ * Balls and walls are taken from pools, created on first use, that hold as
+ * many of them as a game usually has, and from calloc() once a pool is empty
+ */
+#define BALL_POOL_BLOCKS 16
+#define WALL_POOL_BLOCKS 16
+
+static PoolHandle_t ball_pool = NULL;
+static PoolHandle_t wall_pool = NULL;
+
+static void *objectAlloc(PoolHandle_t *pool, size_t size, unsigned int blocks)
+{
+	void *object = NULL;
+
+	vTaskSuspendAll();
+	if (!*pool)
+		*pool = xPoolCreate(size, blocks);
+	xTaskResumeAll();
+
+	if (*pool)
+		object = pvPoolAlloc(*pool);
+	if (!object)
+		return calloc(1, size);
+
+	memset(object, 0, size);
+	return object;
+}
+
 wall_t *createWall(unsigned short x1, unsigned short y1, unsigned short w,
 		   unsigned short h, float dampening, unsigned int colour,
 		   void (*callback)(void *), void *args)
 {
-	wall_t *ret = calloc(1, sizeof(wall_t));
+	wall_t *ret = objectAlloc(&wall_pool, sizeof(wall_t), WALL_POOL_BLOCKS);
 
 	if (!ret) {
 		fprintf(stderr, "Creating wall failed\n");
@@ -99,7 +132,7 @@ ball_t *createBall(unsigned short initial_x, unsigned short initial_y,
 		   unsigned int colour, unsigned short radius, float max_speed,
 		   void (*callback)(void *), void *args)
 {
-	ball_t *ret = calloc(1, sizeof(ball_t));
+	ball_t *ret = objectAlloc(&ball_pool, sizeof(ball_t), BALL_POOL_BLOCKS);
 
 	if (!ret) {
 		fprintf(stderr, "Creating ball failed\n");
@@ -28,6 +28,7 @@
 #include <SDL2/SDL_ttf.h>
 
 #include "FreeRTOS.h"
+#include "pool.h"
 #include "queue.h"
 
 #include "TUM_Draw.h"
@@ -154,6 +155,19 @@ typedef struct draw_job {
 	union data_u *data;
 } draw_job_t;
 
+#define DRAW_JOB_QUEUE_LENGTH 100
+
+/* Draw jobs taken off drawJobQueue at once by vDrawUpdateScreen() */
+#define DRAW_JOB_BATCH 16
+
+/*
+ * Job data and the copies of strings up to DRAW_TEXT_BLOCK bytes come from
+ * pools with a block for each job that can be queued or being drawn, longer
+ * strings and the jobs of tasks that overrun the pools from malloc()
+ */
+#define DRAW_JOB_BLOCKS (DRAW_JOB_QUEUE_LENGTH + DRAW_JOB_BATCH)
+#define DRAW_TEXT_BLOCK 64
+
 const int screen_height = SCREEN_HEIGHT;
 const int screen_width = SCREEN_WIDTH;
 
@@ -161,6 +175,8 @@ SDL_Window *window = NULL;
 SDL_Renderer *renderer = NULL;
 TTF_Font *font = NULL;
 QueueHandle_t drawJobQueue = NULL;
+PoolHandle_t drawJobPool = NULL;
+PoolHandle_t drawTextPool = NULL;
 
 SemaphoreHandle_t DisplayReady = NULL;
 
@@ -319,12 +335,19 @@ void vInitDrawing(char *path)
 
 	SDL_RenderClear(renderer);
 
-	drawJobQueue = xQueueCreate(100, sizeof(draw_job_t));
+	drawJobQueue = xQueueCreate(DRAW_JOB_QUEUE_LENGTH, sizeof(draw_job_t));
 	if (!drawJobQueue) {
 		printf("drawJobQueue init failed\n");
 		exit(-1);
 	}
 
+	drawJobPool = xPoolCreate(sizeof(union data_u), DRAW_JOB_BLOCKS);
+	drawTextPool = xPoolCreate(DRAW_TEXT_BLOCK, DRAW_JOB_BLOCKS);
+	if (!drawJobPool || !drawTextPool) {
+		printf("draw job pools init failed\n");
+		exit(-1);
+	}
+
 	DisplayReady = xSemaphoreCreateMutex();
 
 	if (!DisplayReady) {
@@ -495,6 +518,21 @@ static void vDrawArrow(unsigned short x1, unsigned short y1, unsigned short x2,
 		       SwapBytes((colour << 8) | 0xFF));
 }
 
+static void *pvDrawAlloc(PoolHandle_t pool, size_t size)
+{
+	void *block = pvPoolAlloc(pool);
+
+	return block ? block : malloc(size);
+}
+
+static void vDrawFree(PoolHandle_t pool, void *block)
+{
+	if (xPoolContains(pool, block))
+		vPoolFree(pool, block);
+	else
+		free(block);
+}
+
 static void vHandleDrawJob(draw_job_t *job)
 {
 	if (!job)
@@ -517,7 +555,7 @@ static void vHandleDrawJob(draw_job_t *job)
 	case DRAW_TEXT:
 		vDrawText(job->data->text.str, job->data->text.x,
 			  job->data->text.y, job->data->text.colour);
-		free(job->data->text.str);
+		vDrawFree(drawTextPool, job->data->text.str);
 		break;
 	case DRAW_RECT:
 		vDrawRectangle(job->data->rect.x, job->data->rect.y,
@@ -568,15 +606,18 @@ static void vHandleDrawJob(draw_job_t *job)
 	default:
 		break;
 	}
-	free(job->data);
+	vDrawFree(drawJobPool, job->data);
 }
 
 void vDrawUpdateScreen(void)
 {
-	draw_job_t tmp_job = { 0 };
+	draw_job_t jobs[DRAW_JOB_BATCH];
+	size_t count;
 
-	while (xQueueReceive(drawJobQueue, &tmp_job, 0) == pdTRUE)
-		vHandleDrawJob(&tmp_job);
+	while ((count = xQueueReceiveMultiple(drawJobQueue, jobs,
+					      DRAW_JOB_BATCH, 0)))
+		for (size_t i = 0; i < count; i++)
+			vHandleDrawJob(&jobs[i]);
 
 	SDL_RenderPresent(renderer);
 
@@ -584,9 +625,10 @@ void vDrawUpdateScreen(void)
 }
 
 #define CREATE_JOB(TYPE)                                                       \
-	union data_u *data = calloc(1, sizeof(union data_u));                  \
+	union data_u *data = pvDrawAlloc(drawJobPool, sizeof(union data_u));   \
 	if (!data)                                                             \
 		logCriticalError("#TYPE data alloc");                          \
+	memset(data, 0, sizeof(union data_u));                                 \
 	job.data = data;
 
 static void logCriticalError(char *msg)
@@ -599,10 +641,14 @@ signed char tumDrawText(char *str, signed short x, signed short y,
 			unsigned int colour)
 {
 	draw_job_t job = { .type = DRAW_TEXT };
+	size_t size = sizeof(char) * (strlen(str) + 1);
 
 	CREATE_JOB(text);
 
-	job.data->text.str = malloc(sizeof(char) * (strlen(str) + 1));
+	if (size <= DRAW_TEXT_BLOCK)
+		job.data->text.str = pvDrawAlloc(drawTextPool, size);
+	else
+		job.data->text.str = malloc(size);
 
 	if (!job.data->text.str) {
 		printf("Error allocating buffer in tumDrawText\n");
@@ -27,6 +27,7 @@
 #include "TUM_Sound.h"
 #include "TUM_Utils.h"
 
+#include "channel.h"
 #include "udp.h"
 
 #define mainGENERIC_PRIORITY (tskIDLE_PRIORITY)
@@ -46,6 +47,8 @@
 
 #define STATE_DEBOUNCE_DELAY 100
 
+#define SERIAL_BUFFER_SIZE 200
+
 #ifdef TRACE_FUNCTIONS
 #include "tracer.h"
 #endif
@@ -56,7 +59,7 @@ const unsigned char prev_state_signal = PREV_TASK;
 static TaskHandle_t DemoTask1 = NULL;
 static TaskHandle_t DemoTask2 = NULL;
 static QueueHandle_t StateQueue = NULL;
-static QueueHandle_t SerialQueue = NULL;
+static channel_t *SerialChannel = NULL;
 static SemaphoreHandle_t DrawReady = NULL;
 
 typedef struct buttons_buffer {
@@ -399,12 +402,14 @@ void vDemoTask2(void *pvParameters)
 
 void serialPrint(void *parameters)
 {
-	QueueHandle_t queue = (QueueHandle_t)parameters;
-	char rx;
+	channel_t *channel = (channel_t *)parameters;
+	char rx[SERIAL_BUFFER_SIZE];
+	size_t len;
 
 	while (1) {
-		xQueueReceive(queue, &rx, portMAX_DELAY);
-		printf("Rx: %c\n", rx);
+		len = channelReceive(channel, rx, sizeof(rx), portMAX_DELAY);
+		for (size_t i = 0; i < len; i++)
+			printf("Rx: %c\n", rx[i]);
 	}
 }
 
@@ -416,13 +421,13 @@ int main(int argc, char *argv[])
 	vInitEvents();
 	vInitAudio(bin_folder_path);
 
-	SerialQueue = xQueueCreate(200, sizeof(unsigned char));
+	SerialChannel = channelCreate(SERIAL_BUFFER_SIZE, sizeof(char));
 	udpInit();
-	udpOpenSocket(NULL, 3333, SOCKET_TYPE_UDP, SerialQueue);
+	udpOpenSocket(NULL, 3333, SOCKET_TYPE_UDP, SerialChannel);
 
 	/** test task */
 	xTaskCreate(serialPrint, "serial print", mainGENERIC_STACK_SIZE,
-		    SerialQueue, mainGENERIC_PRIORITY, NULL);
+		    SerialChannel, mainGENERIC_PRIORITY, NULL);
 
 	xTaskCreate(vDemoTask1, "DemoTask1", mainGENERIC_STACK_SIZE, NULL,
 		    mainGENERIC_PRIORITY, &DemoTask1);
@@ -470,11 +475,8 @@ void vMainQueueSendPassed(void)
 
 void vApplicationIdleHook(void)
 {
-#ifdef __GCC_POSIX__
-	struct timespec xTimeToSleep, xTimeSlept;
-	/* Makes the process more agreeable when using the Posix simulator. */
-	xTimeToSleep.tv_sec = 1;
-	xTimeToSleep.tv_nsec = 0;
-	nanosleep(&xTimeToSleep, &xTimeSlept);
-#endif
+	/* The idle task must not block here as it has to clean up after deleted
+	 * tasks. Sleeping the host while idle is done by the port's tickless idle,
+	 * see configUSE_TICKLESS_IDLE.
+	 */
 }